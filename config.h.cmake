@@ -30,6 +30,9 @@
 #cmakedefine HAVE_STRSEP 1
 #cmakedefine HAVE_ISFDTYPE 1
 
+// checks for libraries
+#cmakedefine HAVE_PTHREAD 1
+
 // needed for actual version handling of Version.cc
 #define VERSION_CPU "${CMAKE_SYSTEM_PROCESSOR}"
 #define VERSION_OS "${CMAKE_SYSTEM_NAME}"
@@ -27,12 +27,14 @@
 #include <config.h>
 
 #include <algorithm>
+#include <iterator>
 #include <string.h>
 
 #include "AbstractModel.h"
 #include "Binstream.h"
 #include "ExtendedResidue.h"
 #include "Pdbstream.h"
+#include "ResId.h"
 #include "Residue.h"
 #include "ResidueType.h"
 #include "ResidueFactoryMethod.h"
@@ -78,65 +80,133 @@ namespace mccore
   }
 
 
+  AbstractModel::size_type
+  AbstractModel::lookup (const ResId &id) const
+  {
+    ResIdIndex::size_type pos;
+
+    pos = residIndex.find (id);
+    if (size () > pos
+	&& id == const_iterator (begin () + pos)->getResId ())
+      {
+	return pos;
+      }
+    return ResIdIndex::npos;
+  }
+
+
+  void
+  AbstractModel::lookupRange (char chain, int first, int last, vector< size_type > &positions) const
+  {
+    ResIdIndex index;
+    vector< size_type >::iterator it;
+
+    residIndex.range (chain, first, last, back_inserter (positions));
+    if (residIndex.size () == size ())
+      {
+	for (it = positions.begin (); positions.end () != it; ++it)
+	  {
+	    if (size () <= *it
+		|| chain != (*this)[*it].getResId ().getChainId ()
+		|| first > (*this)[*it].getResId ().getResNo ()
+		|| last < (*this)[*it].getResId ().getResNo ())
+	      {
+		break;
+	      }
+	  }
+	if (positions.end () == it)
+	  {
+	    return;
+	  }
+      }
+
+    // The index is out of date, a temporary one is built.
+    index.rebuild (begin (), end ());
+    positions.clear ();
+    index.range (chain, first, last, back_inserter (positions));
+  }
+
+
+  void
+  AbstractModel::reindex ()
+  {
+    residIndex.rebuild (begin (), end ());
+  }
+
+
   AbstractModel::iterator
   AbstractModel::find (const ResId &id)
   {
-    iterator it;
+    size_type pos = lookup (id);
 
-    for (it = begin (); it != end (); ++it)
-      if (id == it->getResId ())
-	{
-	  return it;
-	}
-    return it;
+    return ResIdIndex::npos == pos ? end () : iterator (begin () + pos);
   }
 
 
   AbstractModel::const_iterator
   AbstractModel::find (const ResId &id) const
   {
-    const_iterator it;
+    size_type pos = lookup (id);
 
-    for (it = begin (); it != end (); ++it)
-      if (id == it->getResId ())
-	{
-	  return it;
-	}
-    return it;
+    return ResIdIndex::npos == pos ? end () : const_iterator (begin () + pos);
   }
   
 
   AbstractModel::iterator
   AbstractModel::safeFind (const ResId &id) throw (NoSuchElementException)
   {
-    iterator it;
-
-    for (it = begin (); it != end (); ++it)
-      if (id == it->getResId ())
-	return it;
-
-    NoSuchElementException ex ("", __FILE__, __LINE__);
-    ex << "residue \"" << id << "\" not found in model";
-    throw ex;
+    size_type pos = lookup (id);
 
-    return it;
+    if (ResIdIndex::npos == pos)
+      {
+	NoSuchElementException ex ("", __FILE__, __LINE__);
+	ex << "residue \"" << id << "\" not found in model";
+	throw ex;
+      }
+    return iterator (begin () + pos);
   }
 
 
   AbstractModel::const_iterator
   AbstractModel::safeFind (const ResId &id) const throw (NoSuchElementException)
   {
-    const_iterator it;
+    size_type pos = lookup (id);
 
-    for (it = begin (); it != end (); ++it)
-      if (id == it->getResId ())
-	return it;
+    if (ResIdIndex::npos == pos)
+      {
+	NoSuchElementException ex ("", __FILE__, __LINE__);
+	ex << "residue \"" << id << "\" not found in model";
+	throw ex;
+      }
+    return const_iterator (begin () + pos);
+  }
 
-    NoSuchElementException ex ("", __FILE__, __LINE__);
-    ex << "residue \"" << id << "\" not found in model";
-    throw ex;
 
-    return it;
+  void
+  AbstractModel::findRange (char chain, int first, int last, vector< iterator > &found)
+  {
+    vector< size_type > positions;
+    vector< size_type >::iterator it;
+
+    lookupRange (chain, first, last, positions);
+    for (it = positions.begin (); positions.end () != it; ++it)
+      {
+	found.push_back (iterator (begin () + *it));
+      }
+  }
+
+
+  void
+  AbstractModel::findRange (char chain, int first, int last, vector< const_iterator > &found) const
+  {
+    vector< size_type > positions;
+    vector< size_type >::iterator it;
+
+    lookupRange (chain, first, last, positions);
+    for (it = positions.begin (); positions.end () != it; ++it)
+      {
+	found.push_back (const_iterator (begin () + *it));
+      }
   }
   
   
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "Exception.h"
+#include "ResIdIndex.h"
 
 using namespace std;
 
@@ -68,6 +69,13 @@ namespace mccore
      */
     ResidueFactoryMethod *residueFM;
 
+    /**
+     * Index from residue ids to positions in the model.  Concrete models
+     * keep it up to date on insert, erase and sort.  Residue ids modified
+     * in place through the model iterators require a call to reindex.
+     */
+    ResIdIndex residIndex;
+
   public:
 
     // ITERATORS --------------------------------------------------------------
@@ -362,6 +370,55 @@ namespace mccore
      * @exception NoSuchElementException
      */
     const_iterator safeFind (const ResId &id) const throw (NoSuchElementException);
+
+    /**
+     * Finds the residues of a chain whose residue number is within
+     * [first, last].  The iterators are appended to found in ResId order.
+     * @param chain the chain id.
+     * @param first the lowest residue number.
+     * @param last the highest residue number.
+     * @param found the vector receiving the iterators.
+     */
+    void findRange (char chain, int first, int last, vector< iterator > &found);
+
+    /**
+     * Finds the residues of a chain whose residue number is within
+     * [first, last].  The iterators are appended to found in ResId order.
+     * @param chain the chain id.
+     * @param first the lowest residue number.
+     * @param last the highest residue number.
+     * @param found the vector receiving the iterators.
+     */
+    void findRange (char chain, int first, int last, vector< const_iterator > &found) const;
+
+    /**
+     * Rebuilds the residue id index.  It must be called after residue ids
+     * were modified in place through the model iterators.
+     */
+    void reindex ();
+
+  private:
+
+    /**
+     * Gets the position of the residue id using the index.  A position
+     * whose residue does not bear the id is not returned.
+     * @param id the residue id.
+     * @return the position or ResIdIndex::npos if not found.
+     */
+    size_type lookup (const ResId &id) const;
+
+    /**
+     * Gets the positions of the residues of a chain whose residue number is
+     * within [first, last] using the index.  A temporary index is built if
+     * the model index is found out of date.
+     * @param chain the chain id.
+     * @param first the lowest residue number.
+     * @param last the highest residue number.
+     * @param positions the vector receiving the positions in ResId order.
+     */
+    void lookupRange (char chain, int first, int last, vector< size_type > &positions) const;
+
+  public:
     
     /**
      * Sorts the model according to the Residue::operator<
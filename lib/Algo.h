@@ -35,6 +35,7 @@
 #include <vector>
 
 #include "Residue.h"
+#include "ResId.h"
 #include "AtomSet.h"
 #include "Exception.h"
 
@@ -125,31 +126,18 @@ namespace mccore
       vector< ResidueRange< iter_type > > Y_range;
       vector< ResidueRange< iter_type > > Z_range;
       iter_type i;
-      AtomSetNot as_nopse (new AtomSetPSE ());
       
       for (i = begin; i != end; ++i) 
 	{
 	  if (filter (i))
 	    {
-	      Residue::const_iterator j;
-	  
-	      float minX, minY, minZ, maxX, maxY, maxZ;
-	      minX = minY = minZ = numeric_limits<float>::max ();
-	      maxX = maxY = maxZ = numeric_limits<float>::min ();
-	  
-	      for (j = i->begin (as_nopse); j != i->end (); ++j)
-		{
-		  minX = min (minX, j->getX ());
-		  minY = min (minY, j->getY ());
-		  minZ = min (minZ, j->getZ ());
-		  maxX = max (maxX, j->getX ());
-		  maxY = max (maxY, j->getY ());
-		  maxZ = max (maxZ, j->getZ ());
-		}
-	
-	      X_range.push_back (ResidueRange< iter_type > (i, minX, maxX));
-	      Y_range.push_back (ResidueRange< iter_type > (i, minY, maxY));
-	      Z_range.push_back (ResidueRange< iter_type > (i, minZ, maxZ));
+	      float lower[3];
+	      float upper[3];
+
+	      getBoundingBox (*i, lower, upper);
+	      X_range.push_back (ResidueRange< iter_type > (i, lower[0], upper[0]));
+	      Y_range.push_back (ResidueRange< iter_type > (i, lower[1], upper[1]));
+	      Z_range.push_back (ResidueRange< iter_type > (i, lower[2], upper[2]));
 	    }
 	}
       
@@ -190,6 +178,73 @@ namespace mccore
 	}
     }
     
+    /**
+     * Calculates the possible contacts between a few residues and the rest
+     * of a collection.  It finds the same pairs as the whole collection
+     * extraction restricted to the pairs involving one of the given
+     * residues, but only the bounding boxes of the given residues are
+     * tested against the others.  The pairs are written in collection
+     * order, the first iterator being less than the second.
+     * @param result a vector of pair of iterators on residues that will
+     * contain the results.
+     * @param some the iterators on the residues whose contacts are searched.
+     * @param begin an iterator on a collection of Residue.
+     * @param end an iterator on a collection of Residue.
+     * @param cutoff on the minimum distance for a contact (default = 5.0 Angstroms).
+     */
+    template< class iter_type >
+    static void
+    extractContacts (vector< pair< iter_type, iter_type > > &result, const vector< iter_type > &some, iter_type begin, iter_type end, const RDATypeFilter< iter_type > &filter, float cutoff = 5.0) 
+    {
+      vector< iter_type > pivots;
+      vector< float > pivotBoxes;
+      typename vector< iter_type >::size_type n;
+      typename vector< pair< iter_type, iter_type > >::size_type first;
+      iter_type i;
+
+      for (n = 0; n < some.size (); ++n)
+	{
+	  if (filter (some[n]))
+	    {
+	      pivots.push_back (some[n]);
+	    }
+	}
+      sort (pivots.begin (), pivots.end ());
+      pivots.erase (unique (pivots.begin (), pivots.end ()), pivots.end ());
+      pivotBoxes.resize (pivots.size () * 6);
+      for (n = 0; n < pivots.size (); ++n)
+	{
+	  getBoundingBox (*pivots[n], &pivotBoxes[n * 6], &pivotBoxes[n * 6 + 3]);
+	}
+
+      first = result.size ();
+      for (i = begin; i != end; ++i) 
+	{
+	  if (filter (i))
+	    {
+	      float lower[3];
+	      float upper[3];
+	      bool pivot;
+
+	      getBoundingBox (*i, lower, upper);
+	      pivot = binary_search (pivots.begin (), pivots.end (), i);
+	      for (n = 0; n < pivots.size (); ++n)
+		{
+		  // A pair of given residues is only tested from its first
+		  // residue.
+		  if ((pivot ? i < pivots[n] : i != pivots[n])
+		      && overlap (lower, upper, &pivotBoxes[n * 6], &pivotBoxes[n * 6 + 3], cutoff))
+		    {
+		      result.push_back (i < pivots[n]
+					? make_pair (i, pivots[n])
+					: make_pair (pivots[n], i));
+		    }
+		}
+	    }
+	}
+      sort (result.begin () + first, result.end ());
+    }
+    
     /**
      * Using the Axis Aligned Bounding Box for collision detection, this
      * method calculates the possible contacts between residues.
@@ -208,8 +263,115 @@ namespace mccore
       extractContacts (result, begin, end, filter, cutoff);
       return result;
     }
+
+    /**
+     * Sorts a vector of residue pointers over their residue ids.  It is a
+     * stable least significant digit radix sort over the packed ResId keys
+     * (see ResId::getKey) that skips the key bytes common to every residue.
+     * @param v the vector of residue pointers to sort.
+     */
+    template< class ResiduePtr >
+    static void radixSortByResId (vector< ResiduePtr > &v)
+    {
+      typedef pair< ResId::key_type, ResiduePtr > KeyPtr;
+      vector< KeyPtr > keys;
+      vector< KeyPtr > tmp;
+      typename vector< ResiduePtr >::size_type i;
+      ResId::key_type varying = 0;
+      unsigned int shift;
+      
+      if (2 > v.size ())
+	{
+	  return;
+	}
+      keys.reserve (v.size ());
+      for (i = 0; i < v.size (); ++i)
+	{
+	  keys.push_back (make_pair (v[i]->getResId ().getKey (), v[i]));
+	  varying |= keys[i].first ^ keys[0].first;
+	}
+      tmp.resize (keys.size ());
+      for (shift = 0; shift < 64; shift += 8)
+	{
+	  typename vector< ResiduePtr >::size_type count[256];
+	  typename vector< ResiduePtr >::size_type sum;
+	  unsigned int digit;
+	  
+	  if (0 == ((varying >> shift) & 0xff))
+	    {
+	      continue;
+	    }
+	  std::fill (count, count + 256, 0);
+	  for (i = 0; i < keys.size (); ++i)
+	    {
+	      ++count[(keys[i].first >> shift) & 0xff];
+	    }
+	  for (sum = 0, digit = 0; digit < 256; ++digit)
+	    {
+	      typename vector< ResiduePtr >::size_type c = count[digit];
+	      
+	      count[digit] = sum;
+	      sum += c;
+	    }
+	  for (i = 0; i < keys.size (); ++i)
+	    {
+	      tmp[count[(keys[i].first >> shift) & 0xff]++] = keys[i];
+	    }
+	  keys.swap (tmp);
+	}
+      for (i = 0; i < v.size (); ++i)
+	{
+	  v[i] = keys[i].second;
+	}
+    }
     
   private:
+
+    /**
+     * Computes the axis aligned bounding box of the residue atoms,
+     * pseudo-atoms excluded.
+     * @param res the residue.
+     * @param lower the lower X, Y and Z bounds.
+     * @param upper the upper X, Y and Z bounds.
+     */
+    static void getBoundingBox (const Residue &res, float *lower, float *upper)
+    {
+      Residue::const_iterator j;
+      AtomSetNot as_nopse (new AtomSetPSE ());
+
+      lower[0] = lower[1] = lower[2] = numeric_limits<float>::max ();
+      upper[0] = upper[1] = upper[2] = numeric_limits<float>::min ();
+      for (j = res.begin (as_nopse); j != res.end (); ++j)
+	{
+	  lower[0] = min (lower[0], j->getX ());
+	  lower[1] = min (lower[1], j->getY ());
+	  lower[2] = min (lower[2], j->getZ ());
+	  upper[0] = max (upper[0], j->getX ());
+	  upper[1] = max (upper[1], j->getY ());
+	  upper[2] = max (upper[2], j->getZ ());
+	}
+    }
+
+    /**
+     * Tells if two bounding boxes are within the cutoff on every axis, the
+     * way ExtractContact_OneDim pairs the sorted ranges.
+     */
+    static bool overlap (const float *lowerA, const float *upperA,
+			 const float *lowerB, const float *upperB, float cutoff)
+    {
+      unsigned int d;
+
+      for (d = 0; d < 3; ++d)
+	{
+	  if (lowerA[d] <= lowerB[d]
+	      ? lowerB[d] - cutoff > upperA[d]
+	      : lowerA[d] - cutoff > upperB[d])
+	    {
+	      return false;
+	    }
+	}
+      return true;
+    }
     
     template< class iter_type >
     class ResidueRange
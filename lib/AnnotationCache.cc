@@ -0,0 +1,198 @@
+//                              -*- Mode: C++ -*-
+// AnnotationCache.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:05:08 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include <cmath>
+
+#include "AnnotationCache.h"
+#include "HomogeneousTransfo.h"
+#include "Residue.h"
+
+
+
+namespace mccore
+{
+
+  bool
+  AnnotationCache::Key::operator< (const Key &right) const
+  {
+    unsigned int i;
+
+    if (refConformer != right.refConformer)
+      {
+	return refConformer < right.refConformer;
+      }
+    if (resConformer != right.resConformer)
+      {
+	return resConformer < right.resConformer;
+      }
+    if (aspb != right.aspb)
+      {
+	return aspb < right.aspb;
+      }
+    for (i = 0; 12 > i; ++i)
+      {
+	if (tfo[i] != right.tfo[i])
+	  {
+	    return tfo[i] < right.tfo[i];
+	  }
+      }
+    return false;
+  }
+
+
+  AnnotationCache::AnnotationCache (size_type cap, float distance, float angle)
+    : capacity (cap),
+      distanceTolerance (distance),
+      angleTolerance (angle),
+      hits (0),
+      misses (0)
+  { }
+
+
+  void
+  AnnotationCache::setCapacity (size_type cap)
+  {
+    capacity = cap;
+    evict ();
+  }
+
+
+  void
+  AnnotationCache::setTolerance (float distance, float angle)
+  {
+    distanceTolerance = distance;
+    angleTolerance = angle;
+    clear ();
+  }
+
+
+  bool
+  AnnotationCache::makeKey (const Residue *ref, const Residue *res, unsigned char aspb, Key &key, bool &inverted) const
+  {
+    HomogeneousTransfo tfo;
+    Key inverse;
+
+    // A residue of less than three atoms has no referential.
+    if (0 == ref->getConformer () || 0 == res->getConformer ()
+	|| 3 > ref->size () || 3 > res->size ())
+      {
+	return false;
+      }
+    tfo = ref->getReferential ().invert () * res->getReferential ();
+    key.refConformer = ref->getConformer ();
+    key.resConformer = res->getConformer ();
+    key.aspb = aspb;
+    quantize (tfo, key);
+    inverse.refConformer = key.resConformer;
+    inverse.resConformer = key.refConformer;
+    inverse.aspb = aspb;
+    quantize (tfo.invert (), inverse);
+    if ((inverted = inverse < key))
+      {
+	key = inverse;
+      }
+    return true;
+  }
+
+
+  void
+  AnnotationCache::quantize (const HomogeneousTransfo &tfo, Key &key) const
+  {
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; 3 > i; ++i)
+      {
+	for (j = 0; 3 > j; ++j)
+	  {
+	    key.tfo[i * 4 + j] = (int) floor (tfo.elementAt (i, j) / angleTolerance + 0.5);
+	  }
+	key.tfo[i * 4 + 3] = (int) floor (tfo.elementAt (i, 3) / distanceTolerance + 0.5);
+      }
+  }
+
+
+  const AnnotationCache::Annotation*
+  AnnotationCache::find (const Key &key)
+  {
+    EntryMap::iterator it;
+
+    if (entries.end () == (it = entries.find (key)))
+      {
+	++misses;
+	return 0;
+      }
+    ++hits;
+    ages.splice (ages.begin (), ages, it->second.age);
+    return &it->second.annotation;
+  }
+
+
+  void
+  AnnotationCache::insert (const Key &key, const Annotation &annotation)
+  {
+    pair< EntryMap::iterator, bool > inserted;
+
+    if (0 == capacity)
+      {
+	return;
+      }
+    inserted = entries.insert (make_pair (key, Entry ()));
+    inserted.first->second.annotation = annotation;
+    if (inserted.second)
+      {
+	ages.push_front (key);
+	inserted.first->second.age = ages.begin ();
+	evict ();
+      }
+    else
+      {
+	ages.splice (ages.begin (), ages, inserted.first->second.age);
+      }
+  }
+
+
+  void
+  AnnotationCache::clear ()
+  {
+    entries.clear ();
+    ages.clear ();
+    hits = 0;
+    misses = 0;
+  }
+
+
+  void
+  AnnotationCache::evict ()
+  {
+    while (entries.size () > capacity)
+      {
+	entries.erase (ages.back ());
+	ages.pop_back ();
+      }
+  }
+
+}
@@ -0,0 +1,282 @@
+//                              -*- Mode: C++ -*-
+// AnnotationCache.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:05:08 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_AnnotationCache_h_
+#define _mccore_AnnotationCache_h_
+
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "PropertyTypeSet.h"
+#include "Relation.h"
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  class HomogeneousTransfo;
+  class PropertyType;
+  class Residue;
+
+
+
+  /**
+   * @short Bounded cache of residue pair annotations.
+   *
+   * The annotation of a pair of rigid residues only depends on their
+   * conformers and on the transformation from the first to the second.
+   * The cache keeps the annotations computed by Relation::annotate keyed
+   * by the conformer ids of the residues (see Residue::setConformer), the
+   * annotation mask and the relative transformation quantized by the
+   * distance and angle tolerances, so that a pair geometry seen before is
+   * not annotated again.  A pair and its inverse share the same key, the
+   * annotation being stored in the orientation of the key.  Residues
+   * without a conformer id or a referential are not cached.
+   * The least recently used annotations are dropped once the capacity is
+   * reached.  The cache is not thread safe, it may be shared by the models
+   * of a single thread.
+   */
+  class AnnotationCache
+  {
+  public:
+
+    typedef unsigned int size_type;
+
+    /**
+     * @short An annotation stored in the cache.
+     *
+     * The H-bonds are kept without their residues, refDonors telling which
+     * residue of the pair holds the donor.
+     */
+    struct Annotation
+    {
+      unsigned char type_aspb;
+      const PropertyType *refFace;
+      const PropertyType *resFace;
+      PropertyTypeSet labels;
+      float sum_flow;
+      vector< HBondFlow > hbonds;
+      vector< bool > refDonors;
+      vector< pair< const PropertyType*, const PropertyType* > > pairedFaces;
+    };
+
+    /**
+     * @short The key of an annotation.
+     */
+    struct Key
+    {
+      unsigned int refConformer;
+      unsigned int resConformer;
+      unsigned char aspb;
+
+      /**
+       * The quantized elements of the transformation from the reference
+       * residue to the other one, row major.
+       */
+      int tfo[12];
+
+      bool operator< (const Key &right) const;
+    };
+
+  private:
+
+    typedef list< Key > AgeList;
+
+    /**
+     * @short An annotation and its place in the age list.
+     */
+    struct Entry
+    {
+      Annotation annotation;
+      AgeList::iterator age;
+    };
+
+    typedef map< Key, Entry > EntryMap;
+
+    /**
+     * The annotations.
+     */
+    EntryMap entries;
+
+    /**
+     * The keys from the most to the least recently used.
+     */
+    AgeList ages;
+
+    /**
+     * The maximum number of annotations.
+     */
+    size_type capacity;
+
+    /**
+     * The quantization step of the translations (Angstroms).
+     */
+    float distanceTolerance;
+
+    /**
+     * The quantization step of the rotation matrix elements (about
+     * radians).
+     */
+    float angleTolerance;
+
+    /**
+     * The number of lookups that found an annotation.
+     */
+    unsigned long hits;
+
+    /**
+     * The number of lookups that missed.
+     */
+    unsigned long misses;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the cache.
+     * @param cap the maximum number of annotations.
+     * @param distance the quantization step of the translations.
+     * @param angle the quantization step of the rotations.
+     */
+    AnnotationCache (size_type cap = 100000, float distance = 0.01, float angle = 0.001);
+
+    /**
+     * Destroys the object.
+     */
+    ~AnnotationCache () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of annotations in the cache.
+     * @return the number of annotations.
+     */
+    size_type size () const { return entries.size (); }
+
+    /**
+     * Gets the maximum number of annotations.
+     * @return the capacity.
+     */
+    size_type getCapacity () const { return capacity; }
+
+    /**
+     * Sets the maximum number of annotations, dropping the least recently
+     * used ones if needed.
+     * @param cap the new capacity.
+     */
+    void setCapacity (size_type cap);
+
+    /**
+     * Gets the quantization step of the translations.
+     * @return the distance tolerance in Angstroms.
+     */
+    float getDistanceTolerance () const { return distanceTolerance; }
+
+    /**
+     * Gets the quantization step of the rotations.
+     * @return the angle tolerance in radians.
+     */
+    float getAngleTolerance () const { return angleTolerance; }
+
+    /**
+     * Sets the quantization steps.  Two residue pairs are annotated alike
+     * when their relative transformations fall in the same cell.  The cache
+     * is emptied.
+     * @param distance the quantization step of the translations.
+     * @param angle the quantization step of the rotations.
+     */
+    void setTolerance (float distance, float angle);
+
+    /**
+     * Gets the number of lookups that found an annotation.
+     * @return the number of hits.
+     */
+    unsigned long getHits () const { return hits; }
+
+    /**
+     * Gets the number of lookups that missed.
+     * @return the number of misses.
+     */
+    unsigned long getMisses () const { return misses; }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Builds the key of a residue pair.  The key is built from the pair or
+     * from its inverse, whichever orders the conformer ids, then the
+     * quantized transformations, first.
+     * @param ref the reference residue.
+     * @param res the other residue.
+     * @param aspb the annotation mask.
+     * @param key the key.
+     * @param inverted set to whether the key is the one of the inverse pair.
+     * @return false if a residue has no conformer id or has less than
+     * three atoms to define its referential.
+     */
+    bool makeKey (const Residue *ref, const Residue *res, unsigned char aspb, Key &key, bool &inverted) const;
+
+    /**
+     * Finds an annotation and marks it as the most recently used.
+     * @param key the key.
+     * @return the annotation or null if it is not cached.
+     */
+    const Annotation* find (const Key &key);
+
+    /**
+     * Stores an annotation, dropping the least recently used one if the
+     * cache is full.
+     * @param key the key.
+     * @param annotation the annotation.
+     */
+    void insert (const Key &key, const Annotation &annotation);
+
+    /**
+     * Removes every annotation and resets the hit and miss counts.
+     */
+    void clear ();
+
+  private:
+
+    /**
+     * Quantizes a transformation into a key.
+     * @param tfo the transformation.
+     * @param key the key receiving the quantized elements.
+     */
+    void quantize (const HomogeneousTransfo &tfo, Key &key) const;
+
+    /**
+     * Drops the least recently used annotations above the capacity.
+     */
+    void evict ();
+
+  };
+
+}
+
+#endif
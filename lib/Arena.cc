@@ -0,0 +1,278 @@
+//                              -*- Mode: C++ -*-
+// Arena.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:00:02 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include <cstdlib>
+#include <new>
+
+#include "Arena.h"
+
+
+
+namespace mccore
+{
+
+  const size_t Arena::granule = sizeof (double);
+
+  const size_t Arena::maxBlock = 1024;
+
+  /**
+   * The current arena of the thread.
+   */
+#ifdef __GNUC__
+  static __thread Arena *s_current = 0;
+#else
+  static Arena *s_current = 0;
+#endif
+
+  /**
+   * The chunks are 2^chunkBits bytes long.
+   */
+  static const unsigned int chunkBits = 16;
+
+  /**
+   * The chunk map covers the low 2^addressBits bytes of the address space,
+   * where the system maps user memory.  Chunks mapped above are returned
+   * and the blocks are taken from the system heap instead.
+   */
+  static const unsigned int addressBits = 8 * sizeof (size_t) < 48 ? 8 * sizeof (size_t) : 48;
+  static const unsigned int leafBits = 16;
+  static const unsigned int rootBits = addressBits - chunkBits - leafBits;
+
+  /**
+   * The arena owning each chunk, in two levels indexed by the chunk
+   * address: the leaves are allocated on demand, once and for all, and
+   * their entries are set by the arena owning the chunk.  Lookups take no
+   * lock.
+   */
+  static Arena ** volatile s_chunkMap[1 << rootBits];
+
+
+  /**
+   * Gets the chunk map entry of an address.
+   * @param p the address.
+   * @param create whether the leaf is allocated if missing.
+   * @return the entry, null if it is not mapped.
+   */
+  static Arena**
+  chunkEntry (const void *p, bool create)
+  {
+    size_t a = (size_t) p;
+    Arena **leaf;
+
+    if (0 != (a >> (addressBits - 1)) >> 1)
+      {
+	return 0;
+      }
+    a >>= chunkBits;
+    leaf = s_chunkMap[a >> leafBits];
+    if (0 == leaf && create)
+      {
+	leaf = (Arena**) calloc ((size_t) 1 << leafBits, sizeof (Arena*));
+	if (0 == leaf)
+	  {
+	    throw bad_alloc ();
+	  }
+	if (! __sync_bool_compare_and_swap (&s_chunkMap[a >> leafBits], (Arena**) 0, leaf))
+	  {
+	    free (leaf);
+	    leaf = s_chunkMap[a >> leafBits];
+	  }
+      }
+    return 0 == leaf ? 0 : leaf + (a & (((size_t) 1 << leafBits) - 1));
+  }
+
+
+  Arena::Arena ()
+    : top (0),
+      stop (0),
+      freeLists (maxBlock / granule + 1, (void*) 0),
+      uses (1),
+      refs (1)
+  {
+  }
+
+
+  Arena::~Arena ()
+  {
+    vector< char* >::iterator it;
+
+    for (it = chunks.begin (); chunks.end () != it; ++it)
+      {
+	*chunkEntry (*it, false) = 0;
+      }
+    __sync_synchronize ();
+    for (it = chunks.begin (); chunks.end () != it; ++it)
+      {
+	free (*it);
+      }
+  }
+
+
+  Arena*
+  Arena::current ()
+  {
+    return s_current;
+  }
+
+
+  void
+  Arena::setCurrent (Arena *arena)
+  {
+    s_current = arena;
+  }
+
+
+  Arena*
+  Arena::owner (const void *p)
+  {
+    Arena **entry = chunkEntry (p, false);
+
+    return 0 == entry ? 0 : *entry;
+  }
+
+
+  void
+  Arena::ref ()
+  {
+    __sync_add_and_fetch (&refs, 1);
+    __sync_add_and_fetch (&uses, 1);
+  }
+
+
+  void
+  Arena::unref ()
+  {
+    __sync_sub_and_fetch (&refs, 1);
+    release ();
+  }
+
+
+  void
+  Arena::release ()
+  {
+    if (0 == __sync_sub_and_fetch (&uses, 1))
+      {
+	delete this;
+      }
+  }
+
+
+  void*
+  Arena::carve (size_t size)
+  {
+    size_t slot = (size + granule - 1) / granule;
+    void *p;
+    Arena **entry;
+
+    if (0 != freeLists[slot])
+      {
+	p = freeLists[slot];
+	freeLists[slot] = *(void**) p;
+      }
+    else
+      {
+	if ((size_t) (stop - top) < slot * granule)
+	  {
+	    if (0 != posix_memalign (&p, (size_t) 1 << chunkBits, (size_t) 1 << chunkBits))
+	      {
+		throw bad_alloc ();
+	      }
+	    if (0 == (entry = chunkEntry (p, true)))
+	      {
+		free (p);
+		return 0;
+	      }
+	    chunks.push_back ((char*) p);
+	    *entry = this;
+	    top = chunks.back ();
+	    stop = top + ((size_t) 1 << chunkBits);
+	  }
+	p = top;
+	top += slot * granule;
+      }
+    __sync_add_and_fetch (&uses, 1);
+    return p;
+  }
+
+
+  void
+  Arena::recycle (void *p, size_t size)
+  {
+    size_t slot = (size + granule - 1) / granule;
+
+    *(void**) p = freeLists[slot];
+    freeLists[slot] = p;
+    release ();
+  }
+
+
+  void*
+  Arena::allocate (size_t size, Arena *arena)
+  {
+    void *p;
+
+    if (0 != arena
+	&& maxBlock >= size
+	&& 0 != (p = arena->carve (size)))
+      {
+	return p;
+      }
+    return ::operator new (size);
+  }
+
+
+  void
+  Arena::deallocate (void *p, size_t size)
+  {
+    Arena *arena;
+
+    if (0 != (arena = owner (p)))
+      {
+	arena->recycle (p, size);
+      }
+    else
+      {
+	::operator delete (p);
+      }
+  }
+
+
+  void
+  Arena::abandon (void *p)
+  {
+    Arena *arena;
+
+    if (0 != (arena = owner (p)))
+      {
+	arena->release ();
+      }
+    else
+      {
+	::operator delete (p);
+      }
+  }
+
+}
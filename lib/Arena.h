@@ -0,0 +1,290 @@
+//                              -*- Mode: C++ -*-
+// Arena.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:00:02 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+#ifndef _mccore_Arena_h_
+#define _mccore_Arena_h_
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * @short Pool allocator releasing its memory in bulk.
+   *
+   * An arena carves small blocks out of large chunks and recycles freed
+   * blocks through per size free lists, so that building and destroying
+   * the residues, atoms and relations of a model does not reach the system
+   * allocator for each object.  Chunks are returned to the system when the
+   * arena is destroyed.  Blocks carry no header: the arena owning a block
+   * is found from its address, and blocks taken from the system heap when
+   * no arena is current cost what they would without arenas.
+   *
+   * Arenas are reference counted: the arena is destroyed when its last
+   * reference is dropped and no block allocated from it is still in use.
+   * Classes deriving from ArenaObject are allocated in the current arena
+   * (see Arena::Scope), or in the system heap when there is none.
+   *
+   * The current arena is kept per thread and the reference count is
+   * atomic.  The free lists are not locked: an arena must only be used by
+   * one thread at a time, which holds when each model, owning its arena
+   * through its ResidueFactoryMethod, is worked on by a single thread.
+   */
+  class Arena
+  {
+  public:
+
+    /**
+     * @short Sets the current arena of the thread for the lifetime of the
+     * object.
+     *
+     * ArenaObject instances created by the thread while a scope is alive
+     * are allocated in its arena.  Scopes nest; the previous arena is
+     * restored on destruction.
+     */
+    class Scope
+    {
+      /**
+       * The arena current when the scope was opened.
+       */
+      Arena *previous;
+
+    public:
+
+      /**
+       * Makes the arena current.
+       * @param arena the arena, null for the system heap.
+       */
+      explicit Scope (Arena *arena)
+	: previous (Arena::current ())
+      {
+	Arena::setCurrent (arena);
+      }
+
+      /**
+       * Restores the previous arena.
+       */
+      ~Scope () { Arena::setCurrent (previous); }
+
+    private:
+
+      Scope (const Scope &right);
+      Scope& operator= (const Scope &right);
+
+    };
+
+  private:
+
+    /**
+     * The size granularity of the free lists.
+     */
+    static const size_t granule;
+
+    /**
+     * Blocks larger than this are taken from the system heap.
+     */
+    static const size_t maxBlock;
+
+    /**
+     * The chunks, aligned on their size so that the chunk holding a block
+     * is found by masking its address.
+     */
+    vector< char* > chunks;
+
+    /**
+     * The unused part of the last chunk.
+     */
+    char *top;
+    char *stop;
+
+    /**
+     * The free list heads, indexed by size in granules.
+     */
+    vector< void* > freeLists;
+
+    /**
+     * The number of references to the arena plus the number of blocks in
+     * use, updated atomically.  The arena is destroyed when it drops to 0.
+     */
+    volatile size_t uses;
+
+    /**
+     * The number of references to the arena, updated atomically.
+     */
+    volatile size_t refs;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the arena with one reference.
+     */
+    Arena ();
+
+  private:
+
+    /**
+     * Destroys the arena and releases its chunks.  Use unref.
+     */
+    ~Arena ();
+
+    Arena (const Arena &right);
+    Arena& operator= (const Arena &right);
+
+  public:
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the current arena of the calling thread.
+     * @return the current arena, null if allocations go to the heap.
+     */
+    static Arena* current ();
+
+    /**
+     * Gets the arena owning a block.
+     * @param p the block.
+     * @return the arena, null if the block was taken from the system heap.
+     */
+    static Arena* owner (const void *p);
+
+    /**
+     * Gets the number of blocks in use.
+     * @return the number of blocks.
+     */
+    size_t getLiveCount () const { return uses - refs; }
+
+    /**
+     * Gets the number of chunks reserved from the system.
+     * @return the number of chunks.
+     */
+    size_t getChunkCount () const { return chunks.size (); }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Adds a reference to the arena.
+     */
+    void ref ();
+
+    /**
+     * Removes a reference to the arena, destroying it if it was the last
+     * one and no block is in use.
+     */
+    void unref ();
+
+    /**
+     * Allocates a block in an arena, or in the system heap if there is no
+     * arena or the block is too large.
+     * @param size the size of the block.
+     * @param arena the arena, null for the system heap.
+     * @return the block.
+     */
+    static void* allocate (size_t size, Arena *arena);
+
+    /**
+     * Releases a block allocated by allocate to its owner.
+     * @param p the block.
+     * @param size the size of the block.
+     */
+    static void deallocate (void *p, size_t size);
+
+    /**
+     * Releases a block allocated by allocate when the size is unknown.
+     * Arena blocks are kept until the arena is destroyed.
+     * @param p the block.
+     */
+    static void abandon (void *p);
+
+  private:
+
+    /**
+     * Sets the current arena of the calling thread.
+     * @param arena the arena, null for the system heap.
+     */
+    static void setCurrent (Arena *arena);
+
+    /**
+     * Carves a block out of the arena.
+     * @param size the size of the block, at most maxBlock.
+     * @return the block, null if no chunk could be mapped.
+     */
+    void* carve (size_t size);
+
+    /**
+     * Returns a block to its free list.
+     * @param p the block.
+     * @param size the size of the block.
+     */
+    void recycle (void *p, size_t size);
+
+    /**
+     * Drops a use, a reference or a block, destroying the arena if it is
+     * no longer used.
+     */
+    void release ();
+
+  };
+
+
+  /**
+   * @short Base class for objects allocated in arenas.
+   *
+   * Instances are allocated in the current arena (see Arena::Scope), or in
+   * the arena given to the placement form of new.  They are deleted as
+   * usual.
+   */
+  class ArenaObject
+  {
+  public:
+
+    static void* operator new (size_t size)
+    {
+      return Arena::allocate (size, Arena::current ());
+    }
+
+    static void* operator new (size_t size, Arena *arena)
+    {
+      return Arena::allocate (size, arena);
+    }
+
+    static void operator delete (void *p, size_t size)
+    {
+      Arena::deallocate (p, size);
+    }
+
+    static void operator delete (void *p, Arena *)
+    {
+      Arena::abandon (p);
+    }
+
+  };
+
+}
+
+#endif
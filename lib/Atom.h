@@ -28,6 +28,7 @@
 
 #include <iostream>
 
+#include "Arena.h"
 #include "Vector3D.h"
 #include "AtomType.h"
 
@@ -51,7 +52,7 @@ namespace mccore
    * @author Martin Larose <larosem@iro.umontreal.ca>
    * @version $Id: Atom.h,v 1.12 2006-04-13 18:02:58 thibaup Exp $
    */
-  class Atom : public Vector3D
+  class Atom : public Vector3D, public ArenaObject
   {
     /**
      * The type of the atom.
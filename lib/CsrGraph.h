@@ -0,0 +1,778 @@
+//                              -*- Mode: C++ -*-
+// CsrGraph.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:54:41 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_CsrGraph_h_
+#define _mccore_CsrGraph_h_
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Exception.h"
+#include "Path.h"
+#include "ShortestPathTree.h"
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * @short Immutable compressed sparse row snapshot of a graph.
+   *
+   * The snapshot copies the vertices, their weights and the edges of a
+   * graph, then stores the endvertices of each vertex contiguously: the
+   * out-neighbor labels of label l are at positions [row_begin (l),
+   * row_end (l)) of a single array, increasingly, with the weight and the
+   * label of the corresponding edge at the same positions.  The labels are
+   * those of the source graph.  Traversals then read contiguous memory and
+   * edge lookups are binary searches in a row.  The snapshot does not
+   * follow the modifications of the source graph.
+   */
+  template< class V,
+	    class E,
+	    class VW = float,
+	    class EW = float >
+  class CsrGraph
+  {
+  public:
+
+    typedef typename vector< V >::size_type size_type;
+    typedef typename vector< V >::size_type label;
+    typedef typename vector< E >::size_type edge_label;
+    typedef typename vector< label >::const_iterator neighbor_const_iterator;
+
+  private:
+
+    /**
+     * The vertex collection.
+     */
+    vector< V > vertices;
+
+    /**
+     * The vertex weight collection.
+     */
+    vector< VW > vertexWeights;
+
+    /**
+     * The edge collection.
+     */
+    vector< E > edges;
+
+    /**
+     * The position of the first endvertices of each label, plus the total
+     * number of endvertices.
+     */
+    vector< size_type > offsets;
+
+    /**
+     * The tail label of the endvertices.
+     */
+    vector< label > targets;
+
+    /**
+     * The edge label of the endvertices.
+     */
+    vector< edge_label > edgeLabels;
+
+    /**
+     * The edge weight of the endvertices.
+     */
+    vector< EW > edgeWeights;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes an empty snapshot.
+     */
+    CsrGraph () : offsets (1, 0) { }
+
+    /**
+     * Initializes the snapshot from a graph.
+     * @param graph the graph to copy.
+     */
+    template< class G >
+    explicit CsrGraph (const G &graph) { assign (graph); }
+
+    /**
+     * Destroys the object.
+     */
+    ~CsrGraph () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of vertices.
+     * @return the number of vertices.
+     */
+    size_type size () const { return vertices.size (); }
+
+    /**
+     * Tells if the snapshot has no vertex.
+     * @return whether the snapshot is empty.
+     */
+    bool empty () const { return vertices.empty (); }
+
+    /**
+     * Gets the number of edges.
+     * @return the number of edges.
+     */
+    size_type edgeSize () const { return edges.size (); }
+
+    /**
+     * Gets the number of endvertices, the sum of the out-degrees.
+     * @return the number of endvertices.
+     */
+    size_type endVerticesSize () const { return targets.size (); }
+
+    /**
+     * Gets a vertex given its label.  No check is made on label validity.
+     * @param l the vertex label.
+     * @return the vertex.
+     */
+    const V& getVertex (label l) const { return vertices[l]; }
+
+    /**
+     * Gets a vertex weight given its label.  No check is made on label
+     * validity.
+     * @param l the vertex label.
+     * @return the vertex weight.
+     */
+    const VW& getVertexWeight (label l) const { return vertexWeights[l]; }
+
+    /**
+     * Gets an edge given its label.  No check is made on label validity.
+     * @param e the edge label.
+     * @return the edge.
+     */
+    const E& getEdge (edge_label e) const { return edges[e]; }
+
+    /**
+     * Gets the position of the first endvertices of a label.
+     * @param l the head label.
+     * @return the position.
+     */
+    size_type row_begin (label l) const { return offsets[l]; }
+
+    /**
+     * Gets the position past the last endvertices of a label.
+     * @param l the head label.
+     * @return the position.
+     */
+    size_type row_end (label l) const { return offsets[l + 1]; }
+
+    /**
+     * Gets the tail label of the endvertices at a position.
+     * @param i the position.
+     * @return the tail label.
+     */
+    label getTarget (size_type i) const { return targets[i]; }
+
+    /**
+     * Gets the edge label of the endvertices at a position.
+     * @param i the position.
+     * @return the edge label.
+     */
+    edge_label getEdgeLabel (size_type i) const { return edgeLabels[i]; }
+
+    /**
+     * Gets the edge weight of the endvertices at a position.
+     * @param i the position.
+     * @return the edge weight.
+     */
+    const EW& getEdgeWeight (size_type i) const { return edgeWeights[i]; }
+
+    /**
+     * Gets an iterator on the first out-neighbor label of a label.
+     * @param l the vertex label.
+     * @return the iterator.
+     */
+    neighbor_const_iterator neighbor_begin (label l) const { return targets.begin () + offsets[l]; }
+
+    /**
+     * Gets an iterator past the last out-neighbor label of a label.
+     * @param l the vertex label.
+     * @return the iterator.
+     */
+    neighbor_const_iterator neighbor_end (label l) const { return targets.begin () + offsets[l + 1]; }
+
+    /**
+     * Gets the out-degree of a label.
+     * @param l the vertex label.
+     * @return the number of out-neighbors.
+     */
+    size_type degree (label l) const { return offsets[l + 1] - offsets[l]; }
+
+    /**
+     * Finds the position of the endvertices (h, t).
+     * @param h the head label.
+     * @param t the tail label.
+     * @return the position or endVerticesSize () if h and t are not
+     * connected.
+     */
+    size_type findEndVertices (label h, label t) const
+    {
+      neighbor_const_iterator it;
+
+      if (vertices.size () <= h)
+	{
+	  return targets.size ();
+	}
+      it = std::lower_bound (neighbor_begin (h), neighbor_end (h), t);
+      return (neighbor_end (h) != it && t == *it
+	      ? it - targets.begin ()
+	      : targets.size ());
+    }
+
+    /**
+     * Tells if there is an edge from h to t.
+     * @param h the head label.
+     * @param t the tail label.
+     * @return whether h and t are connected.
+     */
+    bool areConnected (label h, label t) const
+    {
+      return targets.size () != findEndVertices (h, t);
+    }
+
+    /**
+     * Gets the edge from h to t.
+     * @param h the head label.
+     * @param t the tail label.
+     * @return the edge.
+     * @exception NoSuchElementException if h and t are not connected.
+     */
+    const E& getEdge (label h, label t) const throw (NoSuchElementException)
+    {
+      size_type i;
+
+      if (targets.size () == (i = findEndVertices (h, t)))
+	{
+	  throw NoSuchElementException ();
+	}
+      return edges[edgeLabels[i]];
+    }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Replaces the snapshot with a copy of a graph.  The graph must provide
+     * the Graph label interface.
+     * @param graph the graph to copy.
+     */
+    template< class G >
+    void assign (const G &graph)
+    {
+      typename G::edge_const_iterator eit;
+      label l;
+
+      vertices.clear ();
+      vertexWeights.clear ();
+      edges.clear ();
+      offsets.clear ();
+      targets.clear ();
+      edgeLabels.clear ();
+      edgeWeights.clear ();
+      for (l = 0; graph.internalContains (l); ++l)
+	{
+	  const vector< typename G::label > &adjacency = graph.internalOutAdjacency (l);
+	  typename vector< typename G::label >::const_iterator it;
+
+	  vertices.push_back (graph.internalGetVertex (l));
+	  vertexWeights.push_back (graph.internalGetVertexWeight (l));
+	  offsets.push_back (targets.size ());
+	  for (it = adjacency.begin (); adjacency.end () != it; ++it)
+	    {
+	      targets.push_back (*it);
+	      edgeLabels.push_back (graph.internalGetEdgeLabel (l, *it));
+	      edgeWeights.push_back (graph.internalGetEdgeWeight (edgeLabels.back ()));
+	    }
+	}
+      offsets.push_back (targets.size ());
+      edges.assign (graph.edge_begin (), graph.edge_end ());
+    }
+
+    /**
+     * Labels the connected components of the snapshot, the endvertices
+     * being followed in their direction.  On a symmetric graph, components
+     * are numbered from 0 in the order of their lowest vertex label.
+     * @param components the component number of each vertex label to fill.
+     * @return the number of connected components.
+     */
+    size_type connectedComponents (vector< label > &components) const
+    {
+      const label unset = numeric_limits< label >::max ();
+      vector< label > stack;
+      size_type count;
+      label l;
+
+      components.assign (vertices.size (), unset);
+      for (count = 0, l = 0; vertices.size () > l; ++l)
+	{
+	  if (unset == components[l])
+	    {
+	      components[l] = count;
+	      stack.push_back (l);
+	      while (! stack.empty ())
+		{
+		  size_type i;
+		  size_type end;
+		  label w;
+
+		  w = stack.back ();
+		  stack.pop_back ();
+		  for (i = offsets[w], end = offsets[w + 1]; end != i; ++i)
+		    {
+		      if (unset == components[targets[i]])
+			{
+			  components[targets[i]] = count;
+			  stack.push_back (targets[i]);
+			}
+		    }
+		}
+	      ++count;
+	    }
+	}
+      return count;
+    }
+
+    /**
+     * Computes the number of edges of the shortest paths from a source by
+     * a breadth first search.
+     * @param source the source label.
+     * @param distances the distance of each vertex label to fill, the max
+     * value of size_type for the unreachable vertices.
+     */
+    void breadthFirstDistances (label source, vector< size_type > &distances) const
+    {
+      const size_type unset = numeric_limits< size_type >::max ();
+      vector< label > queue;
+      size_type head;
+
+      distances.assign (vertices.size (), unset);
+      distances[source] = 0;
+      queue.push_back (source);
+      for (head = 0; queue.size () > head; ++head)
+	{
+	  label w = queue[head];
+	  size_type i;
+	  size_type end;
+
+	  for (i = offsets[w], end = offsets[w + 1]; end != i; ++i)
+	    {
+	      if (unset == distances[targets[i]])
+		{
+		  distances[targets[i]] = distances[w] + 1;
+		  queue.push_back (targets[i]);
+		}
+	    }
+	}
+    }
+
+    /**
+     * Dijkstra's algorithm for the shortest path tree of
+     * UndirectedGraph::sptDijkstraTiernan run on the snapshot, building
+     * the paths.
+     * @param source the source label.
+     * @param paths a collection of Path to fill with the SPT.
+     */
+    template< class Compare >
+    void sptDijkstraTiernan (label source, vector< Path< label, size_type > > &paths, Compare comparator = less< label > ()) const
+    {
+      vector< label > predecessors;
+      vector< size_type > values;
+      label w;
+
+      sptDijkstraTiernan (source, predecessors, values, comparator);
+      paths.clear ();
+      paths.resize (vertices.size ());
+      for (w = 0; w < paths.size (); ++w)
+	{
+	  sptPath (source, predecessors, values, w, paths[w]);
+	}
+    }
+
+    /**
+     * Dijkstra's algorithm for the shortest path tree of
+     * UndirectedGraph::sptDijkstraTiernan run on the snapshot, see
+     * mccore::sptDijkstraTiernan.  The results are the same as on the
+     * source graph.  The edge weights are cast to size_type.
+     * @param source the source label.
+     * @param predecessors the predecessor labels to fill, the source and
+     * the unreachable vertices are their own predecessors.
+     * @param values the path values to fill, set to the max value of
+     * size_type for the source and the unreachable vertices.
+     */
+    template< class Compare >
+    void sptDijkstraTiernan (label source, vector< label > &predecessors, vector< size_type > &values, Compare comparator = less< label > ()) const
+    {
+      mccore::sptDijkstraTiernan (SptAdjacency (*this), source, predecessors, values, comparator);
+    }
+
+    /**
+     * Builds the path from the source to a vertex from the output of
+     * sptDijkstraTiernan, see mccore::sptPath.
+     * @param source the source label.
+     * @param predecessors the predecessor labels.
+     * @param values the path values.
+     * @param target the last vertex of the path.
+     * @param path the path to fill.
+     */
+    void sptPath (label source, const vector< label > &predecessors, const vector< size_type > &values, label target, Path< label, size_type > &path) const
+    {
+      mccore::sptPath (source, predecessors, values, target, path);
+    }
+
+  private:
+
+    /**
+     * Neighbor and weight access of the snapshot for the shortest path
+     * tree.
+     */
+    class SptAdjacency
+    {
+      const CsrGraph &graph;
+
+    public:
+
+      typedef neighbor_const_iterator neighbor_iterator;
+
+      SptAdjacency (const CsrGraph &g) : graph (g) { }
+
+      size_type size () const { return graph.size (); }
+
+      neighbor_iterator neighbor_begin (label w) const { return graph.neighbor_begin (w); }
+
+      neighbor_iterator neighbor_end (label w) const { return graph.neighbor_end (w); }
+
+      size_type weight (label, neighbor_iterator it) const
+      {
+	return (size_type) graph.edgeWeights[it - graph.targets.begin ()];
+      }
+    };
+
+    /**
+     * Computes the number of edges of the shortest paths from a source up
+     * to a radius, avoiding the blocked vertices and edges.  The reached
+     * labels are appended to touched so that the distances can be reset
+     * without visiting the whole snapshot.
+     * @param source the source label.
+     * @param radius the maximum distance to compute.
+     * @param blockedVertices the vertex labels that are not crossed.
+     * @param blockedEdges the edge labels that are not followed.
+     * @param distances the distances, the max value of size_type for the
+     * vertices out of reach.
+     * @param touched the labels whose distance was set.
+     */
+    void boundedDistances (label source, size_type radius, const vector< bool > &blockedVertices, const vector< bool > &blockedEdges, vector< size_type > &distances, vector< label > &touched) const
+    {
+      const size_type unset = numeric_limits< size_type >::max ();
+      size_type head;
+
+      head = touched.size ();
+      distances[source] = 0;
+      touched.push_back (source);
+      for (; touched.size () > head; ++head)
+	{
+	  label w = touched[head];
+	  size_type i;
+	  size_type end;
+
+	  if (radius == distances[w])
+	    {
+	      continue;
+	    }
+	  for (i = offsets[w], end = offsets[w + 1]; end != i; ++i)
+	    {
+	      label n = targets[i];
+
+	      if (unset == distances[n]
+		  && ! blockedVertices[n]
+		  && ! blockedEdges[edgeLabels[i]])
+		{
+		  distances[n] = distances[w] + 1;
+		  touched.push_back (n);
+		}
+	    }
+	}
+    }
+
+    /**
+     * Depth first search of the simple cycles closing on the first vertex
+     * of a path.  The path is extended from its last vertex through the
+     * unblocked vertices and edges while the distance back to the first
+     * vertex keeps the cycle within maxLength edges.  When oriented is
+     * false a cycle is only given in the direction where its second vertex
+     * is lower than its last one.
+     * @param path the starting path, restored on return.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param oriented whether the cycles are given in both directions.
+     * @param blockedVertices the vertex labels that are not crossed.
+     * @param blockedEdges the edge labels that are not followed.
+     * @param distances the distances to the first vertex of the path.
+     * @param onPath the marks of the vertices in the path, restored on
+     * return.
+     * @param visitor the function object receiving the cycles.
+     * @param count the number of visited cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return false if the enumeration must stop.
+     */
+    template< class Visitor >
+    bool boundedCycles (Path< label, size_type > &path, size_type maxLength, bool oriented, const vector< bool > &blockedVertices, const vector< bool > &blockedEdges, const vector< size_type > &distances, vector< bool > &onPath, Visitor &visitor, size_type &count, size_type maxCount) const
+    {
+      const size_type unset = numeric_limits< size_type >::max ();
+      label source = path.front ();
+      size_type prefix = path.size ();
+      vector< size_type > next;
+      bool more = true;
+
+      next.push_back (offsets[path.back ()]);
+      while (! next.empty ())
+	{
+	  label v = path.back ();
+	  size_type &i = next.back ();
+
+	  if (! more || offsets[v + 1] == i)
+	    {
+	      if (path.size () > prefix)
+		{
+		  onPath[v] = false;
+		  path.pop_back ();
+		}
+	      next.pop_back ();
+	    }
+	  else
+	    {
+	      label w = targets[i];
+	      edge_label e = edgeLabels[i];
+
+	      ++i;
+	      if (blockedEdges[e])
+		{
+		  continue;
+		}
+	      if (source == w)
+		{
+		  if (2 < path.size () && (oriented || path[1] < v))
+		    {
+		      if (0 != maxCount && maxCount == count)
+			{
+			  more = false;
+			  continue;
+			}
+		      path.setValue (path.size ());
+		      ++count;
+		      more = visitor (path);
+		    }
+		}
+	      else if (! onPath[w]
+		       && ! blockedVertices[w]
+		       && unset != distances[w]
+		       && maxLength >= path.size () + distances[w])
+		{
+		  onPath[w] = true;
+		  path.push_back (w);
+		  next.push_back (offsets[w]);
+		}
+	    }
+	}
+      return more;
+    }
+
+  public:
+
+    /**
+     * Enumerates the simple cycles of at most maxLength edges going
+     * through at least one of the root vertices, on a symmetric snapshot.
+     * The roots are searched in order by a bounded depth first search
+     * that does not cross the roots already searched, so that each cycle
+     * is given once, starting with its first root.  The search is pruned
+     * with the distances to the root, which keeps it local to the
+     * neighborhood of the roots.  The visitor is called as visitor (cycle)
+     * with a Path of labels where the first and last vertices are
+     * connected and whose value is its number of edges.  The path is only
+     * valid during the call and the visitor returns false to stop the
+     * enumeration.
+     * @param roots the root vertex labels.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param visitor the function object receiving the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type shortCycles (const vector< label > &roots, size_type maxLength, Visitor &visitor, size_type maxCount = 0) const
+    {
+      const size_type unset = numeric_limits< size_type >::max ();
+      typename vector< label >::const_iterator it;
+      vector< bool > blockedVertices (vertices.size (), false);
+      vector< bool > blockedEdges (edges.size (), false);
+      vector< bool > onPath (vertices.size (), false);
+      vector< size_type > distances (vertices.size (), unset);
+      vector< label > touched;
+      Path< label, size_type > path;
+      size_type count;
+      bool more;
+
+      count = 0;
+      if (3 > maxLength)
+	{
+	  return count;
+	}
+      for (more = true, it = roots.begin (); more && roots.end () != it; ++it)
+	{
+	  typename vector< label >::const_iterator tIt;
+
+	  if (blockedVertices[*it])
+	    {
+	      continue;
+	    }
+	  boundedDistances (*it, maxLength / 2, blockedVertices, blockedEdges, distances, touched);
+	  path.clear ();
+	  path.push_back (*it);
+	  more = boundedCycles (path, maxLength, false, blockedVertices, blockedEdges, distances, onPath, visitor, count, maxCount);
+	  for (tIt = touched.begin (); touched.end () != tIt; ++tIt)
+	    {
+	      distances[*tIt] = unset;
+	    }
+	  touched.clear ();
+	  blockedVertices[*it] = true;
+	}
+      return count;
+    }
+
+    /**
+     * Enumerates the simple cycles of at most maxLength edges of a
+     * symmetric snapshot.  This is shortCycles over every vertex label in
+     * increasing order: each cycle is given once, starting with its lowest
+     * label.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param visitor the function object receiving the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type shortCycles (size_type maxLength, Visitor &visitor, size_type maxCount = 0) const
+    {
+      vector< label > roots;
+      label l;
+
+      roots.reserve (vertices.size ());
+      for (l = 0; vertices.size () > l; ++l)
+	{
+	  roots.push_back (l);
+	}
+      return shortCycles (roots, maxLength, visitor, maxCount);
+    }
+
+    /**
+     * Enumerates the simple cycles of at most maxLength edges going
+     * through at least one of the root edges, on a symmetric snapshot.
+     * The cycles through a root edge (h, t) are searched as paths from t
+     * back to h, pruned with the distances to h without the root edge,
+     * that do not follow the roots already searched, so that
+     * each cycle is given once, starting with the endvertices of its first
+     * root.  The visitor is called as in shortCycles.
+     * @param roots the root edge labels.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param visitor the function object receiving the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type shortCyclesThrough (const vector< edge_label > &roots, size_type maxLength, Visitor &visitor, size_type maxCount = 0) const
+    {
+      const size_type unset = numeric_limits< size_type >::max ();
+      typename vector< edge_label >::const_iterator it;
+      vector< bool > blockedVertices (vertices.size (), false);
+      vector< bool > blockedEdges (edges.size (), false);
+      vector< bool > onPath (vertices.size (), false);
+      vector< size_type > distances (vertices.size (), unset);
+      vector< label > heads (edges.size (), unset);
+      vector< label > tails (edges.size (), unset);
+      vector< label > touched;
+      Path< label, size_type > path;
+      size_type count;
+      label l;
+      bool more;
+
+      count = 0;
+      if (3 > maxLength)
+	{
+	  return count;
+	}
+      for (l = 0; vertices.size () > l; ++l)
+	{
+	  size_type i;
+
+	  for (i = offsets[l]; offsets[l + 1] != i; ++i)
+	    {
+	      if (unset == heads[edgeLabels[i]])
+		{
+		  heads[edgeLabels[i]] = l;
+		  tails[edgeLabels[i]] = targets[i];
+		}
+	    }
+	}
+      for (more = true, it = roots.begin (); more && roots.end () != it; ++it)
+	{
+	  typename vector< label >::const_iterator tIt;
+
+	  if (blockedEdges[*it] || unset == heads[*it] || heads[*it] == tails[*it])
+	    {
+	      continue;
+	    }
+	  blockedEdges[*it] = true;
+	  boundedDistances (heads[*it], maxLength - 1, blockedVertices, blockedEdges, distances, touched);
+	  if (unset != distances[tails[*it]])
+	    {
+	      path.clear ();
+	      path.push_back (heads[*it]);
+	      path.push_back (tails[*it]);
+	      onPath[tails[*it]] = true;
+	      more = boundedCycles (path, maxLength, true, blockedVertices, blockedEdges, distances, onPath, visitor, count, maxCount);
+	      onPath[tails[*it]] = false;
+	    }
+	  for (tIt = touched.begin (); touched.end () != tIt; ++tIt)
+	    {
+	      distances[*tIt] = unset;
+	    }
+	  touched.clear ();
+	}
+      return count;
+    }
+
+  };
+
+}
+
+#endif
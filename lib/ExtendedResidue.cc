@@ -48,7 +48,7 @@ namespace mccore
     
     for (this->atomGlobal.begin (); cit != this->atomGlobal.end (); ++cit)
     {
-    	this->atomLocal.push_back ((*cit)->clone ());
+    	this->atomLocal.push_back (this->_clone_atom (**cit));
     }
   }
 
@@ -67,7 +67,7 @@ namespace mccore
     // harden atoms
     for (cit = this->atomLocal.begin (); cit != this->atomLocal.end (); ++cit)
     {
-      *cit = (*cit)->clone ();
+      *cit = this->_clone_atom (**cit);
     }
   }
 
@@ -85,7 +85,7 @@ namespace mccore
 
       for (cit = this->atomGlobal.begin (); cit != this->atomGlobal.end (); ++cit)
       {
-         this->atomLocal.push_back ((*cit)->clone ());
+         this->atomLocal.push_back (this->_clone_atom (**cit));
       }
 
       this->placed = true; // because referential is identity
@@ -126,7 +126,7 @@ namespace mccore
 
 	for (cit = this->atomGlobal.begin (); cit != this->atomGlobal.end (); ++cit)
 	{
-	  this->atomLocal.push_back ((*cit)->clone ());
+	  this->atomLocal.push_back (this->_clone_atom (**cit));
 	}
 
 	this->referential.setIdentity ();
@@ -149,7 +149,7 @@ namespace mccore
 
     for (cit = exres.atomLocal.begin (); cit != exres.atomLocal.end (); ++cit)
     {
-      this->atomLocal.push_back ((*cit)->clone ());
+      this->atomLocal.push_back (this->_clone_atom (**cit));
     }
 
     this->referential = exres.referential;
@@ -198,8 +198,8 @@ namespace mccore
 
     if (inserted.second)
       {
-	atomGlobal.push_back (atom.clone ());
-	atomLocal.push_back (atom.clone ());
+	atomGlobal.push_back (this->_clone_atom (atom));
+	atomLocal.push_back (this->_clone_atom (atom));
 	rib_dirty_ref = true;
       }
     else
@@ -319,8 +319,8 @@ namespace mccore
 
     if (inserted.second)
       {
-	this->atomLocal.push_back (new Atom (0.0, 0.0, 0.0, aType));
-	this->atomGlobal.push_back (new Atom (0.0, 0.0, 0.0, aType));
+	this->atomLocal.push_back (new (this->arena) Atom (0.0, 0.0, 0.0, aType));
+	this->atomGlobal.push_back (new (this->arena) Atom (0.0, 0.0, 0.0, aType));
 	this->rib_dirty_ref = true;
 	return this->atomLocal[pos];
       }
@@ -0,0 +1,520 @@
+//                              -*- Mode: C++ -*-
+// FixedMaximumFlowGraph.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:17:56 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_FixedMaximumFlowGraph_h_
+#define _mccore_FixedMaximumFlowGraph_h_
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * @short Array based maximum flow network of bounded size.
+   *
+   * The network solves the same problem as MaximumFlowGraph::preFlowPush
+   * on small networks such as the hydrogen bond networks of a residue
+   * pair.  The number of vertices is fixed at construction: the edges are
+   * found through a capacity x capacity table of edge labels and the
+   * flows, capacities and excesses are kept in flat arrays, so that
+   * building and solving a network only allocates a few arrays.  Vertices
+   * are the labels 0 to size () - 1, in insertion order, and the edges
+   * are labelled in connection order.  The neighbors are visited in
+   * increasing label order and the push-relabel steps are those of
+   * MaximumFlowGraph::preFlowPush, so that the flows are the same.  The
+   * edges must implement the method:
+   * <pre>
+   *      float getValue ()
+   * </pre>
+   * giving the edge capacity.
+   */
+  template< class E >
+  class FixedMaximumFlowGraph
+  {
+  public:
+
+    typedef typename vector< E >::size_type size_type;
+    typedef size_type label;
+    typedef size_type edge_label;
+
+  private:
+
+    /**
+     * The edge label of absent edges in the table.
+     */
+    static const edge_label none = (edge_label) -1;
+
+    /**
+     * The maximum number of vertices.
+     */
+    size_type capacity;
+
+    /**
+     * The number of vertices.
+     */
+    size_type vertexCount;
+
+    /**
+     * The edge label of each (head, tail) pair, row major.
+     */
+    vector< edge_label > table;
+
+    /**
+     * The edge collection.
+     */
+    vector< E > edges;
+
+    /**
+     * The head label of the edges.
+     */
+    vector< label > heads;
+
+    /**
+     * The tail label of the edges.
+     */
+    vector< label > tails;
+
+    /**
+     * The flow of the edges.
+     */
+    vector< float > flows;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes an empty network that can hold up to capacity vertices.
+     * @param capacity the maximum number of vertices.
+     */
+    explicit FixedMaximumFlowGraph (size_type capacity)
+      : capacity (capacity),
+	vertexCount (0),
+	table (capacity * capacity, none)
+    { }
+
+    /**
+     * Destroys the object.
+     */
+    ~FixedMaximumFlowGraph () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of vertices.
+     * @return the number of vertices.
+     */
+    size_type size () const { return vertexCount; }
+
+    /**
+     * Gets the maximum number of vertices.
+     * @return the capacity given at construction.
+     */
+    size_type max_size () const { return capacity; }
+
+    /**
+     * Gets the number of edges.
+     * @return the number of edges.
+     */
+    size_type edgeSize () const { return edges.size (); }
+
+    /**
+     * Gets an edge.
+     * @param e the edge label.
+     * @return the edge.
+     */
+    E& internalGetEdge (edge_label e) { return edges[e]; }
+
+    /**
+     * Gets an edge.
+     * @param e the edge label.
+     * @return the edge.
+     */
+    const E& internalGetEdge (edge_label e) const { return edges[e]; }
+
+    /**
+     * Gets the flow of an edge.
+     * @param e the edge label.
+     * @return the flow.
+     */
+    float internalGetEdgeWeight (edge_label e) const { return flows[e]; }
+
+    /**
+     * Tells if two vertices are connected by an edge.
+     * @param h the head vertex label.
+     * @param t the tail vertex label.
+     * @return whether the edge (h, t) exists.
+     */
+    bool internalAreConnected (label h, label t) const
+    {
+      return none != table[h * capacity + t];
+    }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Adds a vertex whose label is the current size of the network.
+     * @return false if the network is full.
+     */
+    bool insert ()
+    {
+      if (capacity == vertexCount)
+	{
+	  return false;
+	}
+      ++vertexCount;
+      return true;
+    }
+
+    /**
+     * Connects two vertices with an edge and its initial flow.
+     * @param h the head vertex label.
+     * @param t the tail vertex label.
+     * @param e the edge.
+     * @param w the initial flow.
+     * @return false if the edge was already in the network.
+     */
+    bool internalConnect (label h, label t, const E &e, float w)
+    {
+      edge_label &l = table[h * capacity + t];
+
+      if (none != l)
+	{
+	  return false;
+	}
+      l = edges.size ();
+      edges.push_back (e);
+      heads.push_back (h);
+      tails.push_back (t);
+      flows.push_back (w);
+      return true;
+    }
+
+    /**
+     * Removes the vertices and edges.
+     */
+    void clear ()
+    {
+      edge_label e;
+
+      for (e = 0; edges.size () > e; ++e)
+	{
+	  table[heads[e] * capacity + tails[e]] = none;
+	}
+      vertexCount = 0;
+      edges.clear ();
+      heads.clear ();
+      tails.clear ();
+      flows.clear ();
+    }
+
+    /**
+     * Pre Flow Push algorithm of MaximumFlowGraph::preFlowPush, minimizing
+     * each individual flow.  The flows are written as the edge weights.
+     * @param source the source label.
+     * @param sink the sink label.
+     */
+    void preFlowPush (label source, label sink)
+    {
+      vector< int > labels (vertexCount, numeric_limits< int >::max ());
+      vector< float > excess (vertexCount, 0);
+      vector< label > queue;
+      vector< float > scratch;
+      size_type head;
+      label w;
+
+      // Compute the initial distance labels
+      labels[source] = 0;
+      queue.push_back (source);
+      for (head = 0; queue.size () > head; ++head)
+	{
+	  label front = queue[head];
+	  int distance = labels[front] + 1;
+
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      if (internalAreConnected (front, w) && labels[w] > distance)
+		{
+		  labels[w] = distance;
+		  queue.push_back (w);
+		}
+	    }
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      if (internalAreConnected (w, front) && labels[w] > distance)
+		{
+		  labels[w] = distance;
+		  queue.push_back (w);
+		}
+	    }
+	}
+
+      // Flood from the source
+      queue.clear ();
+      for (w = 0; vertexCount > w; ++w)
+	{
+	  if (internalAreConnected (source, w))
+	    {
+	      edge_label e = table[source * capacity + w];
+
+	      flows[e] = edges[e].getValue ();
+	      excess[w] = flows[e];
+	      excess[source] -= excess[w];
+	      queue.push_back (w);
+	    }
+	}
+
+      head = 0;
+      while (queue.size () > head)
+	{
+	  pushRelabel (queue, head, excess, labels, source, sink, scratch);
+	  if (0 == excess[queue[head]])
+	    {
+	      ++head;
+	    }
+	}
+    }
+
+  private:
+
+    /**
+     * Push-Relabel part of the Pre Flow Push algorithm.
+     * @param active the active labels, from position head.
+     * @param head the position of the front of the active labels.
+     * @param excess the excess of each label.
+     * @param labels the distance of each label.
+     * @param source the source vertex label.
+     * @param sink the sink vertex label.
+     * @param cap a buffer for the residual capacities.
+     */
+    void pushRelabel (vector< label > &active, size_type head, vector< float > &excess, vector< int > &labels, label source, label sink, vector< float > &cap)
+    {
+      label front;
+      label w;
+
+      front = active[head];
+      if (0 < excess[front])
+	{
+	  float eq;
+
+	  cap.clear ();
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      edge_label e = table[front * capacity + w];
+
+	      if (none != e
+		  && labels[w] > labels[front]
+		  && flows[e] < edges[e].getValue ())
+		{
+		  cap.push_back (edges[e].getValue () - flows[e]);
+		}
+	    }
+	  eq = equilibrateFlow (cap, excess[front]);
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      edge_label e = table[front * capacity + w];
+
+	      if (none != e
+		  && labels[w] > labels[front]
+		  && flows[e] < edges[e].getValue ())
+		{
+		  float push_delta;
+
+		  push_delta = min (eq, edges[e].getValue () - flows[e]);
+		  flows[e] = flows[e] + push_delta;
+		  excess[front] -= push_delta;
+		  if (fabs (excess[front]) < 1e-5)
+		    {
+		      excess[front] = 0;
+		    }
+		  if (w != source && w != sink)
+		    {
+		      active.push_back (w);
+		    }
+		  excess[w] += push_delta;
+		}
+	    }
+	}
+
+      if (0 < excess[front])
+	{
+	  float eq;
+
+	  cap.clear ();
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      edge_label e = table[w * capacity + front];
+
+	      if (none != e
+		  && labels[w] > labels[front]
+		  && 0 < flows[e])
+		{
+		  cap.push_back (flows[e]);
+		}
+	    }
+	  eq = equilibrateFlow (cap, excess[front]);
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      edge_label e = table[w * capacity + front];
+
+	      if (none != e
+		  && labels[w] > labels[front]
+		  && 0 < flows[e])
+		{
+		  float push_delta;
+
+		  push_delta = min (eq, flows[e]);
+		  flows[e] = flows[e] - push_delta;
+		  excess[front] -= push_delta;
+		  if (fabs (excess[front]) < 1e-5)
+		    {
+		      excess[front] = 0;
+		    }
+		  if (w != source && w != sink)
+		    {
+		      active.push_back (w);
+		    }
+		  excess[w] += push_delta;
+		}
+	    }
+	}
+
+      if (0 < excess[front])
+	{
+	  int max_dist;
+
+	  max_dist = -2 * (int) vertexCount;
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      edge_label e = table[front * capacity + w];
+
+	      if (none != e
+		  && 0 < edges[e].getValue () - flows[e]
+		  && labels[w] > max_dist)
+		{
+		  max_dist = labels[w];
+		}
+	    }
+	  for (w = 0; vertexCount > w; ++w)
+	    {
+	      edge_label e = table[w * capacity + front];
+
+	      if (none != e
+		  && 0 < flows[e]
+		  && labels[w] > max_dist)
+		{
+		  max_dist = labels[w];
+		}
+	    }
+	  labels[front] = max_dist - 1;
+	}
+    }
+
+    /**
+     * Reequilibrates the flows as MaximumFlowGraph does.
+     * @param capacities the residual capacities, sorted on return.
+     * @param excess the excess to distribute.
+     * @return the flow given to each edge.
+     */
+    static float equilibrateFlow (vector< float > &capacities, float excess)
+    {
+      typename vector< float >::size_type i;
+
+      sort (capacities.begin (), capacities.end ());
+      for (i = 0; i < capacities.size (); ++i)
+	{
+	  if (capacities[i] < (excess / (capacities.size () - i)))
+	    {
+	      excess -= capacities[i];
+	    }
+	  else
+	    {
+	      break;
+	    }
+	}
+      if (i == capacities.size ())
+	{
+	  // The capacity of the donor/acceptor is not exceeded, so give
+	  // everything
+	  return 1;
+	}
+      return excess / (capacities.size () - i);
+    }
+
+  public:
+
+    // I/O ------------------------------------------------------------------
+
+    /**
+     * Writes the network edges and flows to the output stream.
+     * @param os the output stream.
+     * @return the output stream.
+     */
+    ostream& write (ostream &os) const
+    {
+      edge_label e;
+
+      os << "[FixedMaximumFlowGraph]" << endl;
+      for (e = 0; edges.size () > e; ++e)
+	{
+	  os << heads[e] << " -> " << tails[e] << " " << edges[e] << " " << flows[e] << endl;
+	}
+      return os;
+    }
+
+  };
+
+
+  template< class E >
+  const typename FixedMaximumFlowGraph< E >::edge_label FixedMaximumFlowGraph< E >::none;
+
+}
+
+
+
+namespace std
+{
+
+  /**
+   * Writes the fixed maximum flow graph into the output stream.
+   * @param os the output stream.
+   * @param obj the graph.
+   * @return the output stream.
+   */
+  template < class E >
+  ostream& operator<< (ostream &os, const mccore::FixedMaximumFlowGraph< E > &obj)
+  {
+    return obj.write (os);
+  }
+
+}
+
+#endif
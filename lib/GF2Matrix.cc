@@ -0,0 +1,140 @@
+//                              -*- Mode: C++ -*-
+// GF2Matrix.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:21:35 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include "GF2Matrix.h"
+
+
+
+namespace mccore
+{
+
+  /**
+   * Gets the index of the lowest bit set in a non null word.
+   */
+  static inline unsigned int
+  lowestBit (unsigned long w)
+  {
+#ifdef __GNUC__
+    return __builtin_ctzl (w);
+#else
+    unsigned int n;
+
+    for (n = 0; 0 == (w & 1); ++n)
+      {
+	w >>= 1;
+      }
+    return n;
+#endif
+  }
+
+  // GF2Vector ----------------------------------------------------------------
+
+  const GF2Vector::size_type GF2Vector::npos = (GF2Vector::size_type) -1;
+
+
+  GF2Vector&
+  GF2Vector::operator^= (const GF2Vector &right)
+  {
+    vector< word_type >::iterator it;
+    vector< word_type >::const_iterator rit;
+
+    for (it = words.begin (), rit = right.words.begin (); words.end () != it; ++it, ++rit)
+      {
+	*it ^= *rit;
+      }
+    return *this;
+  }
+
+
+  bool
+  GF2Vector::none () const
+  {
+    vector< word_type >::const_iterator it;
+
+    for (it = words.begin (); words.end () != it; ++it)
+      {
+	if (0 != *it)
+	  {
+	    return false;
+	  }
+      }
+    return true;
+  }
+
+
+  void
+  GF2Vector::reset ()
+  {
+    words.assign (words.size (), 0);
+  }
+
+
+  GF2Vector::size_type
+  GF2Vector::firstOfUnion (const GF2Vector &right) const
+  {
+    size_type index;
+
+    for (index = 0; words.size () > index; ++index)
+      {
+	word_type w = words[index] | right.words[index];
+
+	if (0 != w)
+	  {
+	    return index * wordBits () + lowestBit (w);
+	  }
+      }
+    return npos;
+  }
+
+  // GF2Matrix ----------------------------------------------------------------
+
+  pair< bool, GF2Matrix::size_type >
+  GF2Matrix::reduce (GF2Vector &candidate) const
+  {
+    size_type pos;
+
+    for (pos = 0; rows.size () > pos; ++pos)
+      {
+	const GF2Vector &row = rows[pos];
+	GF2Vector::size_type j;
+
+	if (GF2Vector::npos == (j = candidate.firstOfUnion (row)))
+	  {
+	    continue;
+	  }
+	if (candidate.test (j))
+	  {
+	    if (! row.test (j))
+	      {
+		return make_pair (false, pos);
+	      }
+	    candidate ^= row;
+	  }
+      }
+    return make_pair (candidate.none (), rows.size ());
+  }
+
+}
@@ -0,0 +1,259 @@
+//                              -*- Mode: C++ -*-
+// GF2Matrix.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:21:35 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_GF2Matrix_h_
+#define _mccore_GF2Matrix_h_
+
+#include <climits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * @short Bit vector over GF(2) packed in machine words.
+   *
+   * It is used as an edge incidence vector of a cycle.  Addition over
+   * GF(2) is a word by word exclusive or.
+   */
+  class GF2Vector
+  {
+  public:
+
+    typedef vector< bool >::size_type size_type;
+
+    /**
+     * Index returned when no bit is set.
+     */
+    static const size_type npos;
+
+  private:
+
+    typedef unsigned long word_type;
+
+    /**
+     * The number of bits in the vector.
+     */
+    size_type bits;
+
+    /**
+     * The packed bits, the lowest index in the lowest bit of the first word.
+     */
+    vector< word_type > words;
+
+    /**
+     * Gets the number of bits in a word.
+     */
+    static size_type wordBits () { return sizeof (word_type) * CHAR_BIT; }
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the object with all bits unset.
+     * @param size the number of bits.
+     */
+    GF2Vector (size_type size = 0)
+      : bits (size),
+	words ((size + wordBits () - 1) / wordBits (), 0)
+    { }
+
+    /**
+     * Destroys the object.
+     */
+    ~GF2Vector () { }
+
+    // OPERATORS ------------------------------------------------------------
+
+    /**
+     * Tests whether the vectors are equal.
+     * @param right the vector to compare with.
+     * @return whether the vectors are equal.
+     */
+    bool operator== (const GF2Vector &right) const
+    {
+      return bits == right.bits && words == right.words;
+    }
+
+    /**
+     * Adds the right vector to this one.  The vectors must have the same
+     * size.
+     * @param right the vector to add.
+     * @return itself.
+     */
+    GF2Vector& operator^= (const GF2Vector &right);
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of bits.
+     * @return the size.
+     */
+    size_type size () const { return bits; }
+
+    /**
+     * Tests a bit.
+     * @param i the bit index.
+     * @return whether the bit is set.
+     */
+    bool test (size_type i) const
+    {
+      return 0 != (words[i / wordBits ()] & ((word_type) 1 << (i % wordBits ())));
+    }
+
+    /**
+     * Tests whether no bit is set.
+     * @return whether the vector is null.
+     */
+    bool none () const;
+
+    /**
+     * Finds the lowest index set.
+     * @return the index or npos if the vector is null.
+     */
+    size_type first () const { return firstOfUnion (*this); }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Sets a bit.
+     * @param i the bit index.
+     */
+    void set (size_type i)
+    {
+      words[i / wordBits ()] |= (word_type) 1 << (i % wordBits ());
+    }
+
+    /**
+     * Unsets all bits.
+     */
+    void reset ();
+
+    /**
+     * Finds the lowest index set in either this vector or the right one.
+     * The vectors must have the same size.
+     * @param right the other vector.
+     * @return the index or npos if both vectors are null.
+     */
+    size_type firstOfUnion (const GF2Vector &right) const;
+
+  };
+
+
+  /**
+   * @short Row echelon matrix over GF(2) for cycle elimination.
+   *
+   * The rows are kept ordered over their leading bit.  A candidate is
+   * reduced against the rows in order: it is independent as soon as its
+   * leading bit comes before the leading bit of the current row, it is
+   * added to the rows sharing its leading bit and the rows leading before
+   * it are skipped.  The candidate is dependent if it reduces to null.
+   * The rank of the matrix is its number of rows.
+   */
+  class GF2Matrix
+  {
+  public:
+
+    typedef vector< GF2Vector >::size_type size_type;
+
+  private:
+
+    /**
+     * The rows ordered over their leading bit.
+     */
+    vector< GF2Vector > rows;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the empty matrix.
+     */
+    GF2Matrix () { }
+
+    /**
+     * Destroys the object.
+     */
+    ~GF2Matrix () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of rows, which is the rank of the matrix.
+     * @return the number of rows.
+     */
+    size_type size () const { return rows.size (); }
+
+    /**
+     * Tells if the matrix has no row.
+     * @return whether the matrix is empty.
+     */
+    bool empty () const { return rows.empty (); }
+
+    /**
+     * Gets the leading bit of a row.
+     * @param pos the row position.
+     * @return the index of the lowest bit set in the row.
+     */
+    GF2Vector::size_type leading (size_type pos) const { return rows[pos].first (); }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Reduces the candidate against the rows.  The reduction stops at the
+     * first row whose leading bit comes after the candidate's.
+     * @param candidate the vector to reduce, modified in place.
+     * @return a pair whose first element tells if the candidate was
+     * reduced to null and whose second element is the position where
+     * the reduced candidate is to be inserted, or size () if it was
+     * reduced against every row.
+     */
+    pair< bool, size_type > reduce (GF2Vector &candidate) const;
+
+    /**
+     * Inserts a row at the given position.
+     * @param pos the position, as returned by reduce.
+     * @param row the reduced row.
+     */
+    void insert (size_type pos, const GF2Vector &row)
+    {
+      rows.insert (rows.begin () + pos, row);
+    }
+
+    /**
+     * Removes every row.
+     */
+    void clear () { rows.clear (); }
+
+  };
+
+}
+
+#endif
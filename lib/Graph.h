@@ -36,6 +36,7 @@
 
 #include "Algo.h"
 #include "Exception.h"
+#include "HashIndex.h"
 // #include "Path.h"
 
 using namespace std;
@@ -44,9 +45,33 @@ using namespace std;
 
 namespace mccore
 {
+  /**
+   * Identity of the graph vertices used by the hashed lookup.  Only
+   * pointer vertices have one, their address; other vertices are found
+   * with the vertex comparator.
+   */
+  template< class V >
+  struct VertexIdentity
+  {
+    static bool defined () { return false; }
+    static const void* key (const V &) { return 0; }
+  };
+
+  template< class V >
+  struct VertexIdentity< V* >
+  {
+    static bool defined () { return true; }
+    static const void* key (V* const &v) { return v; }
+  };
+
+
+
   /**
    * Abstract class for the graph classes.  Removing vertices or edges are
-   * costly.
+   * costly.  Each vertex keeps sorted lists of its in and out-neighbor
+   * labels so that neighborhoods are obtained in O(degree).  The vertex
+   * and endvertices maps can be doubled with hash tables (see
+   * setHashedLookup) to get constant time lookups.
    *
    * @author Martin Larose (<a href="larosem@iro.umontreal.ca">larosem@iro.umontreal.ca</a>)
    * @version $Id: Graph.h,v 1.30 2007-01-08 23:39:39 larosem Exp $
@@ -69,6 +94,7 @@ namespace mccore
     typedef typename vector< E >::const_iterator edge_const_iterator;
     typedef typename vector< E >::size_type edge_size_type;
     typedef typename vector< E >::size_type edge_label;
+    typedef typename vector< label >::const_iterator neighbor_const_iterator;
     
   public:
     
@@ -287,13 +313,44 @@ namespace mccore
      * The map between the endvertices and the associated edge label.
      */
     EV2ELabel ev2elabel;
+
+    /**
+     * The out-neighbor labels of each vertex label, sorted increasingly.
+     * It holds t in outAdjacency[h] for every endvertices (h, t) of
+     * ev2elabel.
+     */
+    vector< vector< label > > outAdjacency;
+
+    /**
+     * The in-neighbor labels of each vertex label, sorted increasingly.
+     * It holds h in inAdjacency[t] for every endvertices (h, t) of
+     * ev2elabel.
+     */
+    vector< vector< label > > inAdjacency;
+
+    /**
+     * Whether the lookups use the hash tables.
+     */
+    bool hashedLookup;
+
+    /**
+     * The hash table between the pointer vertices and their label, filled
+     * when hashedLookup is set.
+     */
+    HashIndex< const void*, label, PointerHash > v2vlabelHash;
+
+    /**
+     * The hash table between the endvertices labels and the associated
+     * edge label, filled when hashedLookup is set.
+     */
+    HashIndex< pair< label, label >, edge_label, PairHash > ev2elabelHash;
     
     // LIFECYCLE ------------------------------------------------------------
     
     /**
      * Initializes the object.
      */
-    Graph () { }
+    Graph () : hashedLookup (false) { }
 
   public:
     
@@ -331,6 +388,11 @@ namespace mccore
 	      v2vlabel.insert (make_pair (&vertices[l], l));
 	    }
 	  ev2elabel = right.ev2elabel;
+	  outAdjacency = right.outAdjacency;
+	  inAdjacency = right.inAdjacency;
+	  hashedLookup = right.hashedLookup;
+	  v2vlabelHash = right.v2vlabelHash;
+	  ev2elabelHash = right.ev2elabelHash;
 	}
       return *this;
     }
@@ -371,13 +433,13 @@ namespace mccore
      */
     VW& getVertexWeight (const V &v) throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+      if (! lookupVertex (v, l))
 	{
 	  throw NoSuchElementException ();
 	}
-      return vertexWeights[it->second];
+      return vertexWeights[l];
     }
       
     /**
@@ -389,13 +451,13 @@ namespace mccore
      */
     const VW& getVertexWeight (const V &v) const throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+      if (! lookupVertex (v, l))
 	{
 	  throw NoSuchElementException ();
 	}
-      return vertexWeights[it->second];
+      return vertexWeights[l];
     }
     
     /**
@@ -407,13 +469,13 @@ namespace mccore
      */
     void setVertexWeight (const V &v, const VW &w) throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator it;
-      
-      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+      label l;
+
+      if (! lookupVertex (v, l))
 	{
 	  throw NoSuchElementException ();
 	}
-      vertexWeights[it->second] = w;
+      vertexWeights[l] = w;
     }
       
     /**
@@ -426,21 +488,17 @@ namespace mccore
      */
     E& getEdge (const V &h, const V &t) throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-      typename EV2ELabel::const_iterator ite;
+      label hl;
+      label tl;
+      edge_label e;
 
-      if (v2vlabel.end () == (ith = v2vlabel.find (&h))
-	  || v2vlabel.end () == (itt = v2vlabel.find (&t)))
-	{
-	  throw NoSuchElementException ();
-	}
-      EndVertices ev (ith->second, itt->second);
-      if (ev2elabel.end () == (ite = ev2elabel.find (ev)))
+      if (! lookupVertex (h, hl)
+	  || ! lookupVertex (t, tl)
+	  || ! lookupEdge (hl, tl, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return edges[ite->second];
+      return edges[e];
     }
 
     /**
@@ -453,21 +511,17 @@ namespace mccore
      */
     const E& getEdge (const V &h, const V &t) const throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-      typename EV2ELabel::const_iterator ite;
+      label hl;
+      label tl;
+      edge_label e;
 
-      if (v2vlabel.end () == (ith = v2vlabel.find (&h))
-	  || v2vlabel.end () == (itt = v2vlabel.find (&t)))
+      if (! lookupVertex (h, hl)
+	  || ! lookupVertex (t, tl)
+	  || ! lookupEdge (hl, tl, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      EndVertices ev (ith->second, itt->second);
-      if (ev2elabel.end () == (ite = ev2elabel.find (ev)))
-	{
-	  throw NoSuchElementException ();
-	}
-      return edges[ite->second];
+      return edges[e];
     }
 
     /**
@@ -480,21 +534,17 @@ namespace mccore
      */
     EW& getEdgeWeight (const V &h, const V &t) throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-      typename EV2ELabel::const_iterator ite;
+      label hl;
+      label tl;
+      edge_label e;
 
-      if (v2vlabel.end () == (ith = v2vlabel.find (&h))
-	  || v2vlabel.end () == (itt = v2vlabel.find (&t)))
-	{
-	  throw NoSuchElementException ();
-	}
-      EndVertices ev (ith->second, itt->second);
-      if (ev2elabel.end () == (ite = ev2elabel.find (ev)))
+      if (! lookupVertex (h, hl)
+	  || ! lookupVertex (t, tl)
+	  || ! lookupEdge (hl, tl, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return edgeWeights[ite->second];
+      return edgeWeights[e];
     }
     
     /**
@@ -507,21 +557,17 @@ namespace mccore
      */
     const EW& getEdgeWeight (const V &h, const V &t) const throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-      typename EV2ELabel::const_iterator ite;
+      label hl;
+      label tl;
+      edge_label e;
 
-      if (v2vlabel.end () == (ith = v2vlabel.find (&h))
-	  || v2vlabel.end () == (itt = v2vlabel.find (&t)))
-	{
-	  throw NoSuchElementException ();
-	}
-      EndVertices ev (ith->second, itt->second);
-      if (ev2elabel.end () == (ite = ev2elabel.find (ev)))
+      if (! lookupVertex (h, hl)
+	  || ! lookupVertex (t, tl)
+	  || ! lookupEdge (hl, tl, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return edgeWeights[ite->second];
+      return edgeWeights[e];
     }
     
     /**
@@ -534,21 +580,17 @@ namespace mccore
      */
     void setEdgeWeight (const V &h, const V &t, const EW &w) throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-      typename EV2ELabel::const_iterator ite;
+      label hl;
+      label tl;
+      edge_label e;
 
-      if (v2vlabel.end () == (ith = v2vlabel.find (&h))
-	  || v2vlabel.end () == (itt = v2vlabel.find (&t)))
+      if (! lookupVertex (h, hl)
+	  || ! lookupVertex (t, tl)
+	  || ! lookupEdge (hl, tl, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      EndVertices ev (ith->second, itt->second);
-      if (ev2elabel.end () == (ite = ev2elabel.find (ev)))
-	{
-	  throw NoSuchElementException ();
-	}
-      edgeWeights[ite->second] = w;
+      edgeWeights[e] = w;
     }
     
     /**
@@ -560,13 +602,13 @@ namespace mccore
      */
     label getVertexLabel (const V &v) const throw (NoSuchElementException)
     {
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+      if (! lookupVertex (v, l))
 	{
 	  throw NoSuchElementException ();
 	}
-      return it->second;
+      return l;
     }
     
     /**
@@ -576,7 +618,9 @@ namespace mccore
      */
     bool contains (const V &v) const
     {
-      return v2vlabel.end () != v2vlabel.find (&v);
+      label l;
+
+      return lookupVertex (v, l);
     }
 
     /**
@@ -587,17 +631,13 @@ namespace mccore
      */
     bool areConnected (const V &h, const V &t) const
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-
-      if (v2vlabel.end () != (ith = v2vlabel.find (&h))
-	  && v2vlabel.end () != (itt = v2vlabel.find (&t)))
-	{
-	  EndVertices ev (ith->second, itt->second);
+      label hl;
+      label tl;
+      edge_label e;
 
-	  return ev2elabel.end () != ev2elabel.find (ev);
-	}
-      return false;
+      return (lookupVertex (h, hl)
+	      && lookupVertex (t, tl)
+	      && lookupEdge (hl, tl, e));
     }      
     
     /**
@@ -617,6 +657,52 @@ namespace mccore
      * @return the list of neighbors.
      */
     virtual list< label > internalNeighborhood (label l) const = 0;
+
+    /**
+     * Gets the increasing out-neighbor labels of the given vertex label
+     * without copying them.  The returned vector is invalidated by any
+     * modification of the graph.  An empty vector is returned if the label
+     * is not contained in the graph.
+     * @param l the vertex label.
+     * @return the out-neighbor labels.
+     */
+    const vector< label >& internalOutAdjacency (label l) const
+    {
+      return (outAdjacency.size () > l ? outAdjacency[l] : emptyAdjacency ());
+    }
+
+    /**
+     * Gets the increasing in-neighbor labels of the given vertex label
+     * without copying them.  The returned vector is invalidated by any
+     * modification of the graph.  An empty vector is returned if the label
+     * is not contained in the graph.
+     * @param l the vertex label.
+     * @return the in-neighbor labels.
+     */
+    const vector< label >& internalInAdjacency (label l) const
+    {
+      return (inAdjacency.size () > l ? inAdjacency[l] : emptyAdjacency ());
+    }
+
+    /**
+     * Gets the number of out-neighbors of the given vertex label.
+     * @param l the vertex label.
+     * @return the out-degree, 0 if the label is not in the graph.
+     */
+    size_type internalOutDegree (label l) const
+    {
+      return internalOutAdjacency (l).size ();
+    }
+
+    /**
+     * Gets the number of in-neighbors of the given vertex label.
+     * @param l the vertex label.
+     * @return the in-degree, 0 if the label is not in the graph.
+     */
+    size_type internalInDegree (label l) const
+    {
+      return internalInAdjacency (l).size ();
+    }
     
     /**
      * Gets a vertex given its label.
@@ -740,16 +826,15 @@ namespace mccore
      */
     const E& internalGetEdge (label h, label t) const throw (NoSuchElementException)
     {
-      typename EV2ELabel::const_iterator evit;
-      EndVertices ev (h, t);
-      
+      edge_label e;
+
       if (vertices.size () <= h
 	  || vertices.size () <= t
-	  || ev2elabel.end () == (evit = ev2elabel.find (ev)))
+	  || ! lookupEdge (h, t, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return edges[evit->second];
+      return edges[e];
     }
     
     /**
@@ -762,16 +847,15 @@ namespace mccore
      */
     edge_label internalGetEdgeLabel (label h, label t) const throw (NoSuchElementException)
     {
-      typename EV2ELabel::const_iterator evit;
-      EndVertices ev (h, t);
-      
+      edge_label e;
+
       if (vertices.size () <= h
 	  || vertices.size () <= t
-	  || ev2elabel.end () == (evit = ev2elabel.find (ev)))
+	  || ! lookupEdge (h, t, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return evit->second;
+      return e;
     }
     
     /**
@@ -784,16 +868,15 @@ namespace mccore
      */
     EW& internalGetEdgeWeight (label h, label t) throw (NoSuchElementException)
     {
-      typename EV2ELabel::iterator evit;
-      EndVertices ev (h, t);
-      
+      edge_label e;
+
       if (vertices.size () <= h
 	  || vertices.size () <= t
-	  || ev2elabel.end () == (evit = ev2elabel.find (ev)))
+	  || ! lookupEdge (h, t, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return edgeWeights[evit->second];
+      return edgeWeights[e];
     }
     
     /**
@@ -806,16 +889,15 @@ namespace mccore
      */
     const EW& internalGetEdgeWeight (label h, label t) const throw (NoSuchElementException)
     {
-      typename EV2ELabel::const_iterator evit;
-      EndVertices ev (h, t);
-      
+      edge_label e;
+
       if (vertices.size () <= h
 	  || vertices.size () <= t
-	  || ev2elabel.end () == (evit = ev2elabel.find (ev)))
+	  || ! lookupEdge (h, t, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      return edgeWeights[evit->second];
+      return edgeWeights[e];
     }
     
     /**
@@ -860,16 +942,15 @@ namespace mccore
      */
     void internalSetEdgeWeight (label h, label t, const EW w) throw (NoSuchElementException)
     {
-      typename EV2ELabel::iterator evit;
-      EndVertices ev (h, t);
-      
+      edge_label e;
+
       if (vertices.size () <= h
 	  || vertices.size () <= t
-	  || ev2elabel.end () == (evit = ev2elabel.find (ev)))
+	  || ! lookupEdge (h, t, e))
 	{
 	  throw NoSuchElementException ();
 	}
-      edgeWeights[evit->second] = w;
+      edgeWeights[e] = w;
     }
     
     /**
@@ -893,9 +974,9 @@ namespace mccore
       if (vertices.size () > h
 	  && vertices.size () > t)
 	{
-	  EndVertices ev (h, t);
+	  const vector< label > &out = outAdjacency[h];
 
-	  return ev2elabel.end () != ev2elabel.find (ev);
+	  return std::binary_search (out.begin (), out.end (), t);
 	}
       return false;
     }
@@ -964,6 +1045,355 @@ namespace mccore
 	{
 	  v2vlabel.insert (make_pair (&*it, it - vertices.begin ()));
 	}
+      if (hashedLookup && VertexIdentity< V >::defined ())
+	{
+	  v2vlabelHash.clear ();
+	  v2vlabelHash.reserve (vertices.size ());
+	  for (it = vertices.begin (); vertices.end () != it; ++it)
+	    {
+	      v2vlabelHash.insert (VertexIdentity< V >::key (*it), it - vertices.begin ());
+	    }
+	}
+    }
+
+    /**
+     * Indexes the vertex appended at the end of vertices.  The vertex map
+     * is keyed on the vertex addresses, so it is rebuilt only if the
+     * append moved the vertices.  The hash table is keyed on the vertex
+     * values and receives the new vertex only.
+     * @param data the address of the first vertex before the append, null
+     * if there was none.
+     */
+    void appendV2VLabel (const V *data)
+    {
+      label l = vertices.size () - 1;
+
+      if (0 != data && &vertices.front () == data)
+	{
+	  v2vlabel.insert (make_pair (&vertices.back (), l));
+	}
+      else
+	{
+	  typename vector< V >::iterator it;
+
+	  v2vlabel.clear ();
+	  for (it = vertices.begin (); vertices.end () != it; ++it)
+	    {
+	      v2vlabel.insert (make_pair (&*it, it - vertices.begin ()));
+	    }
+	}
+      if (hashedLookup && VertexIdentity< V >::defined ())
+	{
+	  v2vlabelHash.insert (VertexIdentity< V >::key (vertices.back ()), l);
+	}
+    }
+
+    /**
+     * Gets an empty adjacency vector, returned for invalid labels.
+     * @return the empty vector.
+     */
+    static const vector< label >& emptyAdjacency ()
+    {
+      static const vector< label > empty;
+
+      return empty;
+    }
+
+    /**
+     * Rebuilds the endvertices hash table from the endvertices map.
+     */
+    void rebuildEdgeHash ()
+    {
+      typename EV2ELabel::const_iterator evit;
+
+      if (hashedLookup)
+	{
+	  ev2elabelHash.clear ();
+	  ev2elabelHash.reserve (ev2elabel.size ());
+	  for (evit = ev2elabel.begin (); ev2elabel.end () != evit; ++evit)
+	    {
+	      ev2elabelHash.insert (make_pair (evit->first.getHeadLabel (), evit->first.getTailLabel ()),
+				    evit->second);
+	    }
+	}
+    }
+
+    /**
+     * Finds the label of a vertex.  Pointer vertices are first looked up
+     * by address in the hash table when it is used.
+     * @param v the vertex.
+     * @param l the label to set.
+     * @return whether the graph contains the vertex.
+     */
+    bool lookupVertex (const V &v, label &l) const
+    {
+      typename V2VLabel::const_iterator it;
+
+      if (hashedLookup && VertexIdentity< V >::defined ())
+	{
+	  const label *found = v2vlabelHash.find (VertexIdentity< V >::key (v));
+
+	  if (0 != found)
+	    {
+	      l = *found;
+	      return true;
+	    }
+	}
+      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+	{
+	  return false;
+	}
+      l = it->second;
+      return true;
+    }
+
+    /**
+     * Finds the edge label between endvertices labels.  No check are made
+     * on vertex labels validity.
+     * @param h the head label of the edge.
+     * @param t the tail label of the edge.
+     * @param e the edge label to set.
+     * @return whether the vertices are connected.
+     */
+    bool lookupEdge (label h, label t, edge_label &e) const
+    {
+      typename EV2ELabel::const_iterator evit;
+
+      if (hashedLookup)
+	{
+	  const edge_label *found = ev2elabelHash.find (make_pair (h, t));
+
+	  if (0 == found)
+	    {
+	      return false;
+	    }
+	  e = *found;
+	  return true;
+	}
+      if (ev2elabel.end () == (evit = ev2elabel.find (EndVertices (h, t))))
+	{
+	  return false;
+	}
+      e = evit->second;
+      return true;
+    }
+
+    /**
+     * Adds the endvertices (h, t) to the adjacency lists and to the
+     * endvertices hash table.  No check are made on vertex labels validity.
+     * @param h the head vertex label.
+     * @param t the tail vertex label.
+     * @param e the edge label.
+     */
+    void adjacencyInsert (label h, label t, edge_label e)
+    {
+      vector< label > &out = outAdjacency[h];
+      vector< label > &in = inAdjacency[t];
+
+      out.insert (std::lower_bound (out.begin (), out.end (), t), t);
+      in.insert (std::lower_bound (in.begin (), in.end (), h), h);
+      if (hashedLookup)
+	{
+	  ev2elabelHash.insert (make_pair (h, t), e);
+	}
+    }
+
+    /**
+     * Removes the endvertices (h, t) from the adjacency lists and from the
+     * endvertices hash table.  No check are made on vertex labels
+     * validity.
+     * @param h the head vertex label.
+     * @param t the tail vertex label.
+     */
+    void adjacencyErase (label h, label t)
+    {
+      vector< label > &out = outAdjacency[h];
+      vector< label > &in = inAdjacency[t];
+      typename vector< label >::iterator it;
+
+      if (out.end () != (it = std::lower_bound (out.begin (), out.end (), t))
+	  && t == *it)
+	{
+	  out.erase (it);
+	}
+      if (in.end () != (it = std::lower_bound (in.begin (), in.end (), h))
+	  && h == *it)
+	{
+	  in.erase (it);
+	}
+      if (hashedLookup)
+	{
+	  ev2elabelHash.erase (make_pair (h, t));
+	}
+    }
+
+    /**
+     * Rebuilds the adjacency lists and the endvertices hash table from the
+     * endvertices map.  Since the map is ordered over the head then the
+     * tail label, the lists are filled in increasing order.
+     */
+    void rebuildAdjacency ()
+    {
+      typename EV2ELabel::const_iterator evit;
+      typename vector< vector< label > >::iterator it;
+
+      outAdjacency.resize (vertices.size ());
+      inAdjacency.resize (vertices.size ());
+      for (it = outAdjacency.begin (); outAdjacency.end () != it; ++it)
+	{
+	  it->clear ();
+	}
+      for (it = inAdjacency.begin (); inAdjacency.end () != it; ++it)
+	{
+	  it->clear ();
+	}
+      for (evit = ev2elabel.begin (); ev2elabel.end () != evit; ++evit)
+	{
+	  outAdjacency[evit->first.getHeadLabel ()].push_back (evit->first.getTailLabel ());
+	  inAdjacency[evit->first.getTailLabel ()].push_back (evit->first.getHeadLabel ());
+	}
+      rebuildEdgeHash ();
+    }
+
+    /**
+     * Erases the marked vertex labels and the edges connected to them.
+     * The vertices, the edges and both label maps are compacted in a
+     * single pass and the remaining labels keep their relative order, so
+     * the cost is linear in the size of the graph whatever the number of
+     * erased vertices.  The erased vertices and edges are not destroyed.
+     * @param marks the flags of the labels to erase, one per vertex.
+     * @return the number of erased vertices.
+     */
+    size_type uncheckedInternalEraseMarked (const vector< bool > &marks)
+    {
+      const label nolabel = vertices.size ();
+      const edge_label noedge = edges.size ();
+      vector< label > newLabels (vertices.size (), nolabel);
+      vector< edge_label > newEdgeLabels (edges.size (), noedge);
+      typename EV2ELabel::const_iterator evit;
+      EV2ELabel newEV2;
+      label l;
+      label n;
+      edge_label e;
+      edge_label m;
+
+      for (l = 0, n = 0; vertices.size () > l; ++l)
+	{
+	  if (! marks[l])
+	    {
+	      if (n != l)
+		{
+		  vertices[n] = vertices[l];
+		  vertexWeights[n] = vertexWeights[l];
+		}
+	      newLabels[l] = n++;
+	    }
+	}
+      if (vertices.size () == n)
+	{
+	  return 0;
+	}
+      vertices.erase (vertices.begin () + n, vertices.end ());
+      vertexWeights.erase (vertexWeights.begin () + n, vertexWeights.end ());
+
+      for (evit = ev2elabel.begin (); ev2elabel.end () != evit; ++evit)
+	{
+	  if (nolabel != newLabels[evit->first.getHeadLabel ()]
+	      && nolabel != newLabels[evit->first.getTailLabel ()])
+	    {
+	      newEdgeLabels[evit->second] = 0;
+	    }
+	}
+      for (e = 0, m = 0; edges.size () > e; ++e)
+	{
+	  if (noedge != newEdgeLabels[e])
+	    {
+	      if (m != e)
+		{
+		  edges[m] = edges[e];
+		  edgeWeights[m] = edgeWeights[e];
+		}
+	      newEdgeLabels[e] = m++;
+	    }
+	}
+      edges.erase (edges.begin () + m, edges.end ());
+      edgeWeights.erase (edgeWeights.begin () + m, edgeWeights.end ());
+
+      // The relabeling is increasing so the map order is kept.
+      for (evit = ev2elabel.begin (); ev2elabel.end () != evit; ++evit)
+	{
+	  if (noedge != newEdgeLabels[evit->second])
+	    {
+	      EndVertices ev (newLabels[evit->first.getHeadLabel ()],
+			      newLabels[evit->first.getTailLabel ()]);
+
+	      newEV2.insert (newEV2.end (), make_pair (ev, newEdgeLabels[evit->second]));
+	    }
+	}
+      ev2elabel.swap (newEV2);
+      rebuildV2VLabel ();
+      rebuildAdjacency ();
+      return nolabel - n;
+    }
+
+    /**
+     * Erases the edges connected to the marked vertex labels.  The edges
+     * and the edge label map are compacted in a single pass, the vertices
+     * and the remaining edges keep their labels order.  The erased edges
+     * are not destroyed.
+     * @param marks the flags of the vertex labels to disconnect, one per
+     * vertex.
+     * @return the number of erased edges.
+     */
+    size_type uncheckedInternalDisconnectMarked (const vector< bool > &marks)
+    {
+      const edge_label noedge = edges.size ();
+      vector< edge_label > newEdgeLabels (edges.size (), 0);
+      typename EV2ELabel::iterator evit;
+      edge_label e;
+      edge_label m;
+
+      for (evit = ev2elabel.begin (); ev2elabel.end () != evit; ++evit)
+	{
+	  if (marks[evit->first.getHeadLabel ()]
+	      || marks[evit->first.getTailLabel ()])
+	    {
+	      newEdgeLabels[evit->second] = noedge;
+	    }
+	}
+      for (e = 0, m = 0; edges.size () > e; ++e)
+	{
+	  if (noedge != newEdgeLabels[e])
+	    {
+	      if (m != e)
+		{
+		  edges[m] = edges[e];
+		  edgeWeights[m] = edgeWeights[e];
+		}
+	      newEdgeLabels[e] = m++;
+	    }
+	}
+      if (edges.size () == m)
+	{
+	  return 0;
+	}
+      edges.erase (edges.begin () + m, edges.end ());
+      edgeWeights.erase (edgeWeights.begin () + m, edgeWeights.end ());
+
+      for (evit = ev2elabel.begin (); ev2elabel.end () != evit; )
+	{
+	  if (noedge == newEdgeLabels[evit->second])
+	    {
+	      ev2elabel.erase (evit++);
+	    }
+	  else
+	    {
+	      evit->second = newEdgeLabels[evit->second];
+	      ++evit;
+	    }
+	}
+      rebuildAdjacency ();
+      return noedge - m;
     }
 
   public:
@@ -975,13 +1405,17 @@ namespace mccore
      */
     virtual bool insert (const V &v)
     {
-      typename V2VLabel::iterator it;
+      label l;
 
-      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+      if (! lookupVertex (v, l))
 	{
+	  const V *data = vertices.empty () ? 0 : &vertices.front ();
+
 	  vertices.push_back (v);
 	  vertexWeights.resize (vertexWeights.size () + 1);
-	  rebuildV2VLabel ();
+	  outAdjacency.resize (vertices.size ());
+	  inAdjacency.resize (vertices.size ());
+	  appendV2VLabel (data);
 	  return true;
 	}
       return false;
@@ -995,13 +1429,17 @@ namespace mccore
      */
     virtual bool insert (const V &v, const VW &w)
     {
-      typename V2VLabel::iterator it;
+      label l;
 
-      if (v2vlabel.end () == (it = v2vlabel.find (&v)))
+      if (! lookupVertex (v, l))
 	{
+	  const V *data = vertices.empty () ? 0 : &vertices.front ();
+
 	  vertices.push_back (v);
 	  vertexWeights.push_back (w);
-	  rebuildV2VLabel ();
+	  outAdjacency.resize (vertices.size ());
+	  inAdjacency.resize (vertices.size ());
+	  appendV2VLabel (data);
 	  return true;
 	}
       return false;
@@ -1023,6 +1461,8 @@ namespace mccore
 	    }
 	}
       vertexWeights.resize (vertices.size ());
+      outAdjacency.resize (vertices.size ());
+      inAdjacency.resize (vertices.size ());
       rebuildV2VLabel ();
     }
 
@@ -1046,10 +1486,10 @@ namespace mccore
      */
     iterator erase (const V &v)
     {
-      typename V2VLabel::iterator it;
-      
-      return (v2vlabel.end () != (it = v2vlabel.find (&v))
-	      ? uncheckedInternalErase (it->second)
+      label l;
+
+      return (lookupVertex (v, l)
+	      ? uncheckedInternalErase (l)
 	      : vertices.end ());
     }
     
@@ -1066,6 +1506,48 @@ namespace mccore
 	      : vertices.end ());
     }
     
+    /**
+     * Erases a range of vertex labels from the graph with the edges
+     * connected to them, in a single pass over the graph.  Invalid labels
+     * are ignored.
+     * @param f the iterator on the first label.
+     * @param l the iterator past the last label.
+     * @return the number of erased vertices.
+     */
+    template< class InputIterator >
+    size_type internalErase (InputIterator f, InputIterator l)
+    {
+      vector< bool > marks (vertices.size (), false);
+
+      for (; l != f; ++f)
+	{
+	  if (vertices.size () > (label) *f)
+	    {
+	      marks[*f] = true;
+	    }
+	}
+      return uncheckedInternalEraseMarked (marks);
+    }
+
+    /**
+     * Erases the vertices satisfying a predicate with the edges connected
+     * to them, in a single pass over the graph.
+     * @param pred the unary predicate on the vertices.
+     * @return the number of erased vertices.
+     */
+    template< class Predicate >
+    size_type eraseIf (Predicate pred)
+    {
+      vector< bool > marks (vertices.size (), false);
+      label l;
+
+      for (l = 0; vertices.size () > l; ++l)
+	{
+	  marks[l] = pred (vertices[l]);
+	}
+      return uncheckedInternalEraseMarked (marks);
+    }
+    
     /**
      * Finds a vertex in the graph.
      * @param v the vertex to find.
@@ -1073,11 +1555,11 @@ namespace mccore
      */
     iterator find (const V &v)
     {
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      return (v2vlabel.end () == (it = v2vlabel.find (&v))
+      return (! lookupVertex (v, l)
 	      ? vertices.end ()
-	      : vertices.begin () + it->second);
+	      : vertices.begin () + l);
     }
 
     /**
@@ -1087,11 +1569,11 @@ namespace mccore
      */
     const_iterator find (const V &v) const
     {
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      return (v2vlabel.end () == (it = v2vlabel.find (&v))
+      return (! lookupVertex (v, l)
 	      ? vertices.end ()
-	      : vertices.begin () + it->second);
+	      : vertices.begin () + l);
     }
 
     /**
@@ -1123,6 +1605,42 @@ namespace mccore
       edgeWeights.clear ();
       v2vlabel.clear ();
       ev2elabel.clear ();
+      outAdjacency.clear ();
+      inAdjacency.clear ();
+      v2vlabelHash.clear ();
+      ev2elabelHash.clear ();
+    }
+
+    /**
+     * Tells if the lookups use the hash tables.
+     * @return whether the hashed lookup is set.
+     */
+    bool isHashedLookup () const { return hashedLookup; }
+
+    /**
+     * Sets whether the vertex and endvertices lookups use hash tables.
+     * When set, the edges are found in constant time from their
+     * endvertices labels and pointer vertices are found by address before
+     * falling back on the vertex comparator.  The tables are updated with
+     * the graph, which costs memory and some time on modifications.
+     * @param hashed whether to use the hash tables.
+     */
+    void setHashedLookup (bool hashed)
+    {
+      if (hashed != hashedLookup)
+	{
+	  hashedLookup = hashed;
+	  if (hashed)
+	    {
+	      rebuildV2VLabel ();
+	      rebuildEdgeHash ();
+	    }
+	  else
+	    {
+	      v2vlabelHash.clear ();
+	      ev2elabelHash.clear ();
+	    }
+	}
     }
 
   protected:
@@ -1159,12 +1677,12 @@ namespace mccore
      */
     virtual bool connect (const V &h, const V &t, const E &e)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
+      label hl;
+      label tl;
 
-      return (v2vlabel.end () != (ith = v2vlabel.find (&h))
-	      && v2vlabel.end () != (itt = v2vlabel.find (&t))
-	      ? uncheckedInternalConnect (ith->second, itt->second, e)
+      return (lookupVertex (h, hl)
+	      && lookupVertex (t, tl)
+	      ? uncheckedInternalConnect (hl, tl, e)
 	      : false);
     }      
     
@@ -1178,12 +1696,12 @@ namespace mccore
      */
     virtual bool connect (const V &h, const V &t, const E &e, const EW &w)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
-      
-      return (v2vlabel.end () != (ith = v2vlabel.find (&h))
-	      && v2vlabel.end () != (itt = v2vlabel.find (&t))
-	      ? uncheckedInternalConnect (ith->second, itt->second, e, w)
+      label hl;
+      label tl;
+
+      return (lookupVertex (h, hl)
+	      && lookupVertex (t, tl)
+	      ? uncheckedInternalConnect (hl, tl, e, w)
 	      : false);
     }
     
@@ -1237,12 +1755,12 @@ namespace mccore
      */
     bool disconnect (const V &t, const V &h)
     {
-      typename V2VLabel::const_iterator ith;
-      typename V2VLabel::const_iterator itt;
+      label hl;
+      label tl;
 
-      return (v2vlabel.end () != (ith = v2vlabel.find (&h))
-	      && v2vlabel.end () != (itt = v2vlabel.find (&t))
-	      ? uncheckedInternalDisconnect (ith->second, itt->second)
+      return (lookupVertex (h, hl)
+	      && lookupVertex (t, tl)
+	      ? uncheckedInternalDisconnect (hl, tl)
 	      : false);
     }
     
@@ -36,8 +36,12 @@
 #include <utility>
 #include <vector>
 
+#include "Arena.h"
 #include "Binstream.h"
 #include "GraphModel.h"
+#include "GraphModelView.h"
+#include "HBondSites.h"
+#include "InvertedRelation.h"
 #include "Messagestream.h"
 #include "ModelFactoryMethod.h"
 #include "Molecule.h"
@@ -119,10 +123,14 @@ namespace mccore
 
   GraphModel::GraphModel (const AbstractModel &right, const ResidueFactoryMethod *fm)
     : AbstractModel (fm),
-      annotated (false)
+      annotated (false),
+      annotationCache (0),
+      threadPool (0),
+      sharedRelations (false)
   {
     const GraphModel *model;
 
+    setHashedLookup (true);
     if (0 == (model = dynamic_cast< const GraphModel* > (&right)))
       {
 	AbstractModel::insert (right.begin (), right.end ());
@@ -130,6 +138,9 @@ namespace mccore
     else
       {
 	annotated = model->annotated;
+	annotationCache = model->annotationCache;
+	threadPool = model->threadPool;
+	sharedRelations = model->sharedRelations;
 	deepCopy (*model);
       }
   }
@@ -137,8 +148,12 @@ namespace mccore
 
   GraphModel::GraphModel (const GraphModel &right, const ResidueFactoryMethod *fm)
     : AbstractModel (fm),
-      annotated (right.annotated)
+      annotated (right.annotated),
+      annotationCache (right.annotationCache),
+      threadPool (right.threadPool),
+      sharedRelations (right.sharedRelations)
   {
+    setHashedLookup (true);
     deepCopy (right);
   }
 
@@ -165,6 +180,8 @@ namespace mccore
     vector< Residue* >::const_iterator resIt;
     vector< Relation* >::const_iterator relIt;
     set< const Residue*, less_deref< Residue > > resSet;
+    map< const Relation*, const Relation* > copies;
+    Arena::Scope scope (residueFM->getArena ());
 
     for (resIt = right.vertices.begin (); right.vertices.end () != resIt; ++resIt)
       {
@@ -175,12 +192,26 @@ namespace mccore
       }
     for (relIt = right.edges.begin (); right.edges.end () != relIt; ++relIt)
       {
+	const InvertedRelation *view;
+	map< const Relation*, const Relation* >::const_iterator cIt;
 	Relation *rel;
 
-	rel = (*relIt)->clone ();
-	rel->reassignResiduePointers (resSet);
+	// A view is rebuilt over the copy of its forward relation, which is
+	// connected first.
+	if (0 != (view = dynamic_cast< const InvertedRelation* > (*relIt))
+	    && copies.end () != (cIt = copies.find (view->getForward ())))
+	  {
+	    rel = new InvertedRelation (cIt->second);
+	  }
+	else
+	  {
+	    rel = (*relIt)->clone ();
+	    rel->reassignResiduePointers (resSet);
+	    copies.insert (make_pair (*relIt, rel));
+	  }
 	graphsuper::connect (const_cast< Residue* > (rel->getRef ()), const_cast < Residue* > (rel->getRes ()), rel, 0);
       }
+    reindex ();
   }
   
   
@@ -215,6 +246,9 @@ namespace mccore
 	clear ();
 	AbstractModel::operator= (right);
 	annotated = right.annotated;
+	annotationCache = right.annotationCache;
+	threadPool = right.threadPool;
+	sharedRelations = right.sharedRelations;
 	deepCopy (right);
       }
     return *this;
@@ -232,7 +266,10 @@ namespace mccore
 	erase (found);
       }
     r = residueFM->createResidue (res);
-    graphsuper::insert (r, w);
+    if (graphsuper::insert (r, w))
+      {
+	residIndex.insert (r->getResId (), graphsuper::size () - 1);
+      }
     annotated = false;
     return graphsuper::find (r);
   }
@@ -242,7 +279,10 @@ namespace mccore
   GraphModel::erase (AbstractModel::iterator pos) 
   {
     Residue *res = &*pos;
-    iterator ret (graphsuper::erase (&*pos));
+    iterator ret;
+
+    residIndex.erase (res->getResId (), pos - begin ());
+    ret = graphsuper::erase (&*pos);
 
     delete res;
     return ret;
@@ -261,7 +301,7 @@ namespace mccore
  	EV2ELabel sortedEdgeMap;
 	EV2ELabel::iterator evIt;
 
-	std::sort (sortedv.begin (), sortedv.end (), less_deref< Residue > ());
+	Algo::radixSortByResId (sortedv);
 	corresp = new graphsuper::size_type[vertices.size ()];
 	for (vIndex = 0; vIndex < sortedv.size (); ++vIndex)
 	  {
@@ -282,11 +322,54 @@ namespace mccore
 	vertices = sortedv;
 	rebuildV2VLabel ();
 	ev2elabel = sortedEdgeMap;
+	rebuildAdjacency ();
 	delete[] corresp;
+	reindex ();
       }
   }
   
     
+  void
+  GraphModel::eraseMarked (const vector< bool > &marks)
+  {
+    vector< Residue* > erasedv;
+    vector< Relation* > erasede;
+    vector< Residue* >::iterator vIt;
+    vector< Relation* >::iterator eIt;
+    EV2ELabel::const_iterator evIt;
+    graphsuper::size_type vIndex;
+
+    for (vIndex = 0; vIndex < vertices.size (); ++vIndex)
+      {
+	if (marks[vIndex])
+	  {
+	    erasedv.push_back (vertices[vIndex]);
+	  }
+      }
+    if (! erasedv.empty ())
+      {
+	for (evIt = ev2elabel.begin (); ev2elabel.end () != evIt; ++evIt)
+	  {
+	    if (marks[evIt->first.getHeadLabel ()]
+		|| marks[evIt->first.getTailLabel ()])
+	      {
+		erasede.push_back (edges[evIt->second]);
+	      }
+	  }
+	uncheckedInternalEraseMarked (marks);
+	for (vIt = erasedv.begin (); erasedv.end () != vIt; ++vIt)
+	  {
+	    delete *vIt;
+	  }
+	for (eIt = erasede.begin (); erasede.end () != eIt; ++eIt)
+	  {
+	    delete *eIt;
+	  }
+	reindex ();
+      }
+  }
+
+    
   void
   GraphModel::removeAminoAcid ()
   {
@@ -329,6 +412,35 @@ namespace mccore
   }
 
 
+  void
+  GraphModel::removeWater ()
+  {
+    const ResidueType *water = ResidueType::parseType ("HOH");
+    vector< bool > marks (size (), false);
+    graphsuper::size_type vIndex;
+
+    for (vIndex = 0; vIndex < marks.size (); ++vIndex)
+      {
+	marks[vIndex] = vertices[vIndex]->getType () == water;
+      }
+    eraseMarked (marks);
+  }
+
+
+  void
+  GraphModel::keep (const ResidueType* rtype)
+  {
+    vector< bool > marks (size (), false);
+    graphsuper::size_type vIndex;
+
+    for (vIndex = 0; vIndex < marks.size (); ++vIndex)
+      {
+	marks[vIndex] = ! vertices[vIndex]->getType ()->is (rtype);
+      }
+    eraseMarked (marks);
+  }
+
+
   void
   GraphModel::clear ()
   {
@@ -344,6 +456,7 @@ namespace mccore
 	delete *eIt;
       }
     graphsuper::clear ();
+    residIndex.clear ();
     annotated = false;
   }
 
@@ -355,9 +468,10 @@ namespace mccore
       {
 	vector< Relation* >::iterator eIt;
 	vector< pair< AbstractModel::iterator, AbstractModel::iterator > > contacts;
-	vector< pair< AbstractModel::iterator, AbstractModel::iterator > >::iterator l;
 // 	time_t t;
 	RDATypeFilter< iterator > filter;
+	vector< HBondSites > sites;
+	Arena::Scope scope (residueFM->getArena ());
 
 	for (eIt = edges.begin (); edges.end () != eIt; ++eIt)
 	  {
@@ -365,9 +479,30 @@ namespace mccore
 	  }
 	edges.clear ();
 	ev2elabel.clear ();
+	rebuildAdjacency ();
 	edgeWeights.clear ();
 
-	addHLP ();
+	// The fast screening calls the base pairs without hydrogens nor lone
+	// pairs.
+	if (0 == (aspb & Relation::fast_mask))
+	  {
+	    addHLP ();
+	  }
+
+	// The hydrogen bond sites are computed once per residue for all its
+	// contacts.
+	sites.resize (size ());
+	if (0 != (aspb & Relation::bhbond_mask)
+	    || (0 != (aspb & Relation::pairing_mask)
+		&& 0 == (aspb & Relation::fast_mask)))
+	  {
+	    iterator it;
+
+	    for (it = begin (); end () != it; ++it)
+	      {
+		sites[getVertexLabel (&*it)].build (&*it);
+	      }
+	  }
 	
 // 	time (&t);
 	Algo::extractContacts (contacts, begin (), end (), filter, 3.0);
@@ -375,28 +510,137 @@ namespace mccore
 	gErr (3) << "Found " << contacts.size () << " possible contacts " << endl;
   
 // 	time (&t);
-	for (l = contacts.begin (); contacts.end () != l; ++l)
+	annotateContacts (contacts, sites, aspb);
+// 	gOut (0) << "Annotation " << time (0) - t << "s" << endl;
+	annotated = true;
+      }
+  }
+
+
+  void
+  GraphModel::reannotate (const vector< label > &changed, unsigned char aspb)
+  {
+    if (! annotated)
+      {
+	annotate (aspb);
+      }
+    else
+      {
+	vector< bool > marks (size (), false);
+	vector< Relation* > erased;
+	vector< Relation* >::iterator eIt;
+	vector< AbstractModel::iterator > some;
+	vector< pair< AbstractModel::iterator, AbstractModel::iterator > > contacts;
+	vector< pair< AbstractModel::iterator, AbstractModel::iterator > >::iterator l;
+	vector< label >::const_iterator cIt;
+	EV2ELabel::const_iterator evIt;
+	RDATypeFilter< iterator > filter;
+	vector< HBondSites > sites;
+	Arena::Scope scope (residueFM->getArena ());
+
+	for (cIt = changed.begin (); changed.end () != cIt; ++cIt)
 	  {
-	    Residue *i = &*l->first;
-	    Residue *j = &*l->second;
-	    Relation *rel = new Relation (i, j);
+	    if (marks.size () > *cIt && ! marks[*cIt])
+	      {
+		marks[*cIt] = true;
+		some.push_back (iterator (vertices.begin () + *cIt));
+	      }
+	  }
+	if (some.empty ())
+	  {
+	    return;
+	  }
 
-	    if (rel->annotate (aspb))
+	for (evIt = ev2elabel.begin (); ev2elabel.end () != evIt; ++evIt)
+	  {
+	    if (marks[evIt->first.getHeadLabel ()]
+		|| marks[evIt->first.getTailLabel ()])
 	      {
-		Relation *inv;
+		erased.push_back (edges[evIt->second]);
+	      }
+	  }
+	uncheckedInternalDisconnectMarked (marks);
+	for (eIt = erased.begin (); erased.end () != eIt; ++eIt)
+	  {
+	    delete *eIt;
+	  }
 
-		inv = rel->clone ();
-		inv->invert ();
-		connect (i, j, rel, 0);
-		connect (j, i, inv, 0);
+	if (0 == (aspb & Relation::fast_mask))
+	  {
+	    vector< AbstractModel::iterator >::iterator it;
+
+	    for (it = some.begin (); some.end () != it; ++it)
+	      {
+		(*it)->addHydrogens ();
+		(*it)->addLonePairs ();
+	      }
+	  }
+
+	Algo::extractContacts (contacts, some, begin (), end (), filter, 3.0);
+	gErr (3) << "Found " << contacts.size () << " possible contacts " << endl;
+
+	// Only the sites of the contact residues are computed.
+	sites.resize (size ());
+	if (0 != (aspb & Relation::bhbond_mask)
+	    || (0 != (aspb & Relation::pairing_mask)
+		&& 0 == (aspb & Relation::fast_mask)))
+	  {
+	    for (l = contacts.begin (); contacts.end () != l; ++l)
+	      {
+		HBondSites &first = sites[getVertexLabel (&*l->first)];
+		HBondSites &second = sites[getVertexLabel (&*l->second)];
+
+		if (0 == first.getResidue ())
+		  {
+		    first.build (&*l->first);
+		  }
+		if (0 == second.getResidue ())
+		  {
+		    second.build (&*l->second);
+		  }
+	      }
+	  }
+
+	annotateContacts (contacts, sites, aspb);
+      }
+  }
+
+
+  void
+  GraphModel::annotateContacts (const vector< pair< iterator, iterator > > &contacts, const vector< HBondSites > &sites, unsigned char aspb)
+  {
+    vector< pair< iterator, iterator > >::const_iterator l;
+
+    for (l = contacts.begin (); contacts.end () != l; ++l)
+      {
+	Residue *i = &*l->first;
+	Residue *j = &*l->second;
+	Relation *rel = new Relation (i, j);
+	bool related;
+
+	related = (0 == annotationCache
+		   ? rel->annotate (sites[getVertexLabel (i)], sites[getVertexLabel (j)], aspb)
+		   : rel->annotate (*annotationCache, sites[getVertexLabel (i)], sites[getVertexLabel (j)], aspb));
+	if (related)
+	  {
+	    Relation *inv;
+
+	    if (sharedRelations)
+	      {
+		inv = new InvertedRelation (rel);
 	      }
 	    else
 	      {
-		delete rel;
+		inv = rel->clone ();
+		inv->invert ();
 	      }
+	    connect (i, j, rel, 0);
+	    connect (j, i, inv, 0);
+	  }
+	else
+	  {
+	    delete rel;
 	  }
-// 	gOut (0) << "Annotation " << time (0) - t << "s" << endl;
-	annotated = true;
       }
   }
 
@@ -406,115 +650,245 @@ namespace mccore
   {
     vector< Path< GraphModel::label, GraphModel::size_type > >::const_iterator cit;
     AbstractModel *tmp;
-    list< Residue* > mdl_res;
-    list< Residue* >::iterator resit;
 
     tmp = molecule.getModelFM ()->createModel ();
-
     for (cit = cycles.begin (); cycles.end () != cit; ++cit)
-    {
-      const Path< GraphModel::label, GraphModel::size_type > &cycle = *cit;
-      GraphModel *gm;
-      Path< GraphModel::label, GraphModel::size_type >::const_iterator pit;
-      AbstractModel::iterator mit;
-      Residue *ref;
-      label refl;
+      {
+	molecule.insert (*tmp);
+	GraphModelView (*this, cit->begin (), cit->end ()).copy (molecule.back ());
+      }
+    delete tmp;
+  }
+  
 
-      molecule.insert (*tmp);
-      AbstractModel &model = molecule.back ();
-      gm = dynamic_cast< GraphModel* > (&model);
+  typedef UndirectedGraph< GraphModel::label, bool, GraphModel::size_type, GraphModel::size_type > CycleGraph;
 
-      for (mdl_res.clear (), pit = cycle.begin (); cycle.end () != pit; ++pit)
-	mdl_res.push_back (&*model.insert (*internalGetVertex (*pit)));
 
-      ref = mdl_res.back ();
-      refl = cycle.back ();
+  /**
+   * Tells if a relation has one of the types.
+   * @param rel the relation.
+   * @param types the relation types, every relation matching if empty.
+   * @return whether the relation is followed.
+   */
+  static bool
+  isFollowed (const Relation *rel, const set< const PropertyType* > &types)
+  {
+    set< const PropertyType* >::const_iterator it;
 
-      for (pit = cycle.begin (), resit = mdl_res.begin (); cycle.end () != pit; ++pit, ++resit)
+    if (types.empty ())
       {
-	GraphModel::label resl;
-	Residue *res;
-
-	resl = *pit;
-	res = *resit;
-
-	if (0 != gm)
-	{
-	  Relation *rel;
-		
-	  rel = internalGetEdge (refl, resl)->clone ();
-	  rel->reassignResiduePointers (ref, res);
-	  gm->connect (ref, res, rel);
-
-	  rel = internalGetEdge (resl, refl)->clone ();
-	  rel->reassignResiduePointers (res, ref);
-	  gm->connect (res, ref, rel);
-	}
-	refl = resl;
-	ref = res;
+	return true;
       }
-    }
-
-    delete tmp;
+    for (it = types.begin (); types.end () != it; ++it)
+      {
+	if (rel->is (*it))
+	  {
+	    return true;
+	  }
+      }
+    return false;
   }
-  
 
-  void
-  GraphModel::minimumCycleBasis (Molecule &molecule) const
+
+  /**
+   * Builds the undirected graph of the model where the vertices are the
+   * GraphModel labels, keeping the residue pairs whose relation in either
+   * direction has one of the types.
+   * @param model the GraphModel.
+   * @param types the relation types, all relations if empty.
+   * @param graph the graph to fill.
+   */
+  static void
+  buildCycleGraph (const GraphModel &model, const set< const PropertyType* > &types, CycleGraph &graph)
   {
-    typedef UndirectedGraph< GraphModel::label, bool, GraphModel::size_type, GraphModel::size_type > UGraph;
-    UGraph graph;
-    vector< Path< UGraph::label, UGraph::size_type > > cycles;
-    const_iterator it;
-    edge_const_iterator eit;
+    GraphModel::const_iterator it;
+    GraphModel::edge_const_iterator eit;
+    GraphModel::label h;
+    GraphModel::label t;
 
-    for (it = begin (); end () != it; ++it)
+    graph.setHashedLookup (true);
+    for (it = model.begin (); model.end () != it; ++it)
       {
-	graph.insert (getVertexLabel (const_cast< Residue* > (&*it)));
+	graph.insert (model.getVertexLabel (const_cast< Residue* > (&*it)));
       }
-    for (eit = edge_begin (); edge_end () != eit; ++eit)
+    for (eit = model.edge_begin (); model.edge_end () != eit; ++eit)
       {
-	const Relation *rel = *eit;
-	
-	if (rel->getRef () < rel->getRes ())
+	h = model.getVertexLabel (const_cast< Residue* > ((*eit)->getRef ()));
+	t = model.getVertexLabel (const_cast< Residue* > ((*eit)->getRes ()));
+	// The pair is connected once, the connection from the inverse
+	// relation being ignored.
+	if (! graph.areConnected (h, t)
+	    && (isFollowed (*eit, types)
+		|| (model.internalAreConnected (t, h)
+		    && isFollowed (model.internalGetEdge (t, h), types))))
 	  {
-	    graph.connect (getVertexLabel (const_cast< Residue* > (rel->getRef ())),
-			   getVertexLabel (const_cast< Residue* > (rel->getRes ())),
-			   true, 1);
+	    graph.connect (h, t, true, 1);
 	  }
       }
+  }
+
+
+  /**
+   * Builds the undirected graph of the model where the vertices are the
+   * GraphModel labels.
+   * @param model the GraphModel.
+   * @param graph the graph to fill.
+   */
+  static void
+  buildCycleGraph (const GraphModel &model, CycleGraph &graph)
+  {
+    buildCycleGraph (model, set< const PropertyType* > (), graph);
+  }
+
+
+  /**
+   * Function object forwarding the cycles to a GraphModel::CycleVisitor.
+   */
+  class CycleVisitorAdapter
+  {
+    GraphModel::CycleVisitor *visitor;
+
+  public:
+
+    CycleVisitorAdapter (GraphModel::CycleVisitor &visitor) : visitor (&visitor) { }
+
+    bool operator() (const Path< CycleGraph::label, CycleGraph::size_type > &cycle)
+    {
+      return visitor->visit (cycle);
+    }
+  };
+
 
-    graph.internalMinimumCycleBasis (cycles);
+  void
+  GraphModel::minimumCycleBasis (Molecule &molecule) const
+  {
+    CycleGraph graph;
+    vector< Path< CycleGraph::label, CycleGraph::size_type > > cycles;
+
+    buildCycleGraph (*this, graph);
+    graph.internalMinimumCycleBasis (cycles, threadPool);
     fillMoleculeWithCycles (molecule, cycles);
   }
 
   
+  void
+  GraphModel::minimumCycleBasis (vector< GraphModelView > &views) const
+  {
+    CycleGraph graph;
+    vector< Path< CycleGraph::label, CycleGraph::size_type > > cycles;
+    vector< Path< CycleGraph::label, CycleGraph::size_type > >::const_iterator cit;
+
+    buildCycleGraph (*this, graph);
+    graph.internalMinimumCycleBasis (cycles, threadPool);
+    views.reserve (views.size () + cycles.size ());
+    for (cit = cycles.begin (); cycles.end () != cit; ++cit)
+      {
+	views.push_back (GraphModelView (*this, cit->begin (), cit->end ()));
+      }
+  }
+
+  
   void
   GraphModel::unionMinimumCycleBases (Molecule &molecule)
   {
-    typedef UndirectedGraph< GraphModel::label, bool, GraphModel::size_type, GraphModel::size_type > UGraph;
-    UGraph graph;
-    vector< Path< UGraph::label, UGraph::size_type > > cycles;
-    const_iterator it;
-    edge_const_iterator eit;
+    CycleGraph graph;
+    vector< Path< CycleGraph::label, CycleGraph::size_type > > cycles;
 
-    for (it = begin (); end () != it; ++it)
+    buildCycleGraph (*this, graph);
+    graph.internalUnionMinimumCycleBases (cycles, threadPool);
+    fillMoleculeWithCycles (molecule, cycles);
+  }
+
+
+  void
+  GraphModel::unionMinimumCycleBases (vector< GraphModelView > &views) const
+  {
+    CycleGraph graph;
+    vector< Path< CycleGraph::label, CycleGraph::size_type > > cycles;
+    vector< Path< CycleGraph::label, CycleGraph::size_type > >::const_iterator cit;
+
+    buildCycleGraph (*this, graph);
+    graph.internalUnionMinimumCycleBases (cycles, threadPool);
+    views.reserve (views.size () + cycles.size ());
+    for (cit = cycles.begin (); cycles.end () != cit; ++cit)
       {
-	graph.insert (getVertexLabel (const_cast< Residue* > (&*it)));
+	views.push_back (GraphModelView (*this, cit->begin (), cit->end ()));
       }
-    for (eit = edge_begin (); edge_end () != eit; ++eit)
+  }
+
+
+  GraphModel::size_type
+  GraphModel::unionMinimumCycleBases (CycleVisitor &visitor, size_type maxLength, size_type maxCount) const
+  {
+    CycleGraph graph;
+    CycleVisitorAdapter adapter (visitor);
+
+    buildCycleGraph (*this, graph);
+    return graph.internalUnionMinimumCycleBases (adapter, maxLength, maxCount, threadPool);
+  }
+
+
+  GraphModel::size_type
+  GraphModel::shortCycles (CycleVisitor &visitor, size_type maxLength, size_type maxCount) const
+  {
+    CycleGraph graph;
+    CycleVisitorAdapter adapter (visitor);
+
+    buildCycleGraph (*this, graph);
+    return graph.internalShortCycles (adapter, maxLength, maxCount);
+  }
+
+
+  GraphModel::size_type
+  GraphModel::shortCycles (CycleVisitor &visitor, size_type maxLength, const set< const PropertyType* > &types, size_type maxCount) const
+  {
+    CycleGraph graph;
+    CycleVisitorAdapter adapter (visitor);
+
+    buildCycleGraph (*this, types, graph);
+    return graph.internalShortCycles (adapter, maxLength, maxCount);
+  }
+
+
+  GraphModel::size_type
+  GraphModel::shortCycles (const vector< const Residue* > &roots, CycleVisitor &visitor, size_type maxLength, const set< const PropertyType* > &types, size_type maxCount) const throw (NoSuchElementException)
+  {
+    CycleGraph graph;
+    CycleVisitorAdapter adapter (visitor);
+    vector< CycleGraph::label > labels;
+    vector< const Residue* >::const_iterator it;
+
+    buildCycleGraph (*this, types, graph);
+    labels.reserve (roots.size ());
+    for (it = roots.begin (); roots.end () != it; ++it)
       {
-	const Relation *rel = *eit;
-	
-	if (rel->getRef () < rel->getRes ())
+	labels.push_back (graph.getVertexLabel (getVertexLabel (const_cast< Residue* > (*it))));
+      }
+    return graph.internalShortCycles (labels, adapter, maxLength, maxCount);
+  }
+
+
+  GraphModel::size_type
+  GraphModel::shortCycles (const vector< const Relation* > &roots, CycleVisitor &visitor, size_type maxLength, const set< const PropertyType* > &types, size_type maxCount) const throw (NoSuchElementException)
+  {
+    CycleGraph graph;
+    CycleVisitorAdapter adapter (visitor);
+    vector< CycleGraph::edge_label > labels;
+    vector< const Relation* >::const_iterator it;
+
+    buildCycleGraph (*this, types, graph);
+    labels.reserve (roots.size ());
+    for (it = roots.begin (); roots.end () != it; ++it)
+      {
+	CycleGraph::label h = graph.getVertexLabel (getVertexLabel (const_cast< Residue* > ((*it)->getRef ())));
+	CycleGraph::label t = graph.getVertexLabel (getVertexLabel (const_cast< Residue* > ((*it)->getRes ())));
+
+	if (graph.internalAreConnected (h, t))
 	  {
-	    graph.connect (getVertexLabel (const_cast< Residue* > (rel->getRef ())),
-			   getVertexLabel (const_cast< Residue* > (rel->getRes ())),
-			   true, 1);
+	    labels.push_back (graph.internalGetEdgeLabel (h, t));
 	  }
       }
-    graph.internalUnionMinimumCycleBases (cycles);
-    fillMoleculeWithCycles (molecule, cycles);
+    return graph.internalShortCyclesThrough (labels, adapter, maxLength, maxCount);
   }
 
   
@@ -628,6 +1002,7 @@ namespace mccore
 //     gOut (0) << "residue creation " << time (0) - t << "s" << endl;
 //     time (&t);
     insertRange (vres.begin (), vres.end ());
+    reindex ();
 //     gOut (0) << "insert in graph " << time (0) - t << "s" << endl;
     return ips;
   }
@@ -638,6 +1013,7 @@ namespace mccore
   {
     unsigned long long sz;
     map< ResId, const Residue* > resMap;
+    Arena::Scope scope (residueFM->getArena ());
 
     clear ();
     is >> sz;
@@ -672,12 +1048,20 @@ namespace mccore
 	is >> value;
 	internalConnect (from, to, rel, value);
       }
+    reindex ();
     return is >> annotated;
   }
   
   
   oBinstream&
   GraphModel::output (oBinstream &os) const
+  {
+    return output (os, true);
+  }
+
+
+  oBinstream&
+  GraphModel::output (oBinstream &os, bool transfos) const
   {
     unsigned long long sz;
     label lbl;
@@ -701,7 +1085,7 @@ namespace mccore
       {
 	os << (unsigned long long) revMapIt->second->getHeadLabel ()
 	   << (unsigned long long) revMapIt->second->getTailLabel ();
-	internalGetEdge (revMapIt->first)->write (os);
+	internalGetEdge (revMapIt->first)->write (os, transfos);
 	os << (long long) internalGetEdgeWeight (revMapIt->first);
       }
     return os << annotated;
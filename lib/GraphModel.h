@@ -27,9 +27,13 @@
 #define _mccore_GraphModel_h_
 
 #include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "AbstractModel.h"
 #include "Algo.h"
+#include "CsrGraph.h"
 #include "Exception.h"
 #include "Path.h"
 #include "Residue.h"
@@ -42,17 +46,22 @@ using namespace std;
 
 namespace mccore
 {
+  class AnnotationCache;
+  class GraphModelView;
+  class HBondSites;
   class Molecule;
   class Relation;
   class ResidueFactoryMethod;
   class ResidueType;
+  class ThreadPool;
 
 
 
   /**
    * The GraphModel class is a graph container for Residue pointers as
    * vertices and Relation pointers as edges.  It uses the AbstractModel
-   * iterators.
+   * iterators.  The graph lookups use hash tables, residues being found
+   * by address first.
    *
    * @author Martin Larose (<a href="larosem@iro.umontreal.ca">larosem@iro.umontreal.ca</a>)
    * @version $Id: GraphModel.h,v 1.17 2007-01-08 23:44:11 larosem Exp $
@@ -74,6 +83,7 @@ namespace mccore
     typedef Relation* edge;
     typedef int vertex_weight;
     typedef int edge_weight;
+    typedef CsrGraph< Residue*, Relation*, int, int > csr_graph;
 
   protected:
 
@@ -88,6 +98,24 @@ namespace mccore
      */
     bool annotated;
 
+    /**
+     * The annotation cache used by annotate, null for none.  It is not
+     * owned by the model.
+     */
+    AnnotationCache *annotationCache;
+
+    /**
+     * The thread pool used by the cycle bases, null to run them on the
+     * calling thread.  It is not owned by the model.
+     */
+    ThreadPool *threadPool;
+
+    /**
+     * Whether annotate stores one relation per residue pair and serves the
+     * reverse direction through an InvertedRelation.
+     */
+    bool sharedRelations;
+
   public:
 
     /**
@@ -96,7 +124,11 @@ namespace mccore
      * residues (default is @ref ExtendedResidueFM).
      */
     GraphModel (const ResidueFactoryMethod *fm = 0)
-      : AbstractModel (fm), annotated (false) { }
+      : AbstractModel (fm), annotated (false),
+	annotationCache (0), threadPool (0), sharedRelations (false)
+    {
+      setHashedLookup (true);
+    }
 
     /**
      * Initializes the object with the right's content (deep copy).
@@ -227,6 +259,55 @@ namespace mccore
      */
     void setAnnotated (bool val) { annotated = val; }
 
+    /**
+     * Gets the annotation cache used by annotate.
+     * @return the annotation cache, null for none.
+     */
+    AnnotationCache* getAnnotationCache () const { return annotationCache; }
+
+    /**
+     * Sets the annotation cache used by annotate.  The residue pairs whose
+     * conformers and relative position were already annotated through the
+     * cache are not annotated again (see Residue::setConformer).  The cache
+     * may be shared by many models and must outlive their annotation.
+     * @param cache the annotation cache, null for none.
+     */
+    void setAnnotationCache (AnnotationCache *cache) { annotationCache = cache; }
+
+    /**
+     * Gets the thread pool used by the cycle bases.
+     * @return the thread pool, null for none.
+     */
+    ThreadPool* getThreadPool () const { return threadPool; }
+
+    /**
+     * Sets the thread pool used by the minimum cycle basis and the union
+     * of minimum cycle bases.  Without a pool (the default) they run on
+     * the calling thread, as they also do for graphs smaller than
+     * UndirectedGraph::parallelThreshold residues.  The pool may be shared
+     * by many models and must outlive their cycle searches.
+     * @param pool the thread pool, null for none.
+     */
+    void setThreadPool (ThreadPool *pool) { threadPool = pool; }
+
+    /**
+     * Tells if annotate shares the relations of a residue pair.
+     * @return the shared relations flag.
+     */
+    bool getSharedRelations () const { return sharedRelations; }
+
+    /**
+     * Sets whether annotate stores a single relation per residue pair.
+     * By default each direction gets its own relation, the reverse one
+     * being an inverted clone.  When set, the reverse direction is an
+     * InvertedRelation over the forward relation: the hydrogen bond flows
+     * are not copied and the reverse transformations and paired faces are
+     * only computed when accessed.  The edge API is unchanged.  It takes
+     * effect on the next annotation.
+     * @param val the new shared relations flag.
+     */
+    void setSharedRelations (bool val) { sharedRelations = val; }
+
     // METHODS -------------------------------------------------------------
 
   private:
@@ -308,109 +389,77 @@ namespace mccore
     /**
      * Removes the amino acids from the model.  If the
      * GraphModel is already annotated, it rearrange the adjacency graph.
-     * The edge order may change.
      */
     virtual void removeAminoAcid ();
 
     /**
      * Removes the nucleic acids from the model.  If the
      * GraphModel is already annotated, it rearrange the adjacency graph.
-     * The edge order may change.
      */
     virtual void removeNucleicAcid ();
 
     /**
      * Removes every residue that is not an amino acid.  If the
      * GraphModel is already annotated, it rearrange the adjacency graph.
-     * The edge order may change.
      */
     virtual void keepAminoAcid ();
 
     /**
      * Removes every residue that is not a nucleic acid.  If the
      * GraphModel is already annotated, it rearrange the adjacency graph.
-     * The edge order may change.
      */
     virtual void keepNucleicAcid ();
 
     /**
      * Removes every residue that is not RNA.  If the GraphModel is already
-     * annotated, it rearrange the adjacency graph.  The edge order may
-     * change.
+     * annotated, it rearrange the adjacency graph.
      */
     virtual void keepRNA ();
 
     /**
      * Removes every residue that is not DNA.  If the GraphModel is already
-     * annotated, it rearrange the adjacency graph.  The edge order may
-     * change.
+     * annotated, it rearrange the adjacency graph.
      */
     virtual void keepDNA ();
 
+    /**
+     * Removes the water molecules from the model.  If the GraphModel is
+     * already annotated, it rearrange the adjacency graph.
+     */
+    virtual void removeWater ();
+
+    /**
+     * Removes every residue that is not of the given type family.  If the
+     * GraphModel is already annotated, it rearrange the adjacency graph.
+     * @param rtype type family.
+     */
+    virtual void keep (const ResidueType* rtype);
+
   private:
 
+    /**
+     * Erases the marked residues and their relations in a single pass
+     * over the graph and destroys them.
+     * @param marks the flags of the residue labels to erase.
+     */
+    void eraseMarked (const vector< bool > &marks);
+
     /**
      * Template function used by removeAminoAcid, removeNucleicAcid,
      * keepAminoAcid, keepNucleicAcid, keepRNA and keepDNA.  If the
      * GraphModel is already annotated, it rearrange the adjacency graph.
-     * The edge order may change.
      */
     template < class V >
     void keepTemplate ()
     {
-      if (! empty ())
+      vector< bool > marks (size (), false);
+      graphsuper::size_type vIndex;
+
+      for (vIndex = 0; vIndex < marks.size (); ++vIndex)
 	{
-	  vector< Residue* > newv;
-	  vector< int > newweights;
-	  const graphsuper::size_type sz = size ();
-	  graphsuper::size_type vIndex;
-	  graphsuper::size_type *corresp;
-	  vector< bool > marks;
-	  EV2ELabel newEdgeMap;
-	  EV2ELabel::iterator evIt;
-	  vector< Relation* > newe;
-	  vector< int > newew;
-
-	  corresp = new graphsuper::size_type[vertices.size ()];
-	  for (vIndex = 0; vIndex < sz; ++vIndex)
-	    {
-	      bool value = V ().operator () (vertices[vIndex]->getType ());
-
-	      corresp[vIndex] = newv.size ();
-	      marks.push_back (value);
-	      if (value)
-		{
-		  newv.push_back (vertices[vIndex]);
-		  newweights.push_back (vertexWeights[vIndex]);
-		}
-	    }
-	  for (evIt = ev2elabel.begin (); ev2elabel.end () != evIt; ++evIt)
-	    {
-	      const EndVertices &endVertices = evIt->first;
-
-	      if (marks[endVertices.getHeadLabel ()]
-		  && marks[endVertices.getTailLabel ()])
-		{
-		  EndVertices ev (corresp[endVertices.getHeadLabel ()],
-				  corresp[endVertices.getTailLabel ()]);
-
-		  newEdgeMap.insert (make_pair (ev, newe.size ()));
-		  newe.push_back (edges[evIt->second]);
-		  newew.push_back (edgeWeights[evIt->second]);
-		}
-	      else
-		{
-		  delete edges[evIt->second];
-		}
-	    }
-	  vertices = newv;
-	  vertexWeights = newweights;
-	  rebuildV2VLabel ();
-	  edges = newe;
-	  edgeWeights = newew;
-	  ev2elabel = newEdgeMap;
-	  delete[] corresp;
+	  marks[vIndex] = ! V ().operator () (vertices[vIndex]->getType ());
 	}
+      eraseMarked (marks);
     }
 
   public:
@@ -439,7 +488,10 @@ namespace mccore
     virtual void clear ();
 
     /**
-     * Annotates the GraphModel.  It builds edges in the graph.
+     * Annotates the GraphModel.  It builds edges in the graph.  With
+     * Relation::fast_mask, the base pairs are screened from the base
+     * geometry (see Relation::arePairedFast) and the hydrogens and lone
+     * pairs are not added to the residues.
      * @param asbp Bit mask controlling annotation tasks: adjacency,
      *        stacking, pairing and pairing with backbone (default: all).
      */
@@ -457,8 +509,44 @@ namespace mccore
       annotate (aspb);
     }
 
+    /**
+     * Reannotates the residues that were moved or replaced since the last
+     * annotation.  Only the relations of the changed residues are dropped,
+     * the contacts of the changed residues are searched again and only
+     * these residue pairs are annotated, so the cost follows the number of
+     * changed residues.  The hydrogens and lone pairs are only added to
+     * the changed residues.  The relations end up the same as with a
+     * complete reannotation, but the new ones get the last edge labels.
+     * The GraphModel is fully annotated if it was not annotated.
+     * @param changed the labels of the changed residues, the invalid
+     *        labels are ignored.
+     * @param asbp Bit mask controlling annotation tasks, it should be the
+     *        one of the last annotation (default: all).
+     */
+    void reannotate (const vector< label > &changed, unsigned char aspb = Relation::adjacent_mask|Relation::pairing_mask|Relation::stacking_mask|Relation::bhbond_mask);
+
+    /**
+     * Freezes the GraphModel into a compressed sparse row snapshot for the
+     * analyses that only read it.  The snapshot shares the residue and
+     * relation pointers of this GraphModel and uses its labels: it must
+     * not outlive it nor be used after it is modified.
+     * @param csr the snapshot to fill.
+     */
+    void freeze (csr_graph &csr) const { csr.assign (*this); }
+
   private:
 
+    /**
+     * Annotates the residue pairs and connects the related ones with the
+     * relation and its inverse.
+     * @param contacts the residue pairs to annotate.
+     * @param sites the hydrogen bond sites indexed by residue label, they
+     *        must be built for the contact residues when the annotation
+     *        needs them.
+     * @param asbp Bit mask controlling annotation tasks.
+     */
+    void annotateContacts (const vector< pair< iterator, iterator > > &contacts, const vector< HBondSites > &sites, unsigned char aspb);
+
     /**
      * Fills the Molecule with the elements from this identified with the
      * Path vector.
@@ -469,18 +557,127 @@ namespace mccore
 
   public:
 
+    /**
+     * @short Receiver of the cycles enumerated from the GraphModel.
+     */
+    class CycleVisitor
+    {
+    public:
+
+      /**
+       * Destroys the object.
+       */
+      virtual ~CycleVisitor () { }
+
+      /**
+       * Visits a cycle.  The cycle is a Path of GraphModel labels where the
+       * first and last vertices are connected, it is only valid during the
+       * call.
+       * @param cycle the cycle.
+       * @return false to stop the enumeration.
+       */
+      virtual bool visit (const Path< GraphModel::label, GraphModel::size_type > &cycle) = 0;
+    };
+
     /**
      * Finds a minimum cycle basis from this GraphModel.
      * @param molecule the container to fill with the cycles.
      */
     void minimumCycleBasis (Molecule &molecule) const;
 
+    /**
+     * Finds a minimum cycle basis from this GraphModel as views on its
+     * residues and relations.
+     * @param views the collection to fill with the cycles.
+     */
+    void minimumCycleBasis (vector< GraphModelView > &views) const;
+
     /**
      * Finds the union of minimum cycle bases from this GraphModel.
      * @param molecule the container to fill with the cycles.
      */
     void unionMinimumCycleBases (Molecule &molecule);
 
+    /**
+     * Finds the union of minimum cycle bases from this GraphModel as views
+     * on its residues and relations.
+     * @param views the collection to fill with the cycles.
+     */
+    void unionMinimumCycleBases (vector< GraphModelView > &views) const;
+
+    /**
+     * Enumerates the union of minimum cycle bases from this GraphModel
+     * without storing it.  The cycles are given to the visitor as they are
+     * found, grouped by prototype in order of non decreasing length.
+     * @param visitor the visitor receiving the cycles.
+     * @param maxLength the maximum number of edges of the visited cycles,
+     *        0 for no bound.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    size_type unionMinimumCycleBases (CycleVisitor &visitor, size_type maxLength = 0, size_type maxCount = 0) const;
+
+    /**
+     * Enumerates the cycles of at most maxLength relations of this
+     * GraphModel, a relation and its inverse counting once.  The search is
+     * bounded by the cycle length, so it is much cheaper than a cycle basis
+     * when looking for small loops.  Each cycle is given once to the
+     * visitor.
+     * @param visitor the visitor receiving the cycles.
+     * @param maxLength the maximum number of relations of the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    size_type shortCycles (CycleVisitor &visitor, size_type maxLength, size_type maxCount = 0) const;
+
+    /**
+     * Enumerates the cycles of at most maxLength relations of this
+     * GraphModel following only the relations that are one of the types
+     * (see Relation::is).
+     * @param visitor the visitor receiving the cycles.
+     * @param maxLength the maximum number of relations of the cycles.
+     * @param types the relation types to follow, all relations if empty.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    size_type shortCycles (CycleVisitor &visitor, size_type maxLength, const set< const PropertyType* > &types, size_type maxCount = 0) const;
+
+    /**
+     * Enumerates the cycles of at most maxLength relations going through
+     * at least one of the root residues, following only the relations that
+     * are one of the types.  Only the neighborhoods of the roots are
+     * searched.
+     * @param roots the residues of the model the cycles go through.
+     * @param visitor the visitor receiving the cycles.
+     * @param maxLength the maximum number of relations of the cycles.
+     * @param types the relation types to follow, all relations if empty.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     * @exception NoSuchElementException if a root is not in the model.
+     */
+    size_type shortCycles (const vector< const Residue* > &roots, CycleVisitor &visitor, size_type maxLength, const set< const PropertyType* > &types, size_type maxCount = 0) const throw (NoSuchElementException);
+
+    /**
+     * Enumerates the cycles of at most maxLength relations going through
+     * at least one of the root relations, following only the relations
+     * that are one of the types.  The roots that are not followed are
+     * ignored.
+     * @param roots the relations of the model the cycles go through.
+     * @param visitor the visitor receiving the cycles.
+     * @param maxLength the maximum number of relations of the cycles.
+     * @param types the relation types to follow, all relations if empty.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     * @exception NoSuchElementException if a root residue is not in the
+     * model.
+     */
+    size_type shortCycles (const vector< const Relation* > &roots, CycleVisitor &visitor, size_type maxLength, const set< const PropertyType* > &types, size_type maxCount = 0) const throw (NoSuchElementException);
+
 
     // I/O  -----------------------------------------------------------------
 
@@ -505,6 +702,16 @@ namespace mccore
      */
     virtual oBinstream& output (oBinstream &obs) const;
 
+    /**
+     * Writes the model to a binary output stream, optionally leaving the
+     * relation transformations out (see Relation::write).  Either form is
+     * read back by input.
+     * @param obs the binary data stream.
+     * @param transfos whether the relation transformations are written.
+     * @return the consumed binary stream.
+     */
+    oBinstream& output (oBinstream &obs, bool transfos) const;
+
     /**
      * Reads the model from a binary input stream.
      * @param obs the binary data stream.
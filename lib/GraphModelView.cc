@@ -0,0 +1,199 @@
+//                              -*- Mode: C++ -*-
+// GraphModelView.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:39:33 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include <list>
+
+#include "AbstractModel.h"
+#include "Binstream.h"
+#include "GraphModelView.h"
+#include "Pdbstream.h"
+#include "Relation.h"
+#include "Residue.h"
+
+
+
+namespace mccore
+{
+
+  void
+  GraphModelView::copy (AbstractModel &destination) const
+  {
+    GraphModel *gm;
+    vector< label >::const_iterator lit;
+    list< Residue* > mdl_res;
+    list< Residue* >::iterator resit;
+    Residue *ref;
+    label refl;
+
+    if (labels.empty ())
+      {
+	return;
+      }
+    for (lit = labels.begin (); labels.end () != lit; ++lit)
+      {
+	mdl_res.push_back (&*destination.insert (*model->internalGetVertex (*lit)));
+      }
+    gm = dynamic_cast< GraphModel* > (&destination);
+    if (0 == gm)
+      {
+	return;
+      }
+
+    ref = mdl_res.back ();
+    refl = labels.back ();
+    for (lit = labels.begin (), resit = mdl_res.begin (); labels.end () != lit; ++lit, ++resit)
+      {
+	label resl;
+	Residue *res;
+
+	resl = *lit;
+	res = *resit;
+	if (labels.begin () != lit || (cyclic && 2 < labels.size ()))
+	  {
+	    Relation *rel;
+
+	    rel = model->internalGetEdge (refl, resl)->clone ();
+	    rel->reassignResiduePointers (ref, res);
+	    gm->connect (ref, res, rel);
+
+	    rel = model->internalGetEdge (resl, refl)->clone ();
+	    rel->reassignResiduePointers (res, ref);
+	    gm->connect (res, ref, rel);
+	  }
+	refl = resl;
+	ref = res;
+      }
+  }
+
+
+  ostream&
+  GraphModelView::output (ostream &os) const
+  {
+    const_iterator it;
+
+    os << "[ ";
+    for (it = begin (); end () != it; ++it)
+      {
+	os << it->getResId () << " ";
+      }
+    os << "]";
+    return os;
+  }
+
+
+  oPdbstream&
+  GraphModelView::output (oPdbstream &ops) const
+  {
+    const_iterator it;
+    char chainId;
+
+    it = begin ();
+    if (end () != it)
+      {
+	chainId = it->getResId ().getChainId ();
+	for (; end () != it; ++it)
+	  {
+	    if (it->getResId ().getChainId () != chainId)
+	      {
+		ops.ter ();
+		chainId = it->getResId ().getChainId ();
+	      }
+	    ops << *it;
+	  }
+	ops.ter ();
+      }
+    return ops;
+  }
+
+
+  oBinstream&
+  GraphModelView::output (oBinstream &obs) const
+  {
+    vector< label >::const_iterator lit;
+    unsigned long long pairs;
+    unsigned long long ref;
+    unsigned long long res;
+    label refl;
+
+    obs << (unsigned long long) labels.size ();
+    for (lit = labels.begin (); labels.end () != lit; ++lit)
+      {
+	obs << *model->internalGetVertex (*lit)
+	    << (long long) model->internalGetVertexWeight (*lit);
+      }
+
+    pairs = edgeSize ();
+    obs << 2 * pairs;
+    if (0 < pairs)
+      {
+	refl = labels.back ();
+	ref = labels.size () - 1;
+	for (lit = labels.begin (), res = 0; labels.end () != lit; ++lit, ++res)
+	  {
+	    if (labels.begin () != lit || (cyclic && 2 < labels.size ()))
+	      {
+		obs << ref << res;
+		model->internalGetEdge (refl, *lit)->write (obs);
+		obs << (long long) model->internalGetEdgeWeight (refl, *lit);
+		obs << res << ref;
+		model->internalGetEdge (*lit, refl)->write (obs);
+		obs << (long long) model->internalGetEdgeWeight (*lit, refl);
+	      }
+	    refl = *lit;
+	    ref = res;
+	  }
+      }
+    return obs << false;
+  }
+
+
+  oPdbstream&
+  operator<< (oPdbstream &ops, const GraphModelView &obj)
+  {
+    return obj.output (ops);
+  }
+
+
+  oBinstream&
+  operator<< (oBinstream &obs, const GraphModelView &obj)
+  {
+    return obj.output (obs);
+  }
+
+}
+
+
+
+namespace std
+{
+
+  ostream&
+  operator<< (ostream &os, const mccore::GraphModelView &obj)
+  {
+    return obj.output (os);
+  }
+
+}
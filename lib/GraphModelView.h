@@ -0,0 +1,299 @@
+//                              -*- Mode: C++ -*-
+// GraphModelView.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:39:33 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_GraphModelView_h_
+#define _mccore_GraphModelView_h_
+
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "GraphModel.h"
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  class AbstractModel;
+  class Relation;
+  class Residue;
+  class oBinstream;
+  class oPdbstream;
+
+
+
+  /**
+   * @short Lightweight subgraph of a GraphModel.
+   *
+   * The view references the residues and relations of a parent GraphModel
+   * through their labels, in the order of a path or cycle.  It costs a
+   * label per vertex instead of copies of the residues and relations.
+   * The parent must outlive the view and must not be modified while the
+   * view is used.  The view can be copied into a model on demand.
+   */
+  class GraphModelView
+  {
+  public:
+
+    typedef GraphModel::label label;
+    typedef vector< label >::size_type size_type;
+
+    /**
+     * @short Iterator on the residues of the view.
+     */
+    class const_iterator
+    {
+      const GraphModel *model;
+      vector< label >::const_iterator it;
+
+    public:
+
+      typedef bidirectional_iterator_tag iterator_category;
+      typedef const Residue value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const Residue* pointer;
+      typedef const Residue& reference;
+
+      const_iterator () : model (0) { }
+
+      const_iterator (const GraphModel *model, vector< label >::const_iterator it)
+	: model (model), it (it)
+      { }
+
+      const Residue& operator* () const { return *model->internalGetVertex (*it); }
+
+      const Residue* operator-> () const { return model->internalGetVertex (*it); }
+
+      const_iterator& operator++ () { ++it; return *this; }
+
+      const_iterator operator++ (int) { const_iterator tmp (*this); ++it; return tmp; }
+
+      const_iterator& operator-- () { --it; return *this; }
+
+      const_iterator operator-- (int) { const_iterator tmp (*this); --it; return tmp; }
+
+      bool operator== (const const_iterator &right) const { return it == right.it; }
+
+      bool operator!= (const const_iterator &right) const { return it != right.it; }
+
+      /**
+       * Gets the label in the parent GraphModel.
+       * @return the label.
+       */
+      label getLabel () const { return *it; }
+    };
+
+  private:
+
+    /**
+     * The parent GraphModel.
+     */
+    const GraphModel *model;
+
+    /**
+     * The labels of the residues in the parent.
+     */
+    vector< label > labels;
+
+    /**
+     * Whether the last residue is connected to the first.
+     */
+    bool cyclic;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the object as an empty view.
+     */
+    GraphModelView () : model (0), cyclic (false) { }
+
+    /**
+     * Initializes the view from a range of labels of the model.
+     * @param model the parent GraphModel.
+     * @param f the iterator on the first label.
+     * @param l the iterator past the last label.
+     * @param cyclic whether the last residue is connected to the first.
+     */
+    template< class InputIterator >
+    GraphModelView (const GraphModel &model, InputIterator f, InputIterator l, bool cyclic = true)
+      : model (&model), labels (f, l), cyclic (cyclic)
+    { }
+
+    /**
+     * Destroys the object.
+     */
+    ~GraphModelView () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the parent GraphModel.
+     * @return the parent or 0 for an empty view.
+     */
+    const GraphModel* getModel () const { return model; }
+
+    /**
+     * Gets the labels of the residues in the parent GraphModel.
+     * @return the labels.
+     */
+    const vector< label >& getLabels () const { return labels; }
+
+    /**
+     * Tells if the last residue is connected to the first.
+     * @return whether the view is a cycle.
+     */
+    bool isCyclic () const { return cyclic; }
+
+    /**
+     * Gets the number of residues of the view.
+     * @return the size.
+     */
+    size_type size () const { return labels.size (); }
+
+    /**
+     * Tells if the view is empty.
+     * @return whether the view is empty.
+     */
+    bool empty () const { return labels.empty (); }
+
+    /**
+     * Gets an iterator on the first residue.
+     * @return the iterator.
+     */
+    const_iterator begin () const { return const_iterator (model, labels.begin ()); }
+
+    /**
+     * Gets an iterator past the last residue.
+     * @return the iterator.
+     */
+    const_iterator end () const { return const_iterator (model, labels.end ()); }
+
+    /**
+     * Gets the residue at position i.
+     * @param i the position.
+     * @return the residue.
+     */
+    const Residue& operator[] (size_type i) const { return *model->internalGetVertex (labels[i]); }
+
+    /**
+     * Gets the number of relations of the view: one per consecutive pair
+     * of residues, plus the closing one when the view is cyclic.  A cycle
+     * of two residues has a single pair, as in copy and output.
+     * @return the number of relations.
+     */
+    size_type edgeSize () const
+    {
+      return (labels.size () < 2
+	      ? 0
+	      : (cyclic && 2 < labels.size () ? labels.size () : labels.size () - 1));
+    }
+
+    /**
+     * Gets the relation from the residue at position i to the next one.
+     * @param i the position.
+     * @return the relation in the parent GraphModel.
+     * @exception NoSuchElementException if the residues are not connected.
+     */
+    const Relation* getEdge (size_type i) const
+    {
+      return model->internalGetEdge (labels[i], labels[(i + 1) % labels.size ()]);
+    }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Copies the residues of the view into a model.  When the model is a
+     * GraphModel, the relations of the view are cloned and connected in
+     * both directions.
+     * @param destination the model to fill.
+     */
+    void copy (AbstractModel &destination) const;
+
+    // I/O  -----------------------------------------------------------------
+
+    /**
+     * Writes the residue ids of the view to the stream.
+     * @param os the output stream.
+     * @return the used output stream.
+     */
+    ostream& output (ostream &os) const;
+
+    /**
+     * Writes the residues of the view to a pdb output stream.
+     * @param ops the pdb data stream.
+     * @return the consumed pdb stream.
+     */
+    oPdbstream& output (oPdbstream &ops) const;
+
+    /**
+     * Writes the view to a binary stream in the GraphModel format, so that
+     * it reads back as a GraphModel holding what copy would produce: the
+     * residues in view order and the relations between consecutive
+     * residues in both directions.  The annotated flag is written false
+     * since the other relations of the parent are not part of the view.
+     * @param obs the binary output stream.
+     * @return the consumed binary stream.
+     */
+    oBinstream& output (oBinstream &obs) const;
+
+  };
+
+  /**
+   * Outputs the view to a binary stream.
+   * @param obs the binary output stream.
+   * @param obj the view to output.
+   * @return the consumed binary stream.
+   */
+  oBinstream& operator<< (oBinstream &obs, const GraphModelView &obj);
+
+  /**
+   * Outputs the view to a pdb stream.
+   * @param ops the output pdb stream.
+   * @param obj the view to output.
+   * @return the output pdb stream.
+   */
+  oPdbstream& operator<< (oPdbstream &ops, const GraphModelView &obj);
+
+}
+
+
+
+namespace std
+{
+
+  /**
+   * Outputs the view to an output stream.
+   * @param os the output stream.
+   * @param obj the view to output.
+   * @return the output stream.
+   */
+  ostream& operator<< (ostream &os, const mccore::GraphModelView &obj);
+
+}
+
+#endif
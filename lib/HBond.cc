@@ -51,10 +51,10 @@ namespace mccore
 
   // MEMBER CONSTANT ---------------------------------------------------------
 
-  const int HBond::sNbGauss = 7;
+  const int HBond::sNbGauss;
 
   
-  const float HBond::sProbH[7] = {
+  const float HBond::sProbH[sNbGauss] = {
     1,
     0,
     0,
@@ -65,7 +65,7 @@ namespace mccore
   };
 
   
-  const float HBond::sWeight[7] = {
+  const float HBond::sWeight[sNbGauss] = {
     // Optimis� sur level1
     0.00752508,
     0.00989524,
@@ -77,7 +77,7 @@ namespace mccore
   };
 
   
-  const float HBond::sMean[7][3] = {
+  const float HBond::sMean[sNbGauss][3] = {
     {0.100846, 2.45718, 2.25155},
     {8.78474, 1.13239, -0.0738701},
     {3.28653, 0.449332, 0.474348},
@@ -88,7 +88,7 @@ namespace mccore
   };
 
   
-  const float HBond::sCovarInv[7][3][3] = {
+  const float HBond::sCovarInv[sNbGauss][3][3] = {
     {{2.80141, 1.04863, 0.88979},
      {1.04863, 2.37603, -0.59708},
      {0.88979, -0.59708, 2.58077}},
@@ -113,7 +113,7 @@ namespace mccore
   };
 
   
-  const float HBond::sCovarDet[7] = {
+  const float HBond::sCovarDet[sNbGauss] = {
     0.096653,
     6.40514,
     0.157177,
@@ -300,15 +300,10 @@ namespace mccore
     
     if (donor == AtomType::aC5M)
       {
-	Vector3D px, py, pz, up, pv;
-      
-	px = (getLonePair () - *ra->safeFind (AtomType::aC5)).normalize ();
-	py = (getDonor () - *rb->safeFind (AtomType::aC5)).normalize ();
-	up = px.cross (py).normalize ();
-	pz = py.cross (up);
-	pv = getDonor () + (py + pz * TAN70).normalize () * C_H_DIST_CYC;
-      
-	at = Atom (pv, hydrogen);
+	at = Atom (methylHydrogen (getDonor (), getLonePair (),
+				   *ra->safeFind (AtomType::aC5),
+				   *rb->safeFind (AtomType::aC5)),
+		   hydrogen);
       }
 //     else if (donor == AtomType::aO2p)
 //       {
@@ -367,6 +362,19 @@ namespace mccore
   }
   
   
+  Vector3D
+  HBond::methylHydrogen (const Vector3D &donor, const Vector3D &lonepair, const Vector3D &c5d, const Vector3D &c5a)
+  {
+    Vector3D px, py, pz, up;
+      
+    px = (lonepair - c5d).normalize ();
+    py = (donor - c5a).normalize ();
+    up = px.cross (py).normalize ();
+    pz = py.cross (up);
+    return donor + (py + pz * TAN70).normalize () * C_H_DIST_CYC;
+  }
+  
+  
   ostream &
   HBond::output (ostream &os) const
   {
@@ -43,6 +43,7 @@ namespace mccore
   class Atom;
   class AtomType;
   class Residue;
+  class Vector3D;
   class iBinstream;
   class oBinstream;
 
@@ -59,6 +60,7 @@ namespace mccore
   class HBond
   {
     friend class Relation;
+    friend class HBondBatch;
 
     /**
      * The donor atom type implicated in the bond.
@@ -101,12 +103,12 @@ namespace mccore
      * base pairing types: a recognition method and complete
      * repertoire, NAR 30(19):4250-4263.
      */
-    static const int sNbGauss;
-    static const float sProbH[7];
-    static const float sWeight[7];
-    static const float sMean[7][3];
-    static const float sCovarInv[7][3][3];
-    static const float sCovarDet[7];
+    static const int sNbGauss = 7;
+    static const float sProbH[sNbGauss];
+    static const float sWeight[sNbGauss];
+    static const float sMean[sNbGauss][3];
+    static const float sCovarInv[sNbGauss][3][3];
+    static const float sCovarDet[sNbGauss];
 
   public:
       
@@ -284,6 +286,18 @@ namespace mccore
      * @return a score between 0 and 1, where 0 is low probability and 1 is high probability.      
      */
     float evalStatistically (const Residue *ra, const Residue *rb);
+
+    /**
+     * Places the methyl hydrogen of a C5M donor used by the statistical
+     * evaluation, at the C-H distance of aromatic carbons and pointing
+     * towards the lone pair.
+     * @param donor the C5M atom.
+     * @param lonepair the lone pair.
+     * @param c5d the C5 atom of the donor residue.
+     * @param c5a the C5 atom of the acceptor residue.
+     * @return the position of the hydrogen.
+     */
+    static Vector3D methylHydrogen (const Vector3D &donor, const Vector3D &lonepair, const Vector3D &c5d, const Vector3D &c5a);
       
     // I/O -------------------------------------------------------------------
 
@@ -0,0 +1,328 @@
+//                              -*- Mode: C++ -*-
+// HBondBatch.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:23:18 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "HBond.h"
+#include "HBondBatch.h"
+#include "Vector3D.h"
+
+
+
+namespace mccore
+{
+  /**
+   * The mixture components of HBond with the quadratic form of the inverse
+   * covariance folded to six coefficients and the weight divided by the
+   * Gaussian normalizer.
+   */
+  struct HBondComponent
+  {
+    float mean[3];
+    float square[3];
+    float cross[3];
+    float scale;
+    float probH;
+  };
+
+
+  /**
+   * Cosine of the angle between the vectors from the vertex to a and to
+   * c, 1 when one of them is null as in Vector3D::angle.
+   */
+  static float
+  cosine (float vx, float vy, float vz, float ax, float ay, float az, float cx, float cy, float cz)
+  {
+    float ux = ax - vx;
+    float uy = ay - vy;
+    float uz = az - vz;
+    float wx = cx - vx;
+    float wy = cy - vy;
+    float wz = cz - vz;
+    float len;
+
+    len = sqrt (ux * ux + uy * uy + uz * uz) * sqrt (wx * wx + wy * wy + wz * wz);
+    return 0 == len ? 1 : (ux * wx + uy * wy + uz * wz) / len;
+  }
+
+
+#ifdef __SSE2__
+
+  /**
+   * Exponential of four floats with the Cephes polynomial.  Arguments
+   * below the float range and NaN give 0.
+   */
+  static __m128
+  expFloat (__m128 x)
+  {
+    const __m128 one = _mm_set1_ps (1.0f);
+    __m128 valid;
+    __m128 fx;
+    __m128 tmp;
+    __m128 y;
+    __m128 z;
+    __m128i n;
+
+    valid = _mm_and_ps (_mm_cmpord_ps (x, x), _mm_cmpge_ps (x, _mm_set1_ps (-87.3f)));
+    x = _mm_max_ps (_mm_min_ps (x, _mm_set1_ps (88.3f)), _mm_set1_ps (-87.3f));
+    fx = _mm_add_ps (_mm_mul_ps (x, _mm_set1_ps (1.44269504088896341f)), _mm_set1_ps (0.5f));
+    tmp = _mm_cvtepi32_ps (_mm_cvttps_epi32 (fx));
+    fx = _mm_sub_ps (tmp, _mm_and_ps (_mm_cmpgt_ps (tmp, fx), one));
+    x = _mm_sub_ps (x, _mm_mul_ps (fx, _mm_set1_ps (0.693359375f)));
+    x = _mm_sub_ps (x, _mm_mul_ps (fx, _mm_set1_ps (-2.12194440e-4f)));
+    z = _mm_mul_ps (x, x);
+    y = _mm_set1_ps (1.9875691500e-4f);
+    y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (1.3981999507e-3f));
+    y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (8.3334519073e-3f));
+    y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (4.1665795894e-2f));
+    y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (1.6666665459e-1f));
+    y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (5.0000001201e-1f));
+    y = _mm_add_ps (_mm_add_ps (_mm_mul_ps (y, z), x), one);
+    n = _mm_slli_epi32 (_mm_add_epi32 (_mm_cvttps_epi32 (fx), _mm_set1_epi32 (0x7f)), 23);
+    return _mm_and_ps (_mm_mul_ps (y, _mm_castsi128_ps (n)), valid);
+  }
+
+#endif
+
+
+  /**
+   * Evaluates the mixture on features stored by groups of four.
+   * @param components the mixture components.
+   * @param ncomponents the number of components.
+   * @param f0 the log of the cubed hydrogen-lone pair distances.
+   * @param f1 the donor angle features.
+   * @param f2 the acceptor angle features.
+   * @param count the number of features, a multiple of 4.
+   * @param out the scores.
+   */
+  static void
+  evalMixture (const HBondComponent *components, int ncomponents, const float *f0, const float *f1, const float *f2, HBondBatch::size_type count, float *out)
+  {
+    HBondBatch::size_type j;
+    int i;
+
+#ifdef __SSE2__
+    for (j = 0; count > j; j += 4)
+      {
+	__m128 x0 = _mm_loadu_ps (f0 + j);
+	__m128 x1 = _mm_loadu_ps (f1 + j);
+	__m128 x2 = _mm_loadu_ps (f2 + j);
+	__m128 px = _mm_setzero_ps ();
+	__m128 ph = _mm_setzero_ps ();
+
+	for (i = 0; ncomponents > i; ++i)
+	  {
+	    const HBondComponent &c = components[i];
+	    __m128 d0 = _mm_sub_ps (x0, _mm_set1_ps (c.mean[0]));
+	    __m128 d1 = _mm_sub_ps (x1, _mm_set1_ps (c.mean[1]));
+	    __m128 d2 = _mm_sub_ps (x2, _mm_set1_ps (c.mean[2]));
+	    __m128 q;
+	    __m128 prob;
+
+	    q = _mm_mul_ps (_mm_mul_ps (d0, d0), _mm_set1_ps (c.square[0]));
+	    q = _mm_add_ps (q, _mm_mul_ps (_mm_mul_ps (d1, d1), _mm_set1_ps (c.square[1])));
+	    q = _mm_add_ps (q, _mm_mul_ps (_mm_mul_ps (d2, d2), _mm_set1_ps (c.square[2])));
+	    q = _mm_add_ps (q, _mm_mul_ps (_mm_mul_ps (d0, d1), _mm_set1_ps (c.cross[0])));
+	    q = _mm_add_ps (q, _mm_mul_ps (_mm_mul_ps (d0, d2), _mm_set1_ps (c.cross[1])));
+	    q = _mm_add_ps (q, _mm_mul_ps (_mm_mul_ps (d1, d2), _mm_set1_ps (c.cross[2])));
+	    prob = _mm_mul_ps (expFloat (_mm_mul_ps (q, _mm_set1_ps (-0.5f))), _mm_set1_ps (c.scale));
+	    px = _mm_add_ps (px, prob);
+	    ph = _mm_add_ps (ph, _mm_mul_ps (prob, _mm_set1_ps (c.probH)));
+	  }
+	_mm_storeu_ps (out + j, _mm_div_ps (ph, px));
+      }
+#else
+    for (j = 0; count > j; ++j)
+      {
+	float px = 0;
+	float ph = 0;
+
+	for (i = 0; ncomponents > i; ++i)
+	  {
+	    const HBondComponent &c = components[i];
+	    float d0 = f0[j] - c.mean[0];
+	    float d1 = f1[j] - c.mean[1];
+	    float d2 = f2[j] - c.mean[2];
+	    float tmp;
+	    float prob;
+
+	    tmp = exp ((d0 * d0 * c.square[0] + d1 * d1 * c.square[1] + d2 * d2 * c.square[2]
+			+ d0 * d1 * c.cross[0] + d0 * d2 * c.cross[1] + d1 * d2 * c.cross[2]) * -0.5f);
+	    prob = isnan (tmp) ? 0 : c.scale * tmp;
+	    px += prob;
+	    ph += c.probH * prob;
+	  }
+	out[j] = ph / px;
+      }
+#endif
+  }
+
+
+  HBondBatch::size_type
+  HBondBatch::push_back (const Vector3D &donor, const Vector3D &hydrogen, const Vector3D &acceptor, const Vector3D &lonepair)
+  {
+    donorX.push_back (donor.getX ());
+    donorY.push_back (donor.getY ());
+    donorZ.push_back (donor.getZ ());
+    hydrogenX.push_back (hydrogen.getX ());
+    hydrogenY.push_back (hydrogen.getY ());
+    hydrogenZ.push_back (hydrogen.getZ ());
+    acceptorX.push_back (acceptor.getX ());
+    acceptorY.push_back (acceptor.getY ());
+    acceptorZ.push_back (acceptor.getZ ());
+    lonePairX.push_back (lonepair.getX ());
+    lonePairY.push_back (lonepair.getY ());
+    lonePairZ.push_back (lonepair.getZ ());
+    return donorX.size () - 1;
+  }
+
+
+  void
+  HBondBatch::reserve (size_type n)
+  {
+    donorX.reserve (n);
+    donorY.reserve (n);
+    donorZ.reserve (n);
+    hydrogenX.reserve (n);
+    hydrogenY.reserve (n);
+    hydrogenZ.reserve (n);
+    acceptorX.reserve (n);
+    acceptorY.reserve (n);
+    acceptorZ.reserve (n);
+    lonePairX.reserve (n);
+    lonePairY.reserve (n);
+    lonePairZ.reserve (n);
+  }
+
+
+  void
+  HBondBatch::clear ()
+  {
+    donorX.clear ();
+    donorY.clear ();
+    donorZ.clear ();
+    hydrogenX.clear ();
+    hydrogenY.clear ();
+    hydrogenZ.clear ();
+    acceptorX.clear ();
+    acceptorY.clear ();
+    acceptorZ.clear ();
+    lonePairX.clear ();
+    lonePairY.clear ();
+    lonePairZ.clear ();
+    values.clear ();
+  }
+
+
+  const HBondComponent*
+  HBondBatch::foldComponents ()
+  {
+    static HBondComponent components[HBond::sNbGauss];
+    int k;
+
+    for (k = 0; HBond::sNbGauss > k; ++k)
+      {
+	HBondComponent &c = components[k];
+
+	c.mean[0] = HBond::sMean[k][0];
+	c.mean[1] = HBond::sMean[k][1];
+	c.mean[2] = HBond::sMean[k][2];
+	c.square[0] = HBond::sCovarInv[k][0][0];
+	c.square[1] = HBond::sCovarInv[k][1][1];
+	c.square[2] = HBond::sCovarInv[k][2][2];
+	c.cross[0] = HBond::sCovarInv[k][0][1] + HBond::sCovarInv[k][1][0];
+	c.cross[1] = HBond::sCovarInv[k][0][2] + HBond::sCovarInv[k][2][0];
+	c.cross[2] = HBond::sCovarInv[k][1][2] + HBond::sCovarInv[k][2][1];
+	c.scale = (fabs (HBond::sCovarDet[k]) < 0.0005
+		   ? 0
+		   : HBond::sWeight[k] / (pow (2 * M_PI, 1.5) * sqrt (HBond::sCovarDet[k])));
+	c.probH = HBond::sProbH[k];
+      }
+    return components;
+  }
+
+
+  void
+  HBondBatch::evalStatistically ()
+  {
+    static const HBondComponent *components = foldComponents ();
+    vector< size_type > kept;
+    vector< float > f0;
+    vector< float > f1;
+    vector< float > f2;
+    vector< float > scores;
+    size_type i;
+
+    values.assign (size (), 0);
+    for (i = 0; size () > i; ++i)
+      {
+	float dx = donorX[i] - acceptorX[i];
+	float dy = donorY[i] - acceptorY[i];
+	float dz = donorZ[i] - acceptorZ[i];
+	float hx;
+	float hy;
+	float hz;
+
+	// PreCheck on the donor/acceptor distance
+	if (dx * dx + dy * dy + dz * dz > 25)
+	  {
+	    continue;
+	  }
+	hx = hydrogenX[i] - lonePairX[i];
+	hy = hydrogenY[i] - lonePairY[i];
+	hz = hydrogenZ[i] - lonePairZ[i];
+	kept.push_back (i);
+	f0.push_back (1.5f * log (hx * hx + hy * hy + hz * hz));
+	f1.push_back (atanh (cosine (donorX[i], donorY[i], donorZ[i],
+				     hydrogenX[i], hydrogenY[i], hydrogenZ[i],
+				     acceptorX[i], acceptorY[i], acceptorZ[i])));
+	f2.push_back (atanh (cosine (acceptorX[i], acceptorY[i], acceptorZ[i],
+				     donorX[i], donorY[i], donorZ[i],
+				     lonePairX[i], lonePairY[i], lonePairZ[i])));
+      }
+    if (kept.empty ())
+      {
+	return;
+      }
+    while (0 != f0.size () % 4)
+      {
+	f0.push_back (0);
+	f1.push_back (0);
+	f2.push_back (0);
+      }
+    scores.resize (f0.size ());
+    evalMixture (components, HBond::sNbGauss, &f0[0], &f1[0], &f2[0], f0.size (), &scores[0]);
+    for (i = 0; kept.size () > i; ++i)
+      {
+	values[kept[i]] = scores[i];
+      }
+  }
+
+}
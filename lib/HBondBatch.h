@@ -0,0 +1,175 @@
+//                              -*- Mode: C++ -*-
+// HBondBatch.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:23:18 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_HBondBatch_h_
+#define _mccore_HBondBatch_h_
+
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  class Vector3D;
+  struct HBondComponent;
+
+
+
+  /**
+   * @short Batch statistical evaluation of hydrogen bonds.
+   *
+   * The batch holds candidate hydrogen bonds as donor, hydrogen, acceptor
+   * and lone pair coordinates in separate arrays, so that the candidates
+   * of a residue pair, or of a whole model, are scored in one pass.  The
+   * score is the Gaussian mixture model of HBond::evalStatistically: the
+   * candidates whose donor and acceptor are farther than 5 angstroms are
+   * dropped with a squared distance test, the features of the others are
+   * computed from the coordinates and the mixture is evaluated four
+   * candidates at a time with SSE2 when available, with the inverse
+   * covariances and the normalizers of the components folded beforehand.
+   * The scores agree with HBond::evalStatistically to rounding errors.
+   * The C5M donors must be given the hydrogen of HBond::methylHydrogen.
+   */
+  class HBondBatch
+  {
+  public:
+
+    typedef vector< float >::size_type size_type;
+
+  private:
+
+    /**
+     * The donor coordinates.
+     */
+    vector< float > donorX;
+    vector< float > donorY;
+    vector< float > donorZ;
+
+    /**
+     * The hydrogen coordinates.
+     */
+    vector< float > hydrogenX;
+    vector< float > hydrogenY;
+    vector< float > hydrogenZ;
+
+    /**
+     * The acceptor coordinates.
+     */
+    vector< float > acceptorX;
+    vector< float > acceptorY;
+    vector< float > acceptorZ;
+
+    /**
+     * The lone pair coordinates.
+     */
+    vector< float > lonePairX;
+    vector< float > lonePairY;
+    vector< float > lonePairZ;
+
+    /**
+     * The scores of the last evaluation.
+     */
+    vector< float > values;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes an empty batch.
+     */
+    HBondBatch () { }
+
+    /**
+     * Destroys the object.
+     */
+    ~HBondBatch () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of candidates.
+     * @return the number of candidates.
+     */
+    size_type size () const { return donorX.size (); }
+
+    /**
+     * Tells if the batch is empty.
+     * @return whether there is no candidate.
+     */
+    bool empty () const { return donorX.empty (); }
+
+    /**
+     * Gets the score of a candidate after evalStatistically.
+     * @param i the candidate index.
+     * @return the score between 0 and 1, NaN when no mixture component
+     * explains the geometry, as HBond::evalStatistically.
+     */
+    float getValue (size_type i) const { return values[i]; }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Adds a candidate.
+     * @param donor the donor atom.
+     * @param hydrogen the hydrogen bonded to the donor.
+     * @param acceptor the acceptor atom.
+     * @param lonepair the lone pair of the acceptor.
+     * @return the candidate index.
+     */
+    size_type push_back (const Vector3D &donor, const Vector3D &hydrogen, const Vector3D &acceptor, const Vector3D &lonepair);
+
+    /**
+     * Reserves room for candidates.
+     * @param n the number of candidates.
+     */
+    void reserve (size_type n);
+
+    /**
+     * Removes the candidates.
+     */
+    void clear ();
+
+    /**
+     * Scores every candidate with the statistical model.
+     */
+    void evalStatistically ();
+
+  private:
+
+    /**
+     * Folds the mixture components of HBond into a static table.
+     * evalStatistically calls it once, through the initialization of a
+     * local static.
+     * @return the HBond::sNbGauss components.
+     */
+    static const HBondComponent* foldComponents ();
+
+  };
+
+}
+
+#endif
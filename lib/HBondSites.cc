@@ -0,0 +1,99 @@
+//                              -*- Mode: C++ -*-
+// HBondSites.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:13:30 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include "Atom.h"
+#include "AtomSet.h"
+#include "AtomType.h"
+#include "HBondSites.h"
+#include "Residue.h"
+
+
+
+namespace mccore
+{
+  const float HBondSites::sBondDistMax = 1.7;
+
+
+  void
+  HBondSites::build (const Residue *r)
+  {
+    Residue::const_iterator i;
+    Residue::const_iterator j;
+    AtomSetAnd da (new AtomSetSideChain (),
+		   new AtomSetNot (new AtomSetOr (new AtomSetAtom (AtomType::a2H5M),
+						  new AtomSetAtom (AtomType::a3H5M))));
+    AtomSetOr as (new AtomSetSideChain (),
+		  new AtomSetOr (new AtomSetAtom (AtomType::aO2p),
+				 new AtomSetOr (new AtomSetAtom (AtomType::aO2P),
+						new AtomSetAtom (AtomType::aO1P))));
+    vector< const Atom* > lights;
+    vector< const Atom* >::const_iterator lIt;
+
+    clear ();
+    residue = r;
+    for (j = r->begin (da); r->end () != j; ++j)
+      {
+	if (j->getType ()->isHydrogen () || j->getType ()->isLonePair ())
+	  {
+	    lights.push_back (&*j);
+	  }
+      }
+    for (i = r->begin (da); r->end () != i; ++i)
+      {
+	if (i->getType ()->isCarbon ()
+	    || i->getType ()->isNitrogen ()
+	    || i->getType ()->isOxygen ())
+	  {
+	    for (lIt = lights.begin (); lights.end () != lIt; ++lIt)
+	      {
+		if (i->distance (**lIt) < sBondDistMax)
+		  {
+		    sites.push_back (Site (&*i, *lIt));
+		  }
+	      }
+	  }
+      }
+    for (i = r->begin (as); r->end () != i; ++i)
+      {
+	if (i->getType ()->isNitrogen ()
+	    || i->getType ()->isOxygen ()
+	    || i->getType ()->isBackbone ())
+	  {
+	    backbone.push_back (&*i);
+	  }
+      }
+  }
+
+
+  void
+  HBondSites::clear ()
+  {
+    residue = 0;
+    sites.clear ();
+    backbone.clear ();
+  }
+
+}
@@ -0,0 +1,187 @@
+//                              -*- Mode: C++ -*-
+// HBondSites.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:13:30 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_HBondSites_h_
+#define _mccore_HBondSites_h_
+
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  class Atom;
+  class Residue;
+
+
+
+  /**
+   * @short Hydrogen bond sites of a residue.
+   *
+   * The table lists, once per residue, the atoms that Relation tests for
+   * hydrogen bonds: the (heavy atom, hydrogen) donor sites and the (heavy
+   * atom, lone pair) acceptor sites used in the pairing annotation, and the
+   * polar atoms used in the backbone hydrogen bond annotation.  They are
+   * kept in residue order so that the annotation is the same as when the
+   * residue is scanned.  The table points to the atoms of the residue: it
+   * is a snapshot that must be rebuilt once the residue atoms are
+   * modified, moved, added or removed.  GraphModel::annotate builds one
+   * table per residue for each annotation pass.
+   */
+  class HBondSites
+  {
+  public:
+
+    /**
+     * @short A heavy atom bonded to a hydrogen or a lone pair.
+     */
+    struct Site
+    {
+      /**
+       * The donor or acceptor atom.
+       */
+      const Atom *heavy;
+
+      /**
+       * The hydrogen or lone pair.
+       */
+      const Atom *light;
+
+      /**
+       * Initializes the site.
+       * @param h the heavy atom.
+       * @param l the hydrogen or lone pair.
+       */
+      Site (const Atom *h, const Atom *l) : heavy (h), light (l) { }
+    };
+
+    typedef vector< Site >::const_iterator const_iterator;
+    typedef vector< const Atom* >::const_iterator backbone_const_iterator;
+
+    /**
+     * Maximum distance between a heavy atom and the hydrogens or lone
+     * pairs it bears.  Atoms closer than this are taken as bonded, both
+     * for the sites and in the Relation annotation.
+     */
+    static const float sBondDistMax;
+
+  private:
+
+    /**
+     * The residue of the sites.
+     */
+    const Residue *residue;
+
+    /**
+     * The donor and acceptor sites.
+     */
+    vector< Site > sites;
+
+    /**
+     * The side chain and phosphate/ribose atoms that may form a backbone
+     * hydrogen bond.
+     */
+    vector< const Atom* > backbone;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes an empty table.
+     */
+    HBondSites () : residue (0) { }
+
+    /**
+     * Initializes the table with the sites of a residue.
+     * @param r the residue.
+     */
+    explicit HBondSites (const Residue *r) : residue (0) { build (r); }
+
+    /**
+     * Destroys the object.
+     */
+    ~HBondSites () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the residue of the sites.
+     * @return the residue, 0 if the table was not built.
+     */
+    const Residue* getResidue () const { return residue; }
+
+    /**
+     * Gets an iterator on the first donor or acceptor site.
+     * @return the iterator.
+     */
+    const_iterator begin () const { return sites.begin (); }
+
+    /**
+     * Gets an iterator past the last donor or acceptor site.
+     * @return the iterator.
+     */
+    const_iterator end () const { return sites.end (); }
+
+    /**
+     * Gets the number of donor and acceptor sites.
+     * @return the number of sites.
+     */
+    vector< Site >::size_type size () const { return sites.size (); }
+
+    /**
+     * Gets an iterator on the first backbone hydrogen bond atom.
+     * @return the iterator.
+     */
+    backbone_const_iterator backbone_begin () const { return backbone.begin (); }
+
+    /**
+     * Gets an iterator past the last backbone hydrogen bond atom.
+     * @return the iterator.
+     */
+    backbone_const_iterator backbone_end () const { return backbone.end (); }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Replaces the table with the sites of a residue.  The donor and
+     * acceptor sites are the carbon, nitrogen and oxygen atoms of the side
+     * chain (methyl hydrogens excluded) paired with each hydrogen or lone
+     * pair closer than the covalent cutoff.
+     * @param r the residue.
+     */
+    void build (const Residue *r);
+
+    /**
+     * Empties the table.
+     */
+    void clear ();
+
+  };
+
+}
+
+#endif
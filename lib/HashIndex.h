@@ -0,0 +1,303 @@
+//                              -*- Mode: C++ -*-
+// HashIndex.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:51:38 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_HashIndex_h_
+#define _mccore_HashIndex_h_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * Mixes the bits of a word so that the low bits of the result depend on
+   * all the bits of the input.
+   * @param x the word.
+   * @return the mixed word.
+   */
+  inline size_t
+  hashMix (size_t x)
+  {
+    x ^= x >> 16;
+    x *= 0x45d9f3bUL;
+    x ^= x >> 16;
+    x *= 0x45d9f3bUL;
+    x ^= x >> 16;
+    return x;
+  }
+
+  /**
+   * Hash function object on the address of an object.
+   */
+  struct PointerHash
+  {
+    size_t operator() (const void *p) const
+    {
+      size_t x = (size_t) p;
+
+      return hashMix (x ^ (x >> 4));
+    }
+  };
+
+  /**
+   * Hash function object on pairs of integral values.
+   */
+  struct PairHash
+  {
+    template< class T >
+    size_t operator() (const pair< T, T > &p) const
+    {
+      return hashMix ((size_t) p.first * 0x9e3779b1UL ^ hashMix ((size_t) p.second));
+    }
+  };
+
+  
+  
+  /**
+   * @short Open addressing hash table from keys to values.
+   *
+   * The table uses linear probing over a power of two number of slots and
+   * is kept at most half full.  Erasures shift the following entries of the
+   * probe sequence back, so there are no tombstones and lookups stay short
+   * whatever the history of the table.  The keys must be default
+   * constructible and comparable with operator==.
+   */
+  template< class K, class T, class H >
+  class HashIndex
+  {
+  public:
+
+    typedef typename vector< K >::size_type size_type;
+
+  private:
+
+    /**
+     * The keys of the slots.
+     */
+    vector< K > keys;
+
+    /**
+     * The values of the slots.
+     */
+    vector< T > values;
+
+    /**
+     * The occupied slot flags.
+     */
+    vector< char > used;
+
+    /**
+     * The number of entries.
+     */
+    size_type count;
+
+    /**
+     * The hash function.
+     */
+    H hasher;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the object.
+     */
+    HashIndex () : count (0) { }
+
+    /**
+     * Destroys the object.
+     */
+    ~HashIndex () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of entries.
+     * @return the number of entries.
+     */
+    size_type size () const { return count; }
+
+    /**
+     * Tells if the table is empty.
+     * @return whether there is no entry.
+     */
+    bool empty () const { return 0 == count; }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Removes every entry and frees the slots.
+     */
+    void clear ()
+    {
+      vector< K > ().swap (keys);
+      vector< T > ().swap (values);
+      vector< char > ().swap (used);
+      count = 0;
+    }
+
+    /**
+     * Makes room for n entries without growing.
+     * @param n the number of entries.
+     */
+    void reserve (size_type n)
+    {
+      size_type capacity;
+
+      for (capacity = 8; capacity < 2 * n; capacity *= 2);
+      if (capacity > keys.size ())
+	{
+	  rehash (capacity);
+	}
+    }
+
+    /**
+     * Finds the value associated to a key.
+     * @param k the key.
+     * @return a pointer to the value or 0 if the key is absent.
+     */
+    const T* find (const K &k) const
+    {
+      size_type mask;
+      size_type i;
+
+      if (0 == count)
+	{
+	  return 0;
+	}
+      mask = keys.size () - 1;
+      for (i = hasher (k) & mask; used[i]; i = (i + 1) & mask)
+	{
+	  if (keys[i] == k)
+	    {
+	      return &values[i];
+	    }
+	}
+      return 0;
+    }
+
+    /**
+     * Associates a value to a key, replacing the previous value if any.
+     * @param k the key.
+     * @param v the value.
+     */
+    void insert (const K &k, const T &v)
+    {
+      size_type mask;
+      size_type i;
+
+      if (2 * (count + 1) > keys.size ())
+	{
+	  rehash (keys.empty () ? 8 : 2 * keys.size ());
+	}
+      mask = keys.size () - 1;
+      for (i = hasher (k) & mask; used[i]; i = (i + 1) & mask)
+	{
+	  if (keys[i] == k)
+	    {
+	      values[i] = v;
+	      return;
+	    }
+	}
+      keys[i] = k;
+      values[i] = v;
+      used[i] = true;
+      ++count;
+    }
+
+    /**
+     * Removes a key from the table.
+     * @param k the key.
+     * @return whether the key was present.
+     */
+    bool erase (const K &k)
+    {
+      size_type mask;
+      size_type i;
+      size_type j;
+
+      if (0 == count)
+	{
+	  return false;
+	}
+      mask = keys.size () - 1;
+      for (i = hasher (k) & mask; used[i] && ! (keys[i] == k); i = (i + 1) & mask);
+      if (! used[i])
+	{
+	  return false;
+	}
+      // Shifts back the entries whose probe sequence crosses the hole.
+      for (j = (i + 1) & mask; used[j]; j = (j + 1) & mask)
+	{
+	  size_type home = hasher (keys[j]) & mask;
+
+	  if (((j - home) & mask) >= ((j - i) & mask))
+	    {
+	      keys[i] = keys[j];
+	      values[i] = values[j];
+	      i = j;
+	    }
+	}
+      used[i] = false;
+      --count;
+      return true;
+    }
+
+  private:
+
+    /**
+     * Moves the entries to a table of the given number of slots.
+     * @param capacity the new number of slots, a power of two.
+     */
+    void rehash (size_type capacity)
+    {
+      vector< K > oldKeys (capacity);
+      vector< T > oldValues (capacity);
+      vector< char > oldUsed (capacity, false);
+      size_type i;
+
+      keys.swap (oldKeys);
+      values.swap (oldValues);
+      used.swap (oldUsed);
+      count = 0;
+      for (i = 0; oldUsed.size () > i; ++i)
+	{
+	  if (oldUsed[i])
+	    {
+	      insert (oldKeys[i], oldValues[i]);
+	    }
+	}
+    }
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+//                              -*- Mode: C++ -*-
+// InvertedRelation.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 08:02:37 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include "InvertedRelation.h"
+#include "PropertyType.h"
+
+
+
+namespace mccore
+{
+
+  InvertedRelation::InvertedRelation (const Relation *forward)
+    : Relation (),
+      forward (forward),
+      swappedFaces (0)
+  {
+    vector< const PropertyType* > lt;
+    vector< const PropertyType* >::const_iterator it;
+
+    ref = forward->getRes ();
+    res = forward->getRef ();
+    refFace = forward->getResFace ();
+    resFace = forward->getRefFace ();
+    type_aspb = forward->getAnnotationType ();
+    sum_flow = forward->getFlowSum ();
+    forward->getLabelBits ().toVector (lt);
+    for (it = lt.begin (); lt.end () != it; ++it)
+      {
+	labels.insert (PropertyType::invert (*it));
+      }
+  }
+
+
+  InvertedRelation::~InvertedRelation ()
+  {
+    delete swappedFaces;
+  }
+
+
+  const vector< pair< const PropertyType*, const PropertyType* > >&
+  InvertedRelation::getPairedFaces () const
+  {
+    vector< pair< const PropertyType*, const PropertyType* > > *faces = swappedFaces;
+    vector< pair< const PropertyType*, const PropertyType* > >::iterator it;
+
+    if (0 != faces)
+      {
+	__sync_synchronize ();
+	return *faces;
+      }
+
+    // Racing threads build the same faces, the first one stored is kept.
+    faces = new vector< pair< const PropertyType*, const PropertyType* > > (forward->getPairedFaces ());
+    for (it = faces->begin (); faces->end () != it; ++it)
+      {
+	swap (it->first, it->second);
+      }
+    if (! __sync_bool_compare_and_swap (&swappedFaces, (vector< pair< const PropertyType*, const PropertyType* > >*) 0, faces))
+      {
+	delete faces;
+	__sync_synchronize ();
+      }
+    return *swappedFaces;
+  }
+
+}
@@ -0,0 +1,133 @@
+//                              -*- Mode: C++ -*-
+// InvertedRelation.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 08:02:37 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_InvertedRelation_h_
+#define _mccore_InvertedRelation_h_
+
+#include <utility>
+#include <vector>
+
+#include "Relation.h"
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  class PropertyType;
+
+
+
+  /**
+   * @short The reverse direction of a relation, served from it.
+   *
+   * The view swaps the residues and the faces of the forward relation and
+   * inverts its labels, which are held inline.  The hydrogen bond flows
+   * are those of the forward relation, not a copy.  The swapped paired
+   * faces are built on first access and the transformations are computed
+   * from the residues on first access, as for any relation.
+   *
+   * The forward relation must outlive the view and must not be annotated,
+   * reset or read while the view exists.  The view itself is not to be
+   * modified: clone returns an independent Relation holding the same
+   * annotation.
+   */
+  class InvertedRelation : public Relation
+  {
+    /**
+     * The relation in the other direction.
+     */
+    const Relation *forward;
+
+    /**
+     * The paired faces of the forward relation swapped, or null until
+     * built on first access, see getPairedFaces.
+     */
+    mutable vector< pair< const PropertyType*, const PropertyType* > > *volatile swappedFaces;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the view.
+     * @param forward the relation in the other direction.
+     */
+    InvertedRelation (const Relation *forward);
+
+    /**
+     * Clones the view into an independent relation.
+     * @return a Relation holding the inverted annotation.
+     */
+    virtual Relation* clone () const { return new Relation (*this); }
+
+    /**
+     * Destroys the object.
+     */
+    virtual ~InvertedRelation ();
+
+  private:
+
+    /**
+     * Disallows copies, the views are created from their forward relation.
+     */
+    InvertedRelation (const InvertedRelation &other);
+
+    /**
+     * Disallows assignments.
+     */
+    InvertedRelation& operator= (const InvertedRelation &other);
+
+  public:
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the relation in the other direction.
+     * @return the forward relation.
+     */
+    const Relation* getForward () const { return forward; }
+
+    /**
+     * Gets the hbonds flow collection of the forward relation.
+     * @return the HBondFlow vector.
+     */
+    virtual const vector< HBondFlow >& getHBondFlows () const
+    {
+      return forward->getHBondFlows ();
+    }
+
+    /**
+     * Gets the pairing faces of the forward relation, swapped.  They are
+     * built on first access.  Concurrent calls on a const view are safe.
+     * @return the collection of pairing faces.
+     */
+    virtual const vector< pair< const PropertyType*, const PropertyType* > >& getPairedFaces () const;
+
+  };
+
+}
+
+#endif
@@ -60,6 +60,7 @@ namespace mccore
       {
 	residues.push_back (cit->clone ());
       }
+    reindex ();
   }
   
   
@@ -86,6 +87,7 @@ namespace mccore
 	    delete *it;
 	  }
 	residues.clear ();
+	residIndex.clear ();
 	AbstractModel::operator= (right);
 	AbstractModel::insert (right.begin (), right.end ());
       }
@@ -105,6 +107,7 @@ namespace mccore
 	    delete *it;
 	  }
 	residues.clear ();
+	residIndex.clear ();
 	AbstractModel::operator= (right);
 	AbstractModel::insert (right.begin (), right.end ());
       }
@@ -143,6 +146,7 @@ namespace mccore
     if (end () == (found = find (res.getResId ())))
     {
       found = this->residues.insert (this->residues.end (), this->residueFM->createResidue (res));
+      residIndex.insert (res.getResId (), residues.size () - 1);
     }
     else
     {
@@ -157,6 +161,7 @@ namespace mccore
   Model::iterator
   Model::erase (iterator pos)
   {
+    residIndex.erase (pos->getResId (), pos - begin ());
     delete &*pos;
     return iterator (residues.erase (pos));
   }
@@ -165,7 +170,8 @@ namespace mccore
   void
   Model::sort ()
   {
-    std::sort (residues.begin (), residues.end (), less_deref< Residue > ());
+    Algo::radixSortByResId (residues);
+    reindex ();
   }
   
   
@@ -179,6 +185,7 @@ namespace mccore
 	delete *it;
       }
     residues.clear ();    
+    residIndex.clear ();
   }
   
   
@@ -218,6 +225,7 @@ namespace mccore
 	    delete res;
 	  }
       }    
+    reindex ();
     return ips;
   }
   
@@ -258,6 +266,7 @@ namespace mccore
       // Optimized insertion that bypasses the copy: 
       residues.push_back (res); 
     }
+    reindex ();
     return ibs;
   }
   
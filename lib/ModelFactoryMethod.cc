@@ -42,9 +42,13 @@
 namespace mccore
 {
 
-  ModelFactoryMethod::ModelFactoryMethod (const ResidueFactoryMethod *fm)
+  ModelFactoryMethod::ModelFactoryMethod (const ResidueFactoryMethod *fm, bool pooled)
     : rFM (fm == 0 ? new ExtendedResidueFM () : fm->clone ())
   {
+    if (pooled)
+      {
+	rFM->setPooled (true);
+      }
   }
   
   
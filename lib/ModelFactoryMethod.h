@@ -40,7 +40,8 @@ namespace mccore
    * @short Abstract class for model factory methods.
    *
    * This class is used in Molecule to generate a given type of model on input
-   * methods.
+   * methods.  When pooled, each generated model allocates its residues,
+   * atoms and relations in its own arena (see ResidueFactoryMethod).
    *
    * @author Martin Larose (<a href="larosem@iro.umontreal.ca">larosem@iro.umontreal.ca</a>)
    * @version $Id: ModelFactoryMethod.h,v 1.6 2005-02-25 16:48:14 thibaup Exp $
@@ -61,8 +62,10 @@ namespace mccore
 
     /**
      * Initializes the object.
+     * @param fm the residue factory method (default is @ref ExtendedResidueFM).
+     * @param pooled whether the generated models allocate in arenas.
      */
-    ModelFactoryMethod (const ResidueFactoryMethod *fm = 0);
+    ModelFactoryMethod (const ResidueFactoryMethod *fm = 0, bool pooled = false);
 
     /**
      * Initializes the object with the right content.
@@ -160,8 +163,10 @@ namespace mccore
 
     /**
      * Initializes the object.
+     * @param fm the residue factory method (default is @ref ExtendedResidueFM).
+     * @param pooled whether the generated models allocate in arenas.
      */
-    ModelFM (const ResidueFactoryMethod *fm = 0) : ModelFactoryMethod (fm) { }
+    ModelFM (const ResidueFactoryMethod *fm = 0, bool pooled = false) : ModelFactoryMethod (fm, pooled) { }
 
     /**
      * Initializes the object with the right content.
@@ -230,8 +235,10 @@ namespace mccore
 
     /**
      * Initializes the object.
+     * @param fm the residue factory method (default is @ref ExtendedResidueFM).
+     * @param pooled whether the generated models allocate in arenas.
      */
-    GraphModelFM (const ResidueFactoryMethod *fm = 0) : ModelFactoryMethod (fm) { }
+    GraphModelFM (const ResidueFactoryMethod *fm = 0, bool pooled = false) : ModelFactoryMethod (fm, pooled) { }
 
     /**
      * Initializes the object with the right content.
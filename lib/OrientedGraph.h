@@ -149,20 +149,16 @@ namespace mccore
     virtual list< V > inNeighborhood (const V &v)
     {
       list< V > res;
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      if (this->v2vlabel.end () != (it = this->v2vlabel.find (&v)))
+      if (this->lookupVertex (v, l))
 	{
-	  typename EV2ELabel::const_iterator evit;
-	  label l;
+	  const vector< label > &adj = this->inAdjacency[l];
+	  typename vector< label >::const_iterator lit;
 
-	  l = it->second;
-	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
+	  for (lit = adj.begin (); adj.end () != lit; ++lit)
 	    {
-	      if (evit->first.getTailLabel () == l)
-		{
-		  res.push_back (this->vertices[evit->first.getHeadLabel ()]);
-		}
+	      res.push_back (this->vertices[*lit]);
 	    }
 	}
       return res;
@@ -178,20 +174,16 @@ namespace mccore
     virtual list< V > outNeighborhood (const V &v)
     {
       list< V > res;
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      if (this->v2vlabel.end () != (it = this->v2vlabel.find (&v)))
+      if (this->lookupVertex (v, l))
 	{
-	  typename EV2ELabel::const_iterator evit;
-	  label l;
+	  const vector< label > &adj = this->outAdjacency[l];
+	  typename vector< label >::const_iterator lit;
 
-	  l = it->second;
-	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit && evit->first.getHeadLabel () <= l; ++evit)
+	  for (lit = adj.begin (); adj.end () != lit; ++lit)
 	    {
-	      if (evit->first.getHeadLabel () == l)
-		{
-		  res.push_back (this->vertices[evit->first.getTailLabel ()]);
-		}
+	      res.push_back (this->vertices[*lit]);
 	    }
 	}
       return res;
@@ -206,21 +198,9 @@ namespace mccore
      */
     virtual list< label > internalInNeighborhood (label l) const 
     {
-      list< label > res;
-
-      if (this->vertices.size () > l)
-	{
-	  typename EV2ELabel::const_iterator evit;
+      const vector< label > &adj = this->internalInAdjacency (l);
 
-	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
-	    {
-	      if (evit->first.getTailLabel () == l)
-		{
-		  res.push_back (evit->first.getHeadLabel ());
-		}
-	    }
-	}
-      return res;
+      return list< label > (adj.begin (), adj.end ());
     }	  
     
     /**
@@ -232,21 +212,9 @@ namespace mccore
      */
     virtual list< label > internalOutNeighborhood (label l) const
     {
-      list< label > res;
+      const vector< label > &adj = this->internalOutAdjacency (l);
 
-      if (this->vertices.size () > l)
-	{
-	  typename EV2ELabel::const_iterator evit;
-
-	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit && evit->first.getHeadLabel () <= l; ++evit)
-	    {
-	      if (evit->first.getHeadLabel () == l)
-		{
-		  res.push_back (evit->first.getTailLabel ());
-		}
-	    }
-	}
-      return res;
+      return list< label > (adj.begin (), adj.end ());
     }	  
 
     /**
@@ -286,46 +254,11 @@ namespace mccore
      */
     virtual iterator uncheckedInternalErase (label l)
     {
-      list< label > outNeighbors = internalOutNeighborhood (l);
-      list< label > inNeighbors = internalInNeighborhood (l);
-      typename list< label >::iterator lit;
-      iterator res;
-      typename EV2ELabel::iterator evit;
-      EV2ELabel newEV2;
-      
-      for (lit = outNeighbors.begin (); outNeighbors.end () != lit; ++lit)
-	{
-	  uncheckedInternalDisconnect (l, *lit);
-	}
-      for (lit = inNeighbors.begin (); inNeighbors.end () != lit; ++lit)
-	{
-	  uncheckedInternalDisconnect (*lit, l);
-	}
-      res = this->vertices.erase (this->vertices.begin () + l);
-      this->vertexWeights.erase (this->vertexWeights.begin () + l);
-      this->rebuildV2VLabel ();
-	  
-      for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
-	{
-	  label h;
-	  label t;
-	  
-	  h = evit->first.getHeadLabel ();
-	  t = evit->first.getTailLabel ();
-	  if (h > l)
-	    {
-	      --h;
-	    }
-	  if (t > l)
-	    {
-	      --t;
-	    }
-	  
-	  EndVertices ev (h, t);
-	  newEV2.insert (make_pair (ev, evit->second));
-	}
-      this->ev2elabel = newEV2;
-      return res;
+      vector< bool > marks (this->vertices.size (), false);
+
+      marks[l] = true;
+      this->uncheckedInternalEraseMarked (marks);
+      return this->vertices.begin () + l;
     }
 
     /**
@@ -344,6 +277,7 @@ namespace mccore
       if (this->ev2elabel.end () == (evit = this->ev2elabel.find (ev)))
 	{
 	  this->ev2elabel.insert (make_pair (ev, this->edges.size ()));
+	  this->adjacencyInsert (h, t, this->edges.size ());
 	  this->edges.push_back (e);
 	  this->edgeWeights.resize (this->edgeWeights.size () + 1);
 	  return true;
@@ -368,6 +302,7 @@ namespace mccore
       if (this->ev2elabel.end () == (evit = this->ev2elabel.find (ev)))
 	{
 	  this->ev2elabel.insert (make_pair (ev, this->edges.size ()));
+	  this->adjacencyInsert (h, t, this->edges.size ());
 	  this->edges.push_back (e);
 	  this->edgeWeights.push_back (w);
 	  return true;
@@ -395,6 +330,7 @@ namespace mccore
 	  this->edges.erase (this->edges.begin () + l);
 	  this->edgeWeights.erase (this->edgeWeights.begin () + l);
 	  this->ev2elabel.erase (evit);
+	  this->adjacencyErase (h, t);
 	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
 	    {
 	      if (evit->second > l)
@@ -402,6 +338,7 @@ namespace mccore
 		  --evit->second;
 		}
 	    }
+	  this->rebuildEdgeHash ();
 	  return true;
 	}
       return false;
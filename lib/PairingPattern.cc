@@ -45,6 +45,9 @@ namespace mccore
 
   list< PairingPattern > PairingPattern::patterns;
   bool PairingPattern::isInit = false;
+  map< PairingPattern::IndexKey, PairingPattern::IndexBucket > PairingPattern::index;
+  vector< const ResidueType* > PairingPattern::residueClasses;
+  map< pair< const AtomType*, const AtomType* >, unsigned int > PairingPattern::bondBits;
 
 
   const PairingPattern&
@@ -58,6 +61,7 @@ namespace mccore
 	AtoB = other.AtoB;
 	BtoA = other.BtoA;
 	msize = other.msize;
+	signature = other.signature;
 	baseOrientation = other.baseOrientation;
       }
     return *this;
@@ -73,6 +77,106 @@ namespace mccore
     if (! ignore)
       {
 	msize++;
+	signature |= bondBit (donor, acceptor, true);
+      }
+  }
+
+
+  unsigned int
+  PairingPattern::bondBit (const AtomType *donor, const AtomType *acceptor, bool create)
+  {
+    map< pair< const AtomType*, const AtomType* >, unsigned int >::iterator it;
+    pair< const AtomType*, const AtomType* > key (donor, acceptor);
+
+    if (bondBits.end () == (it = bondBits.find (key)))
+      {
+	if (! create)
+	  {
+	    return 0;
+	  }
+	it = bondBits.insert (make_pair (key, 1u << (bondBits.size () % 32))).first;
+      }
+    return it->second;
+  }
+
+
+  void
+  PairingPattern::buildIndex ()
+  {
+    list< PairingPattern >::const_iterator it;
+    unsigned int ordinal;
+
+    index.clear ();
+    residueClasses.clear ();
+    for (it = patterns.begin (), ordinal = 0; patterns.end () != it; ++it, ++ordinal)
+      {
+	IndexKey key (it->baseOrientation, make_pair (it->typeA, it->typeB));
+
+	index[key].push_back (make_pair (ordinal, &*it));
+	if (residueClasses.end () == find (residueClasses.begin (), residueClasses.end (), it->typeA))
+	  {
+	    residueClasses.push_back (it->typeA);
+	  }
+	if (residueClasses.end () == find (residueClasses.begin (), residueClasses.end (), it->typeB))
+	  {
+	    residueClasses.push_back (it->typeB);
+	  }
+      }
+  }
+
+
+  void
+  PairingPattern::candidatePatterns (const Residue *ra, const Residue *rb, const PropertyType *bpori, const list< HBondFlow > &hbf, unsigned int max_size, vector< const PairingPattern* > &candidates)
+  {
+    vector< const ResidueType* >::const_iterator ca;
+    vector< const ResidueType* >::const_iterator cb;
+    list< HBondFlow >::const_iterator fit;
+    IndexBucket found;
+    IndexBucket::const_iterator bit;
+    unsigned int present = 0;
+
+    patternList ();
+    candidates.clear ();
+    for (fit = hbf.begin (); hbf.end () != fit; ++fit)
+      {
+	present |= bondBit (fit->hbond.getDonorType (), fit->hbond.getAcceptorType (), false);
+      }
+    for (ca = residueClasses.begin (); residueClasses.end () != ca; ++ca)
+      {
+	if (! ra->getType ()->is (*ca))
+	  {
+	    continue;
+	  }
+	for (cb = residueClasses.begin (); residueClasses.end () != cb; ++cb)
+	  {
+	    map< IndexKey, IndexBucket >::const_iterator mit;
+
+	    if (! rb->getType ()->is (*cb))
+	      {
+		continue;
+	      }
+	    mit = index.find (IndexKey (bpori, make_pair (*ca, *cb)));
+	    if (index.end () != mit)
+	      {
+		found.insert (found.end (), mit->second.begin (), mit->second.end ());
+	      }
+	    if (*ca != *cb
+		&& index.end () != (mit = index.find (IndexKey (bpori, make_pair (*cb, *ca)))))
+	      {
+		found.insert (found.end (), mit->second.begin (), mit->second.end ());
+	      }
+	  }
+      }
+    sort (found.begin (), found.end ());
+    found.erase (unique (found.begin (), found.end ()), found.end ());
+    for (bit = found.begin (); found.end () != bit; ++bit)
+      {
+	const PairingPattern *pat = bit->second;
+
+	if (max_size >= pat->msize && 0 == (pat->signature & ~present))
+	  {
+	    candidates.push_back (pat);
+	  }
       }
   }
 
@@ -762,6 +866,7 @@ namespace mccore
     pat.addBond (pat.getAtoB (), AtomType::aN4, AtomType::a2H4, AtomType::aO2, AtomType::a2LP2);
     patterns.push_back (pat);
 
+    buildIndex ();
   };
   
   
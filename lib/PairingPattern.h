@@ -29,6 +29,8 @@
 
 #include <iostream>
 #include <list>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "HBond.h"
@@ -124,12 +126,38 @@ namespace mccore
        * The number of non ignored descriptions.
        */
       unsigned int msize;
+
+      /**
+       * The bits of the donor/acceptor pairs of the non ignored
+       * descriptions.
+       */
+      unsigned int signature;
       
       /**
        * The patterns.
        */
       static list< PairingPattern > patterns;
 
+      typedef pair< const PropertyType*, pair< const ResidueType*, const ResidueType* > > IndexKey;
+
+      typedef vector< pair< unsigned int, const PairingPattern* > > IndexBucket;
+
+      /**
+       * The patterns in list order, grouped by base orientation and
+       * residue types.
+       */
+      static map< IndexKey, IndexBucket > index;
+
+      /**
+       * The residue types used by the patterns.
+       */
+      static vector< const ResidueType* > residueClasses;
+
+      /**
+       * The signature bits of the donor/acceptor atom type pairs.
+       */
+      static map< pair< const AtomType*, const AtomType* >, unsigned int > bondBits;
+
       /**
        *
        */
@@ -140,7 +168,7 @@ namespace mccore
       /**
        * Initializes the object.
        */
-      PairingPattern () : name (0), typeA (0), typeB (0), baseOrientation (0), msize (0) { }
+      PairingPattern () : name (0), typeA (0), typeB (0), baseOrientation (0), msize (0), signature (0) { }
 
     public:
 
@@ -151,7 +179,7 @@ namespace mccore
        * @param type_b the type of another residue.
        */
       PairingPattern (const PropertyType *id, const ResidueType *type_a, const ResidueType *type_b, const PropertyType *ori)
-	: name (id), typeA (type_a), typeB (type_b), baseOrientation (ori), msize (0)
+	: name (id), typeA (type_a), typeB (type_b), baseOrientation (ori), msize (0), signature (0)
       { }
 
       /**
@@ -165,7 +193,8 @@ namespace mccore
 	  baseOrientation (other.baseOrientation),
 	  AtoB (other.AtoB),
 	  BtoA (other.BtoA),
-	  msize (other.msize)
+	  msize (other.msize),
+	  signature (other.signature)
       { }
 
       /**
@@ -238,6 +267,39 @@ namespace mccore
        */
       unsigned int size () const { return msize; }
 
+      /**
+       * Gets the patterns that may match a pairing, in list order.  The
+       * patterns are looked up by base orientation and residue types, and
+       * those whose size exceeds max_size or whose donor/acceptor pairs
+       * are not all found in the flows are skipped.  The candidates must
+       * still be tested with evaluate.
+       * @param ra a residue.
+       * @param rb the other residue.
+       * @param bpori base pair orientation (para or anti).
+       * @param hbf the HBondFlow list.
+       * @param max_size the largest pattern size.
+       * @param candidates the vector receiving the patterns.
+       */
+      static void candidatePatterns (const Residue *ra, const Residue *rb, const PropertyType *bpori, const list< HBondFlow > &hbf, unsigned int max_size, vector< const PairingPattern* > &candidates);
+
+    private:
+
+      /**
+       * Gets the signature bit of a donor/acceptor atom type pair.
+       * @param donor the donor atom type.
+       * @param acceptor the acceptor atom type.
+       * @param create whether a new pair is given a bit.
+       * @return the bit or 0 if the pair is not used by the patterns.
+       */
+      static unsigned int bondBit (const AtomType *donor, const AtomType *acceptor, bool create);
+
+      /**
+       * Builds the pattern index from the pattern list.
+       */
+      static void buildIndex ();
+
+    public:
+
       // METHODS --------------------------------------------------------------
 
       /**
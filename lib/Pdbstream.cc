@@ -58,12 +58,26 @@ namespace mccore
   void
   Pdbstream::init ()
   {
-    if (0 == Pdbstream::pdbAtomTypeParseTable)
+    Pdbstream::init (Pdbstream::PDB);
+    Pdbstream::init (Pdbstream::AMBER);
+  }    
+
+
+  void
+  Pdbstream::init (unsigned int type)
+  {
+    if (Pdbstream::AMBER == type)
+      {
+	if (0 == Pdbstream::amberAtomTypeParseTable)
+	  {
+	    Pdbstream::amberAtomTypeParseTable = new AmberAtomTypeRepresentationTable ();
+	    Pdbstream::amberResidueTypeParseTable = new AmberResidueTypeRepresentationTable ();
+	  }
+      }
+    else if (0 == Pdbstream::pdbAtomTypeParseTable)
       {
 	Pdbstream::pdbAtomTypeParseTable = new PdbAtomTypeRepresentationTable ();
-	Pdbstream::amberAtomTypeParseTable = new AmberAtomTypeRepresentationTable ();
 	Pdbstream::pdbResidueTypeParseTable = new PdbResidueTypeRepresentationTable ();
-	Pdbstream::amberResidueTypeParseTable = new AmberResidueTypeRepresentationTable ();
       }
   }    
 
@@ -73,7 +87,7 @@ namespace mccore
   {
     string key (str);
 
-    Pdbstream::init ();
+    Pdbstream::init (type);
     if (Pdbstream::PDB == type)
       return Pdbstream::pdbResidueTypeParseTable->parseType (key);
     else if (Pdbstream::AMBER == type)
@@ -91,7 +105,7 @@ namespace mccore
   const char*
   Pdbstream::stringifyResidueType (const ResidueType* rtype, unsigned int type)
   {
-    Pdbstream::init ();
+    Pdbstream::init (type);
     if (Pdbstream::PDB == type)
       return Pdbstream::pdbResidueTypeParseTable->toString (rtype);
     else if (Pdbstream::AMBER == type)
@@ -109,7 +123,7 @@ namespace mccore
   const AtomType*
   Pdbstream::parseAtomType (const char* str, unsigned int type)
   {
-    Pdbstream::init ();
+    Pdbstream::init (type);
     string key (str);
     if (Pdbstream::PDB == type)
       return Pdbstream::pdbAtomTypeParseTable->parseType (key);
@@ -128,7 +142,7 @@ namespace mccore
   const char*
   Pdbstream::stringifyAtomType (const AtomType* rtype, unsigned int type)
   {
-    Pdbstream::init ();
+    Pdbstream::init (type);
     if (Pdbstream::PDB == type)
       return Pdbstream::pdbAtomTypeParseTable->toString (rtype);
     else if (Pdbstream::AMBER == type)
@@ -170,7 +184,7 @@ namespace mccore
       pdbType (Pdbstream::PDB),
       altloc (' ')
   {
-    Pdbstream::init ();
+    Pdbstream::init (Pdbstream::PDB);
     atomTypeParseTable = Pdbstream::pdbAtomTypeParseTable;
     residueTypeParseTable = Pdbstream::pdbResidueTypeParseTable;
   }
@@ -187,7 +201,7 @@ namespace mccore
       pdbType (Pdbstream::PDB),
       altloc (' ')
   {
-    Pdbstream::init ();
+    Pdbstream::init (Pdbstream::PDB);
     atomTypeParseTable = Pdbstream::pdbAtomTypeParseTable;
     residueTypeParseTable = Pdbstream::pdbResidueTypeParseTable;
   }
@@ -202,6 +216,7 @@ namespace mccore
   iPdbstream::setPDBType (unsigned int type)
   {
     pdbType = type;
+    Pdbstream::init (type);
     if (Pdbstream::AMBER == type)
       {
 	atomTypeParseTable = Pdbstream::amberAtomTypeParseTable;
@@ -472,7 +487,7 @@ namespace mccore
       atomCounter (1),
       pdbType (Pdbstream::PDB)
   {
-    Pdbstream::init ();
+    Pdbstream::init (Pdbstream::PDB);
     atomTypeParseTable = Pdbstream::pdbAtomTypeParseTable;
     residueTypeParseTable = Pdbstream::pdbResidueTypeParseTable;
   }
@@ -488,7 +503,7 @@ namespace mccore
       atomCounter (1),
       pdbType (Pdbstream::PDB)
   {
-    Pdbstream::init ();
+    Pdbstream::init (Pdbstream::PDB);
     atomTypeParseTable = Pdbstream::pdbAtomTypeParseTable;
     residueTypeParseTable = Pdbstream::pdbResidueTypeParseTable;
   }
@@ -503,7 +518,7 @@ namespace mccore
       atomCounter (1),
       pdbType (Pdbstream::PDB)
   {
-    Pdbstream::init ();
+    Pdbstream::init (Pdbstream::PDB);
     atomTypeParseTable = Pdbstream::pdbAtomTypeParseTable;
     residueTypeParseTable = Pdbstream::pdbResidueTypeParseTable;
   }
@@ -529,6 +544,7 @@ namespace mccore
   oPdbstream::setPDBType (unsigned int type)
   {
     pdbType = type;
+    Pdbstream::init (type);
     if (Pdbstream::AMBER == type)
       {
 	header_written = true;
@@ -94,6 +94,14 @@ namespace mccore
      */
     static void init ();
 
+    /**
+     * Initialises the representation tables of a format only.  Tables are
+     * built on first use so that a program reading Pdb files never pays
+     * for the Amber tables.
+     * @param type the table type (0 for PDB, 1 for Amber).
+     */
+    static void init (unsigned int type);
+
     /**
      * Uses specific type table to parse type string.
      * @param str the sring representation to parse.
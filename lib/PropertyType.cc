@@ -256,12 +256,13 @@ namespace mccore
   // LIFECYCLE -----------------------------------------------------------------
 
   PropertyType::PropertyType () 
+    : id (0)
   {
     
   }
 
   PropertyType::PropertyType (const string& ks)
-    : key (ks)
+    : key (ks), id (0)
   {
     
   }
@@ -296,6 +297,13 @@ namespace mccore
   }
 
 
+  const PropertyType*
+  PropertyType::getType (unsigned int id)
+  {
+    return ptstore.get (id);
+  }
+
+
   const PropertyType*
   PropertyType::invert (const PropertyType *t)
   {
@@ -29,6 +29,8 @@
 #include <iostream>
 #include <string>
 
+#include "PropertyTypeSet.h"
+
 using namespace std;
 
 
@@ -62,6 +64,21 @@ namespace mccore
      * The type key string.
      */
     string key;
+
+    /**
+     * The dense id given by the type store in registration order.
+     */
+    unsigned int id;
+
+    /**
+     * The registered types this type is same as or derived from.
+     */
+    PropertyTypeSet ancestors;
+
+    /**
+     * The registered types that are same as or derived from this type.
+     */
+    PropertyTypeSet descendants;
     
     // LIFECYCLE ------------------------------------------------------------
     
@@ -181,6 +198,42 @@ namespace mccore
     {
       return this->key;
     }
+
+    /**
+     * Gets the dense id of the type.  Ids are given in registration order,
+     * starting at 0.
+     * @return the id.
+     */
+    unsigned int getId () const
+    {
+      return this->id;
+    }
+
+    /**
+     * Gets the registered types this type is same as or derived from.
+     * @return the ancestor set.
+     */
+    const PropertyTypeSet& getAncestors () const
+    {
+      return this->ancestors;
+    }
+
+    /**
+     * Gets the registered types that are same as or derived from this
+     * type.
+     * @return the descendant set.
+     */
+    const PropertyTypeSet& getDescendants () const
+    {
+      return this->descendants;
+    }
+
+    /**
+     * Gets the property type of a dense id.
+     * @param id the dense id.
+     * @return the property type or 0 if no type has the id.
+     */
+    static const PropertyType* getType (unsigned int id);
     
     /**
      * Identifies the type of property stored in a string.
@@ -204,13 +257,15 @@ namespace mccore
     static const PropertyType* invert (const PropertyType *t);
     
     /**
-     * Tests whether the type this is same as or derived from t.
+     * Tests whether the type this is same as or derived from t.  The test
+     * is a lookup in the ancestor set computed with describe when the
+     * type was registered.
      * @param t the base type class.
      * @return true if this is same as or derived from t.
      */
     virtual bool is (const PropertyType *t) const
     {
-      return t->describe (this);
+      return this->ancestors.has (t);
     }
     
     /**
@@ -0,0 +1,336 @@
+//                              -*- Mode: C++ -*-
+// PropertyTypeSet.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:40:07 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#include <algorithm>
+#include <map>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#include "PropertyTypeSet.h"
+#include "PropertyType.h"
+
+
+
+namespace mccore
+{
+
+  const unsigned int PropertyTypeSet::DENSE_BITS;
+  const unsigned int PropertyTypeSet::WORD_BITS;
+  const unsigned int PropertyTypeSet::WORDS;
+
+
+  /**
+   * Orders the overflow types on their dense id.
+   */
+  static bool
+  lessId (const PropertyType *t1, const PropertyType *t2)
+  {
+    return t1->getId () < t2->getId ();
+  }
+
+
+  /**
+   * Counts the bits of a word.
+   */
+  static unsigned int
+  bitCount (PropertyTypeSet::word_type w)
+  {
+    unsigned int n;
+
+    for (n = 0; 0 != w; ++n)
+      {
+	w &= w - 1;
+      }
+    return n;
+  }
+
+
+  PropertyTypeSet::PropertyTypeSet ()
+    : overflow (0)
+  {
+    std::fill (words, words + WORDS, 0);
+  }
+
+
+  PropertyTypeSet::PropertyTypeSet (const PropertyTypeSet &other)
+    : overflow (0 == other.overflow ? 0 : new vector< const PropertyType* > (*other.overflow))
+  {
+    std::copy (other.words, other.words + WORDS, words);
+  }
+
+
+  PropertyTypeSet::~PropertyTypeSet ()
+  {
+    delete overflow;
+  }
+
+
+  PropertyTypeSet&
+  PropertyTypeSet::operator= (const PropertyTypeSet &other)
+  {
+    if (this != &other)
+      {
+	std::copy (other.words, other.words + WORDS, words);
+	if (0 == other.overflow)
+	  {
+	    delete overflow;
+	    overflow = 0;
+	  }
+	else if (0 == overflow)
+	  {
+	    overflow = new vector< const PropertyType* > (*other.overflow);
+	  }
+	else
+	  {
+	    *overflow = *other.overflow;
+	  }
+      }
+    return *this;
+  }
+
+
+  bool
+  PropertyTypeSet::operator== (const PropertyTypeSet &other) const
+  {
+    bool emptyOverflow = 0 == overflow || overflow->empty ();
+    bool otherEmptyOverflow = 0 == other.overflow || other.overflow->empty ();
+
+    if (! std::equal (words, words + WORDS, other.words))
+      {
+	return false;
+      }
+    if (emptyOverflow || otherEmptyOverflow)
+      {
+	return emptyOverflow && otherEmptyOverflow;
+      }
+    return *overflow == *other.overflow;
+  }
+
+
+  bool
+  PropertyTypeSet::empty () const
+  {
+    unsigned int i;
+
+    for (i = 0; WORDS > i; ++i)
+      {
+	if (0 != words[i])
+	  {
+	    return false;
+	  }
+      }
+    return 0 == overflow || overflow->empty ();
+  }
+
+
+  unsigned int
+  PropertyTypeSet::size () const
+  {
+    unsigned int i;
+    unsigned int n = 0;
+
+    for (i = 0; WORDS > i; ++i)
+      {
+	n += bitCount (words[i]);
+      }
+    return n + (0 == overflow ? 0 : overflow->size ());
+  }
+
+
+  bool
+  PropertyTypeSet::has (const PropertyType *t) const
+  {
+    unsigned int id = t->getId ();
+
+    if (DENSE_BITS > id)
+      {
+	return 0 != (words[id / WORD_BITS] & ((word_type) 1 << (id % WORD_BITS)));
+      }
+    return (0 != overflow
+	    && std::binary_search (overflow->begin (), overflow->end (), t, lessId));
+  }
+
+
+  bool
+  PropertyTypeSet::is (const PropertyType *t) const
+  {
+    return intersects (t->getDescendants ());
+  }
+
+
+  bool
+  PropertyTypeSet::intersects (const PropertyTypeSet &other) const
+  {
+    unsigned int i;
+
+    for (i = 0; WORDS > i; ++i)
+      {
+	if (0 != (words[i] & other.words[i]))
+	  {
+	    return true;
+	  }
+      }
+    if (0 != overflow && 0 != other.overflow)
+      {
+	vector< const PropertyType* >::const_iterator it;
+
+	for (it = overflow->begin (); overflow->end () != it; ++it)
+	  {
+	    if (other.has (*it))
+	      {
+		return true;
+	      }
+	  }
+      }
+    return false;
+  }
+
+
+  void
+  PropertyTypeSet::insert (const PropertyType *t)
+  {
+    unsigned int id = t->getId ();
+
+    if (DENSE_BITS > id)
+      {
+	words[id / WORD_BITS] |= (word_type) 1 << (id % WORD_BITS);
+      }
+    else
+      {
+	vector< const PropertyType* >::iterator it;
+
+	if (0 == overflow)
+	  {
+	    overflow = new vector< const PropertyType* > ();
+	  }
+	it = std::lower_bound (overflow->begin (), overflow->end (), t, lessId);
+	if (overflow->end () == it || t != *it)
+	  {
+	    overflow->insert (it, t);
+	  }
+      }
+  }
+
+
+  void
+  PropertyTypeSet::erase (const PropertyType *t)
+  {
+    unsigned int id = t->getId ();
+
+    if (DENSE_BITS > id)
+      {
+	words[id / WORD_BITS] &= ~((word_type) 1 << (id % WORD_BITS));
+      }
+    else if (0 != overflow)
+      {
+	vector< const PropertyType* >::iterator it;
+
+	it = std::lower_bound (overflow->begin (), overflow->end (), t, lessId);
+	if (overflow->end () != it && t == *it)
+	  {
+	    overflow->erase (it);
+	  }
+      }
+  }
+
+
+  void
+  PropertyTypeSet::clear ()
+  {
+    std::fill (words, words + WORDS, 0);
+    delete overflow;
+    overflow = 0;
+  }
+
+
+  void
+  PropertyTypeSet::toSet (set< const PropertyType* > &out) const
+  {
+    vector< const PropertyType* > types;
+
+    toVector (types);
+    out.clear ();
+    out.insert (types.begin (), types.end ());
+  }
+
+
+  const set< const PropertyType* >&
+  PropertyTypeSet::toSharedSet () const
+  {
+    typedef map< vector< const PropertyType* >, const set< const PropertyType* >* > SharedMap;
+
+    static SharedMap shared;
+#ifdef HAVE_PTHREAD
+    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+    vector< const PropertyType* > types;
+    SharedMap::iterator it;
+
+    toVector (types);
+#ifdef HAVE_PTHREAD
+    pthread_mutex_lock (&mutex);
+#endif
+    it = shared.find (types);
+    if (shared.end () == it)
+      {
+	it = shared.insert (make_pair (types, new set< const PropertyType* > (types.begin (), types.end ()))).first;
+      }
+#ifdef HAVE_PTHREAD
+    pthread_mutex_unlock (&mutex);
+#endif
+    return *it->second;
+  }
+
+
+  void
+  PropertyTypeSet::toVector (vector< const PropertyType* > &out) const
+  {
+    unsigned int i;
+
+    out.clear ();
+    for (i = 0; WORDS > i; ++i)
+      {
+	word_type w;
+
+	for (w = words[i]; 0 != w; w &= w - 1)
+	  {
+	    unsigned int bit = 0;
+
+	    while (0 == (w & ((word_type) 1 << bit)))
+	      {
+		++bit;
+	      }
+	    out.push_back (PropertyType::getType (i * WORD_BITS + bit));
+	  }
+      }
+    if (0 != overflow)
+      {
+	out.insert (out.end (), overflow->begin (), overflow->end ());
+      }
+  }
+
+}
@@ -0,0 +1,209 @@
+//                              -*- Mode: C++ -*-
+// PropertyTypeSet.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:40:07 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_PropertyTypeSet_h_
+#define _mccore_PropertyTypeSet_h_
+
+#include <climits>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  class PropertyType;
+
+
+
+  /**
+   * @short Fixed-width bitset of property types.
+   *
+   * Each property type receives a dense id from the type store (see
+   * PropertyType::getId).  The set keeps one bit per id below
+   * DENSE_BITS in a fixed array of words, so membership, insertion and
+   * the "some member is derived from t" test of Relation::is are a few
+   * word operations.  Types registered past DENSE_BITS, which can only
+   * come from parsing many unknown labels, go to an overflow vector
+   * allocated on first use.
+   */
+  class PropertyTypeSet
+  {
+  public:
+
+    typedef unsigned long word_type;
+
+    /**
+     * The number of type ids stored as bits.
+     */
+    static const unsigned int DENSE_BITS = 256;
+
+    /**
+     * The number of bits in a word.
+     */
+    static const unsigned int WORD_BITS = CHAR_BIT * sizeof (word_type);
+
+    /**
+     * The number of words of the set.
+     */
+    static const unsigned int WORDS = (DENSE_BITS + WORD_BITS - 1) / WORD_BITS;
+
+  private:
+
+    /**
+     * The bits of the dense ids.
+     */
+    word_type words[WORDS];
+
+    /**
+     * The types whose id is not below DENSE_BITS, sorted on id, or null.
+     */
+    vector< const PropertyType* > *overflow;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes an empty set.
+     */
+    PropertyTypeSet ();
+
+    /**
+     * Initializes the set with the other's content.
+     * @param other the set to copy.
+     */
+    PropertyTypeSet (const PropertyTypeSet &other);
+
+    /**
+     * Destroys the object.
+     */
+    ~PropertyTypeSet ();
+
+    // OPERATORS ------------------------------------------------------------
+
+    /**
+     * Assigns the set with the other's content.
+     * @param other the set to copy.
+     * @return itself.
+     */
+    PropertyTypeSet& operator= (const PropertyTypeSet &other);
+
+    /**
+     * Tests whether the sets hold the same types.
+     * @param other the set to compare.
+     * @return the result of the test.
+     */
+    bool operator== (const PropertyTypeSet &other) const;
+
+    /**
+     * Tests whether the sets differ.
+     * @param other the set to compare.
+     * @return the result of the test.
+     */
+    bool operator!= (const PropertyTypeSet &other) const
+    {
+      return ! operator== (other);
+    }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Tells if the set is empty.
+     * @return whether the set holds no type.
+     */
+    bool empty () const;
+
+    /**
+     * Gets the number of types in the set.
+     * @return the number of types.
+     */
+    unsigned int size () const;
+
+    /**
+     * Tests whether the type is in the set.
+     * @param t the property type.
+     * @return whether t was inserted.
+     */
+    bool has (const PropertyType *t) const;
+
+    /**
+     * Tests whether a type of the set is same as or derived from t.
+     * @param t the base type class.
+     * @return true if a member is t or a type derived from t.
+     */
+    bool is (const PropertyType *t) const;
+
+    /**
+     * Tests whether the sets share a type.
+     * @param other the other set.
+     * @return whether some type is in both sets.
+     */
+    bool intersects (const PropertyTypeSet &other) const;
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Inserts a type.
+     * @param t the property type.
+     */
+    void insert (const PropertyType *t);
+
+    /**
+     * Removes a type.
+     * @param t the property type.
+     */
+    void erase (const PropertyType *t);
+
+    /**
+     * Removes every type.
+     */
+    void clear ();
+
+    /**
+     * Copies the types in a std::set.
+     * @param out the set receiving the types.
+     */
+    void toSet (set< const PropertyType* > &out) const;
+
+    /**
+     * Gets the types as a std::set shared by every set holding the same
+     * types.  The shared sets are built on first request and never freed.
+     * @return the shared set.
+     */
+    const set< const PropertyType* >& toSharedSet () const;
+
+    /**
+     * Copies the types in id order.
+     * @param out the vector receiving the types.
+     */
+    void toVector (vector< const PropertyType* > &out) const;
+
+  };
+
+}
+
+#endif
@@ -27,6 +27,7 @@
 #define _mccore_PropertyTypeStore_h_
 
 #include <set>
+#include <vector>
 
 #include "PropertyType.h"
 
@@ -51,6 +52,11 @@ namespace mccore
      * The type repository
      */
     set< PropertyType*, PropertyType::less_deref > repository;
+
+    /**
+     * The types indexed by their dense id.
+     */
+    vector< PropertyType* > types;
   
   public:
 
@@ -82,8 +88,27 @@ namespace mccore
      */
     const PropertyType* get (const string& key);
 
+    /**
+     * Gets the property type of a dense id.
+     * @param id the dense id.
+     * @return the property type or 0 if no type has the id.
+     */
+    const PropertyType* get (unsigned int id) const
+    {
+      return id < types.size () ? types[id] : 0;
+    }
+
   private:
 
+    /**
+     * Registers a new type in the repository.  A new type receives the next
+     * dense id and the ancestor and descendant sets of the registered types
+     * are updated with it.  If the key exists the new type is deleted.
+     * @param t the new type.
+     * @return the registered type of the key.
+     */
+    PropertyType* add (PropertyType *t);
+
     // TYPES -------------------------------------------------------------------
 
     class Null : public virtual PropertyType {
@@ -34,13 +34,16 @@
 
 #include "Relation.h"
 
+#include "AnnotationCache.h"
 #include "Atom.h"
 #include "AtomSet.h"
 #include "AtomType.h"
 #include "Binstream.h"
 #include "Exception.h"
 #include "ExtendedResidue.h"
-#include "MaximumFlowGraph.h"
+#include "FixedMaximumFlowGraph.h"
+#include "HBondBatch.h"
+#include "HBondSites.h"
 #include "PairingPattern.h"
 #include "PropertyType.h"
 #include "ResidueType.h"
@@ -56,8 +59,20 @@ namespace mccore
   const float PAIRING_CUTOFF = 0.8;
   const float TWO_BONDS_CUTOFF = 1.5;
   const float THREE_BONDS_CUTOFF = 2.1;
-  //const float HBOND_DIST_MAX = 4;
-  const float HBOND_DIST_MAX = 1.7;
+
+  /**
+   * Fast pairing screening cutoffs, respectively:
+   *
+   * - N/O donor to acceptor squared distance cutoff (Angstroms square).
+   * - C donor to acceptor squared distance cutoff (Angstroms square).
+   * - weight of a hydrogen bond from a C donor in the flow sum.
+   * - cosine between the donor-acceptor direction and the base normals
+   *   below which the hydrogen bond is in the base planes.
+   */
+  const float gc_fast_hbond_distance_cutoff_square    = 12.96; // 3.6 Ang
+  const float gc_fast_ch_hbond_distance_cutoff_square = 13.69; // 3.7 Ang
+  const float gc_fast_ch_hbond_weight                 = 0.5;
+  const float gc_fast_hbond_plane_cutoff              = 0.5;   // 30 deg
 
   /**
    * Other annotation cutoffs, respectively:
@@ -111,8 +126,11 @@ namespace mccore
   Relation::Relation ()
     : ref (0),
       res (0),
+      tfo (0),
+      po4_tfo (0),
       refFace (PropertyType::pNull),
       resFace (PropertyType::pNull),
+      labelSet (0),
       type_aspb (0),
       sum_flow (0)
   {
@@ -123,8 +141,11 @@ namespace mccore
   Relation::Relation (const Residue *rA, const Residue *rB)
     : ref (rA),
       res (rB),
+      tfo (0),
+      po4_tfo (0),
       refFace (PropertyType::pNull),
       resFace (PropertyType::pNull),
+      labelSet (0),
       type_aspb (0),
       sum_flow (0)
   {
@@ -135,16 +156,19 @@ namespace mccore
   Relation::Relation (const Relation &other)
     : ref (other.ref),
       res (other.res),
-      tfo (other.tfo),
-      po4_tfo (other.po4_tfo),
+      tfo (0),
+      po4_tfo (0),
       refFace (other.refFace),
       resFace (other.resFace),
       labels (other.labels),
+      labelSet (0),
       type_aspb (other.type_aspb),
-      hbonds (other.hbonds),
+      hbonds (other.getHBondFlows ()),
       sum_flow (other.sum_flow),
-      pairedFaces (other.pairedFaces)
-  { }
+      pairedFaces (other.getPairedFaces ())
+  {
+    copyTransfos (other);
+  }
 
 
   Relation*
@@ -161,13 +185,14 @@ namespace mccore
     rel->res = res2;
     rel->refFace = face1;
     rel->resFace = face2;
-    rel->labels = props;
+    for (it = props.begin (); it != props.end (); ++it)
+      rel->labels.insert (*it);
 
     // set ASPB (backbone not handled!)
     if (rel->refFace != PropertyType::pNull)
       rel->type_aspb |= Relation::pairing_mask;
 
-    for (it = rel->labels.begin (); it != rel->labels.end (); ++it)
+    for (it = props.begin (); it != props.end (); ++it)
       if ((*it)->isAdjacent ())
 	rel->type_aspb |= Relation::adjacent_mask;
       else if ((*it)->isStack ())
@@ -177,6 +202,13 @@ namespace mccore
   }
 
 
+  Relation::~Relation ()
+  {
+    delete tfo;
+    delete po4_tfo;
+  }
+
+
   Relation&
   Relation::operator= (const Relation &other)
   {
@@ -184,15 +216,15 @@ namespace mccore
       {
 	ref = other.ref;
 	res = other.res;
-	tfo = other.tfo;
-	po4_tfo = other.po4_tfo;
+	copyTransfos (other);
 	refFace = other.refFace;
 	resFace = other.resFace;
 	type_aspb = other.type_aspb;
 	labels = other.labels;
-	hbonds = other.hbonds;
+	dropLabelSet ();
+	hbonds = other.getHBondFlows ();
 	sum_flow = other.sum_flow;
-	pairedFaces = other.pairedFaces;
+	pairedFaces = other.getPairedFaces ();
       }
     return *this;
   }
@@ -201,21 +233,130 @@ namespace mccore
   // METHODS --------------------------------------------------------------
 
 
+  const set< const PropertyType* >&
+  Relation::getLabels () const
+  {
+    const set< const PropertyType* > *shared = labelSet;
+
+    if (0 == shared)
+      {
+	// Racing threads find the same set, published by the lookup mutex.
+	labelSet = shared = &labels.toSharedSet ();
+      }
+    else
+      {
+	__sync_synchronize ();
+      }
+    return *shared;
+  }
+
+
   bool
   Relation::is (const PropertyType* t) const
   {
-    set< const PropertyType* >::const_iterator it;
-
-    for (it = labels.begin (); it != labels.end (); ++it)
-      if ((*it)->is (t))
-	return true;
-    return false;
+    return labels.is (t);
   }
 
   bool
   Relation::has (const PropertyType* t) const
   {
-    return labels.find (t) != labels.end ();
+    return labels.has (t);
+  }
+
+
+  /**
+   * Gets a transformation stored on first access.
+   * @param slot the stored transformation or null.
+   * @return the stored transformation or null if it is to be computed.
+   */
+  static const HomogeneousTransfo*
+  loadTransfo (HomogeneousTransfo *volatile &slot)
+  {
+    HomogeneousTransfo *t = slot;
+
+    if (0 != t)
+      {
+	__sync_synchronize ();
+      }
+    return t;
+  }
+
+
+  /**
+   * Stores a transformation computed on first access.  Threads racing on
+   * the same slot computed the same value: the first one stored is kept
+   * and the others are freed, so no thread waits on another.
+   * @param slot the stored transformation or null.
+   * @param value the computed transformation.
+   * @return the stored transformation.
+   */
+  static const HomogeneousTransfo&
+  storeTransfo (HomogeneousTransfo *volatile &slot, const HomogeneousTransfo &value)
+  {
+    HomogeneousTransfo *t = new HomogeneousTransfo (value);
+
+    if (! __sync_bool_compare_and_swap (&slot, (HomogeneousTransfo*) 0, t))
+      {
+	delete t;
+	__sync_synchronize ();
+      }
+    return *slot;
+  }
+
+
+  const HomogeneousTransfo&
+  Relation::getTransfo () const
+  {
+    const HomogeneousTransfo *t = loadTransfo (tfo);
+
+    return 0 != t ? *t : storeTransfo (tfo, computeTransfo ());
+  }
+
+
+  const HomogeneousTransfo&
+  Relation::getPhosphateTransfo () const
+  {
+    const HomogeneousTransfo *t = loadTransfo (po4_tfo);
+
+    return 0 != t ? *t : storeTransfo (po4_tfo, computePhosphateTransfo ());
+  }
+
+
+  void
+  Relation::dropTransfos ()
+  {
+    delete tfo;
+    tfo = 0;
+    delete po4_tfo;
+    po4_tfo = 0;
+  }
+
+
+  void
+  Relation::copyTransfos (const Relation &other)
+  {
+    const HomogeneousTransfo *t;
+
+    dropTransfos ();
+    if (0 != (t = loadTransfo (other.tfo)))
+      {
+	tfo = new HomogeneousTransfo (*t);
+      }
+    if (0 != (t = loadTransfo (other.po4_tfo)))
+      {
+	po4_tfo = new HomogeneousTransfo (*t);
+      }
+  }
+
+
+  HomogeneousTransfo
+  Relation::computeTransfo () const
+  {
+    if (0 == ref || 0 == res)
+      {
+	return HomogeneousTransfo ();
+      }
+    return ref->getReferential ().invert () * res->getReferential ();
   }
 
 
@@ -224,13 +365,14 @@ namespace mccore
   {
     ref = org;
     res = dest;
-    tfo = ref->getReferential ().invert () * res->getReferential ();
-    po4_tfo.setIdentity ();
+    dropTransfos ();
     refFace = resFace = PropertyType::pNull;
     labels.clear ();
+    dropLabelSet ();
     type_aspb = 0;
     hbonds.clear ();
     sum_flow = 0.0;
+    pairedFaces.clear ();
   }
 
 
@@ -260,6 +402,10 @@ namespace mccore
       case 'b':
       	bit_mask |= Relation::bhbond_mask;
       	break;
+      case 'F':
+      case 'f':
+      	bit_mask |= Relation::pairing_mask | Relation::fast_mask;
+      	break;
       default:
 	{
 	  IntLibException ex ("", __FILE__, __LINE__);
@@ -334,6 +480,22 @@ namespace mccore
 
   bool
   Relation::annotate (unsigned char aspb)
+  {
+    if (0 != (aspb & Relation::bhbond_mask)
+	|| (0 != (aspb & Relation::pairing_mask)
+	    && 0 == (aspb & Relation::fast_mask)))
+    {
+      HBondSites refSites (ref);
+      HBondSites resSites (res);
+
+      return annotate (refSites, resSites, aspb);
+    }
+    return annotate (HBondSites (), HBondSites (), aspb);
+  }
+
+
+  bool
+  Relation::annotate (const HBondSites &refSites, const HBondSites &resSites, unsigned char aspb)
   {
     if (0 != (aspb & Relation::adjacent_mask))
     {
@@ -347,18 +509,97 @@ namespace mccore
 
     if (0 != (aspb & Relation::pairing_mask))
     {
-      arePaired ();
+      if (0 != (aspb & Relation::fast_mask))
+      {
+	arePairedFast ();
+      }
+      else
+      {
+	arePaired (refSites, resSites);
+      }
     }
 
     if (0 != (aspb & Relation::bhbond_mask))
     {
-      areBHBonded ();
+      areBHBonded (refSites, resSites);
     }
 
     return ! empty ();
   }
 
 
+  bool
+  Relation::annotate (AnnotationCache &cache, const HBondSites &refSites, const HBondSites &resSites, unsigned char aspb)
+  {
+    AnnotationCache::Key key;
+    AnnotationCache::Annotation annotation;
+    const AnnotationCache::Annotation *cached;
+    vector< HBondFlow >::iterator hfIt;
+    vector< bool >::const_iterator dIt;
+    bool inverted;
+    Relation canonical;
+    const Relation *source;
+
+    reset (ref, res);
+    if (! cache.makeKey (ref, res, aspb, key, inverted))
+      {
+	return annotate (refSites, resSites, aspb);
+      }
+    if (0 != (cached = cache.find (key)))
+      {
+	// The cached annotation is in the orientation of the key.
+	if (inverted)
+	  {
+	    swap (ref, res);
+	  }
+	type_aspb = cached->type_aspb;
+	refFace = cached->refFace;
+	resFace = cached->resFace;
+	labels = cached->labels;
+	dropLabelSet ();
+	sum_flow = cached->sum_flow;
+	hbonds = cached->hbonds;
+	for (hfIt = hbonds.begin (), dIt = cached->refDonors.begin ();
+	     hbonds.end () != hfIt;
+	     ++hfIt, ++dIt)
+	  {
+	    hfIt->hbond.resD = *dIt ? ref : res;
+	    hfIt->hbond.resA = *dIt ? res : ref;
+	  }
+	pairedFaces = cached->pairedFaces;
+	if (inverted)
+	  {
+	    invert ();
+	  }
+	return ! empty ();
+      }
+
+    annotate (refSites, resSites, aspb);
+    source = this;
+    if (inverted)
+      {
+	canonical = *this;
+	canonical.invert ();
+	source = &canonical;
+      }
+    annotation.type_aspb = source->type_aspb;
+    annotation.refFace = source->refFace;
+    annotation.resFace = source->resFace;
+    annotation.labels = source->labels;
+    annotation.sum_flow = source->sum_flow;
+    annotation.hbonds = source->hbonds;
+    for (hfIt = annotation.hbonds.begin (); annotation.hbonds.end () != hfIt; ++hfIt)
+      {
+	annotation.refDonors.push_back (source->ref == hfIt->hbond.resD);
+	hfIt->hbond.resD = 0;
+	hfIt->hbond.resA = 0;
+      }
+    annotation.pairedFaces = source->pairedFaces;
+    cache.insert (key, annotation);
+    return ! empty ();
+  }
+
+
   void
   Relation::areAdjacent ()
   {
@@ -384,99 +625,113 @@ namespace mccore
 
     if (adj_type != PropertyType::pNull)
       {
-	labels.insert (adj_type);
+	insertLabel (adj_type);
 	type_aspb |= Relation::adjacent_mask;
       }
+  }
 
-    /*
-      Compute relative transfo to place phosphate form ref base.
-      Only in adjacent nucleic acids.
-    */
 
-    po4_tfo.setIdentity ();
+  HomogeneousTransfo
+  Relation::computePhosphateTransfo () const
+  {
+    HomogeneousTransfo po4;
+    const PropertyType *adj_type;
 
-    if (ref->getType ()->isNucleicAcid () &&
-	res->getType ()->isNucleicAcid () &&
-	adj_type->isAdjacent ())
-      try
-	{
-	  // fetch phosphate residue depending on adjacency direction
-	  ResId rid;
-	  Residue pRes (ResidueType::rPhosphate, rid);
-
-	  pRes.setType (ResidueType::rPhosphate);
-
-	  if (adj_type->is (PropertyType::pAdjacent5p))
-	    {
-	      pRes.insert (*ref->safeFind (AtomType::aO3p));
-	      pRes.insert (*res->safeFind (AtomType::aP));
-	      pRes.insert (*res->safeFind (AtomType::aO1P));
-	      pRes.insert (*res->safeFind (AtomType::aO2P));
-	      pRes.insert (*res->safeFind (AtomType::aO5p));
-	    }
-	  else if (adj_type->is (PropertyType::pAdjacent3p))
-	    {
-	      pRes.insert (*res->safeFind (AtomType::aO3p));
-	      pRes.insert (*ref->safeFind (AtomType::aP));
-	      pRes.insert (*ref->safeFind (AtomType::aO1P));
-	      pRes.insert (*ref->safeFind (AtomType::aO2P));
-	      pRes.insert (*ref->safeFind (AtomType::aO5p));
-	    }
-	  else
-	    {
-	      IntLibException ex ("", __FILE__, __LINE__);
-	      ex << "adjacent type \"" << adj_type << "\" not handled";
-	      throw ex;
-	    }
-
-	  pRes.finalize ();
-	  po4_tfo = ref->getReferential ().invert () * pRes.getReferential ();
-	}
-      catch (IntLibException& ex)
-	{
-	  gOut (3) << "unable to compute phosphate transfo in adjacent relation: " << ex << endl;
-	  po4_tfo.setIdentity ();
-	}
+    if (0 == ref || 0 == res
+	|| ! ref->getType ()->isNucleicAcid ()
+	|| ! res->getType ()->isNucleicAcid ())
+      {
+	return po4;
+      }
+    if (labels.has (PropertyType::pAdjacent5p))
+      {
+	adj_type = PropertyType::pAdjacent5p;
+      }
+    else if (labels.has (PropertyType::pAdjacent3p))
+      {
+	adj_type = PropertyType::pAdjacent3p;
+      }
+    else
+      {
+	return po4;
+      }
+
+    // Compute relative transfo to place phosphate form ref base.
+    try
+      {
+	// fetch phosphate residue depending on adjacency direction
+	ResId rid;
+	Residue pRes (ResidueType::rPhosphate, rid);
+
+	pRes.setType (ResidueType::rPhosphate);
+
+	if (PropertyType::pAdjacent5p == adj_type)
+	  {
+	    pRes.insert (*ref->safeFind (AtomType::aO3p));
+	    pRes.insert (*res->safeFind (AtomType::aP));
+	    pRes.insert (*res->safeFind (AtomType::aO1P));
+	    pRes.insert (*res->safeFind (AtomType::aO2P));
+	    pRes.insert (*res->safeFind (AtomType::aO5p));
+	  }
+	else
+	  {
+	    pRes.insert (*res->safeFind (AtomType::aO3p));
+	    pRes.insert (*ref->safeFind (AtomType::aP));
+	    pRes.insert (*ref->safeFind (AtomType::aO1P));
+	    pRes.insert (*ref->safeFind (AtomType::aO2P));
+	    pRes.insert (*ref->safeFind (AtomType::aO5p));
+	  }
+
+	pRes.finalize ();
+	po4 = ref->getReferential ().invert () * pRes.getReferential ();
+      }
+    catch (IntLibException& ex)
+      {
+	gOut (3) << "unable to compute phosphate transfo in adjacent relation: " << ex << endl;
+	po4.setIdentity ();
+      }
+    return po4;
   }
 
 
   void
   Relation::areBHBonded ()
   {
-    Residue::const_iterator i;
-    Residue::const_iterator j;
-    Residue::const_iterator k;
-    Residue::const_iterator l;
-    AtomSetOr as (new AtomSetSideChain (),
-		  new AtomSetOr (new AtomSetAtom (AtomType::aO2p),
-				 new AtomSetOr (new AtomSetAtom (AtomType::aO2P),
-						new AtomSetAtom (AtomType::aO1P))));
+    areBHBonded (HBondSites (ref), HBondSites (res));
+  }
+
+
+  void
+  Relation::areBHBonded (const HBondSites &refSites, const HBondSites &resSites)
+  {
+    HBondSites::backbone_const_iterator i;
+    HBondSites::backbone_const_iterator j;
 
     if (ref->getType ()->isNucleicAcid ()
 	&& res->getType ()->isNucleicAcid ())
       {
-	for (i = ref->begin (as); ref->end () != i; ++i)
+	for (i = refSites.backbone_begin (); refSites.backbone_end () != i; ++i)
 	  {
-	    if (i->getType ()->isNitrogen () || i->getType ()->isOxygen ())
+	    if ((*i)->getType ()->isNitrogen () || (*i)->getType ()->isOxygen ())
 	      {
-		for (j = res->begin (as); res->end () != j; ++j)
+		for (j = resSites.backbone_begin (); resSites.backbone_end () != j; ++j)
 		  {
-		    if (((i->getType ()->isNitrogen ()
-			  && j->getType ()->isBackbone ())
-			 || (j->getType ()->isNitrogen ()
-			     && i->getType ()->isBackbone ()))
-			&& i->distance (*j) > HBOND_DIST_MAX
-			&& i->distance (*j) < 3.2)
+		    if ((((*i)->getType ()->isNitrogen ()
+			  && (*j)->getType ()->isBackbone ())
+			 || ((*j)->getType ()->isNitrogen ()
+			     && (*i)->getType ()->isBackbone ()))
+			&& (*i)->distance (**j) > HBondSites::sBondDistMax
+			&& (*i)->distance (**j) < 3.2)
 		      {
 			const PropertyType *refface;
 			const PropertyType *resface;
 			const AtomType *refType;
 			const AtomType *resType;
 
-			labels.insert (PropertyType::pBHbond);
+			insertLabel (PropertyType::pBHbond);
 			type_aspb |= Relation::bhbond_mask;
-			refType = i->getType ();
-			resType = j->getType ();
+			refType = (*i)->getType ();
+			resType = (*j)->getType ();
 			refface = (refType->isNitrogen ()
 				   ? getFace (ref, *ref->safeFind (refType))
 				   : (AtomType::aO2p == refType
@@ -506,7 +761,7 @@ namespace mccore
 
     // 	for (i=ref->begin (hl->clone ()); i!=ref->end (); ++i) {
     // 	  for (j=ref->begin (da->clone ()); j!=ref->end (); ++j) {
-    // 	    if (i->distance (*j) < HBOND_DIST_MAX) {
+    // 	    if (i->distance (*j) < HBondSites::sBondDistMax) {
     // 	      ref_at.push_back (i);
     // 	      refn_at.push_back (j);
     // 	    }
@@ -514,7 +769,7 @@ namespace mccore
     // 	}
     // 	for (i=res->begin (hl->clone ()); i!=res->end (); ++i) {
     // 	  for (j=res->begin (da->clone ()); j!=res->end (); ++j) {
-    // 	    if (i->distance (*j) < HBOND_DIST_MAX) {
+    // 	    if (i->distance (*j) < HBondSites::sBondDistMax) {
     // 	      res_at.push_back (i);
     // 	      resn_at.push_back (j);
     // 	    }
@@ -558,7 +813,7 @@ namespace mccore
     // 	    for (j=res->begin (); j!=res->end (); ++j) {
     // 	      if (j->getType ()->isOxygen ()) {
 
-    // 		if (i->distance (*j) > HBOND_DIST_MAX && i->distance (*j) < 3.5) {
+    // 		if (i->distance (*j) > HBondSites::sBondDistMax && i->distance (*j) < 3.5) {
     // 		  bool reject = false;
     // 		  if (i->getType () == AtomType::aN) {  // N donor
     // 		    Vector3D u, v, w;
@@ -596,7 +851,7 @@ namespace mccore
     // 	    for (j=ref->begin (); j!=ref->end (); ++j) {
     // 	      if (j->getType ()->isOxygen ()) {
 
-    // 		if (i->distance (*j) > HBOND_DIST_MAX && i->distance (*j) < 3.5) {
+    // 		if (i->distance (*j) > HBondSites::sBondDistMax && i->distance (*j) < 3.5) {
     // 		   bool reject = false;
 
     // 		  if (i->getType () == AtomType::aN) {  // N donor
@@ -637,138 +892,177 @@ namespace mccore
   }
 
 
+  /**
+   * Gets the flow network node of an atom from a small table, adding the
+   * atom with the given node if it is new.
+   * @param nodes the table of atom nodes.
+   * @param atom the atom.
+   * @param node the node given to a new atom.
+   * @return the node of the atom and whether it was added.
+   */
+  static pair< unsigned int, bool >
+  atomNode (vector< pair< const Atom*, unsigned int > > &nodes, const Atom *atom, unsigned int node)
+  {
+    vector< pair< const Atom*, unsigned int > >::const_iterator it;
+
+    for (it = nodes.begin (); nodes.end () != it; ++it)
+      {
+	if (atom == it->first)
+	  {
+	    return make_pair (it->second, false);
+	  }
+      }
+    nodes.push_back (make_pair (atom, node));
+    return make_pair (node, true);
+  }
+
+
+  /**
+   * Adds the candidate hydrogen bond between a hydrogen site and a lone
+   * pair site to the batch.  The hydrogen of a C5M donor is placed as in
+   * HBond::evalStatistically.
+   * @param batch the batch.
+   * @param hs the site of the donor and its hydrogen.
+   * @param ls the site of the acceptor and its lone pair.
+   * @param rd the donor residue.
+   * @param ra the acceptor residue.
+   */
+  static void
+  addCandidate (HBondBatch &batch, const HBondSites::Site &hs, const HBondSites::Site &ls, const Residue *rd, const Residue *ra)
+  {
+    if (AtomType::aC5M == hs.heavy->getType ()
+	&& 25 >= hs.heavy->squareDistance (*ls.heavy))
+      {
+	batch.push_back (*hs.heavy,
+			 HBond::methylHydrogen (*hs.heavy, *ls.light,
+						*rd->safeFind (AtomType::aC5),
+						*ra->safeFind (AtomType::aC5)),
+			 *ls.heavy, *ls.light);
+      }
+    else
+      {
+	batch.push_back (*hs.heavy, *hs.light, *ls.heavy, *ls.light);
+      }
+  }
+
+
   void
   Relation::arePaired ()
   {
-    typedef MaximumFlowGraph< unsigned int, HBond > HBondFlowGraph;
-    typedef map< Residue::const_iterator, unsigned int > AtomToInt;
+    arePaired (HBondSites (ref), HBondSites (res));
+  }
+
+
+  void
+  Relation::arePaired (const HBondSites &refSites, const HBondSites &resSites)
+  {
+    typedef FixedMaximumFlowGraph< HBond > HBondFlowGraph;
+    typedef vector< pair< const Atom*, unsigned int > > AtomToInt;
 
     try
       {
-	Residue::const_iterator i;
-	Residue::const_iterator j;
-	Residue::const_iterator k;
-	Residue::const_iterator l;
+	const Atom *i;
+	const Atom *j;
+	const Atom *k;
+	const Atom *l;
 	AtomToInt atomToInt;
 	unsigned int node;
-	HBondFlowGraph graph;
-	vector< Residue::const_iterator > ref_at;
-	vector< Residue::const_iterator > refn_at;
-	vector< Residue::const_iterator > res_at;
-	vector< Residue::const_iterator > resn_at;
-	vector< Residue::const_iterator >::size_type x;
-	vector< Residue::const_iterator >::size_type y;
-	AtomSetAnd da (new AtomSetSideChain (),
-		       new AtomSetNot (new AtomSetOr (new AtomSetAtom (AtomType::a2H5M),
-						      new AtomSetAtom (AtomType::a3H5M))));
-
-	node = 0;
-	graph.insert (node++, 1); // Source
-	graph.insert (node++, 1); // Sink
-
-	for (i = ref->begin (da); i != ref->end (); ++i)
+	HBondFlowGraph graph (2 + refSites.size () + resSites.size ());
+	HBondSites::const_iterator x;
+	HBondSites::const_iterator y;
+	HBondBatch batch;
+	HBondBatch::size_type candidate;
+
+	atomToInt.reserve (refSites.size () + resSites.size ());
+	graph.insert (); // Source
+	graph.insert (); // Sink
+	node = 2;
+
+	for (x = refSites.begin (); refSites.end () != x; ++x)
 	  {
-	    if ((i->getType ()->isCarbon ()
-		 || i->getType ()->isNitrogen ()
-		 || i->getType ()->isOxygen ()))
+	    for (y = resSites.begin (); resSites.end () != y; ++y)
 	      {
-		for (j = ref->begin (da); j != ref->end (); ++j)
+		if (x->light->getType ()->isHydrogen () && y->light->getType ()->isLonePair ())
 		  {
-		    if ((j->getType ()->isHydrogen ()
-			 || j->getType ()->isLonePair ())
-			&& i->distance (*j) < HBOND_DIST_MAX)
-		      {
-			ref_at.push_back (j);
-			refn_at.push_back (i);
-		      }
+		    addCandidate (batch, *x, *y, ref, res);
 		  }
-	      }
-	  }
-
-	for (i = res->begin (da); i != res->end (); ++i)
-	  {
-	    if ((i->getType ()->isCarbon ()
-		 || i->getType ()->isNitrogen ()
-		 || i->getType ()->isOxygen ()))
-	      {
-		for (j = res->begin (da); j != res->end (); ++j)
+		else if (y->light->getType ()->isHydrogen () && x->light->getType ()->isLonePair ())
 		  {
-		    if ((j->getType ()->isHydrogen ()
-			 || j->getType ()->isLonePair ())
-			&& i->distance (*j) < HBOND_DIST_MAX)
-		      {
-			res_at.push_back (j);
-			resn_at.push_back (i);
-		      }
+		    addCandidate (batch, *y, *x, res, ref);
 		  }
 	      }
 	  }
+	batch.evalStatistically ();
 
-	for (x = 0; x < ref_at.size (); ++x)
+	for (x = refSites.begin (), candidate = 0; refSites.end () != x; ++x)
 	  {
-	    i = ref_at[x];
-	    j = refn_at[x];
-	    for (y = 0; y < res_at.size (); ++y)
+	    i = x->light;
+	    j = x->heavy;
+	    for (y = resSites.begin (); resSites.end () != y; ++y)
 	      {
-		k = res_at[y];
-		l = resn_at[y];
+		k = y->light;
+		l = y->heavy;
 
 		if (i->getType ()->isHydrogen () && k->getType ()->isLonePair ())
 		  {
 		    HBond h (j->getType (), i->getType (), l->getType (), k->getType ());
 
-		    h.evalStatistically (ref, res);
+		    h.resD = ref;
+		    h.resA = res;
+		    h.value = batch.getValue (candidate++);
 #ifdef DEBUG
 		    gOut (4) << h << endl;
 #endif
 		    if (h.getValue () > 0.01)
 		      {
 			HBond fake (1);
-			pair< AtomToInt::iterator, bool > iIt = atomToInt.insert (make_pair (i, node));
+			pair< unsigned int, bool > iIt = atomNode (atomToInt, i, node);
 
 			if (iIt.second)
 			  {
-			    graph.insert (node, 1);
+			    graph.insert ();
 			    graph.internalConnect (0, node, fake, 0);
 			    ++node;
 			  }
-			pair< AtomToInt::iterator, bool > kIt = atomToInt.insert (make_pair (k, node));
+			pair< unsigned int, bool > kIt = atomNode (atomToInt, k, node);
 			if (kIt.second)
 			  {
-			    graph.insert (node, 1);
+			    graph.insert ();
 			    graph.internalConnect (node, 1, fake, 0);
 			    ++node;
 			  }
-			graph.internalConnect (iIt.first->second, kIt.first->second, h, 0);
+			graph.internalConnect (iIt.first, kIt.first, h, 0);
 		      }
 		  }
 		else if (k->getType ()->isHydrogen () && i->getType ()->isLonePair ())
 		  {
 		    HBond h (l->getType (), k->getType (), j->getType (), i->getType ());
 
-		    h.evalStatistically (res, ref);
+		    h.resD = res;
+		    h.resA = ref;
+		    h.value = batch.getValue (candidate++);
 #ifdef DEBUG
 		    gOut (4) << h << endl;
 #endif
 		    if (h.getValue () > 0.01)
 		      {
 			HBond fake (1);
-			pair< AtomToInt::iterator, bool > kIt = atomToInt.insert (make_pair (k, node));
+			pair< unsigned int, bool > kIt = atomNode (atomToInt, k, node);
 
 			if (kIt.second)
 			  {
-			    graph.insert (node, 1);
+			    graph.insert ();
 			    graph.internalConnect (0, node, fake, 0);
 			    ++node;
 			  }
-			pair< AtomToInt::iterator, bool > iIt = atomToInt.insert (make_pair (i, node));
+			pair< unsigned int, bool > iIt = atomNode (atomToInt, i, node);
 			if (iIt.second)
 			  {
-			    graph.insert (node, 1);
+			    graph.insert ();
 			    graph.internalConnect (node, 1, fake, 0);
 			    ++node;
 			  }
-			graph.internalConnect (kIt.first->second, iIt.first->second, h, 0);
+			graph.internalConnect (kIt.first, iIt.first, h, 0);
 		      }
 		  }
 	      }
@@ -780,7 +1074,7 @@ namespace mccore
 
 	if (graph.size () >= 3)
 	  {
-	    HBondFlowGraph::size_type label;
+	    HBondFlowGraph::edge_label label;
 
 	    graph.preFlowPush (0, 1);
 
@@ -828,34 +1122,268 @@ namespace mccore
   }
 
 
+  /**
+   * @short A donor or acceptor atom of a base for the fast pairing screening.
+   */
+  struct FastSite
+  {
+    /**
+     * The donor or acceptor atom.
+     */
+    const Atom *atom;
+
+    /**
+     * The number of hydrogen bonds the atom can still form.
+     */
+    unsigned int capacity;
+
+    /**
+     * Whether the atom is a carbon donor.
+     */
+    bool carbon;
+
+    FastSite (const Atom *a, unsigned int c, bool cd)
+      : atom (a), capacity (c), carbon (cd)
+    { }
+  };
+
+
+  /**
+   * @short A donor-acceptor contact between two bases, ordered by
+   * distance.
+   */
+  struct FastContact
+  {
+    float squareDistance;
+    FastSite *donor;
+    FastSite *acceptor;
+    bool refDonor;
+
+    FastContact (float d, FastSite *ds, FastSite *as, bool rd)
+      : squareDistance (d), donor (ds), acceptor (as), refDonor (rd)
+    { }
+
+    bool operator< (const FastContact &right) const
+    {
+      return squareDistance < right.squareDistance;
+    }
+  };
+
+
+  /**
+   * Adds the atom of a residue to the fast screening sites if it exists.
+   * @param r the residue.
+   * @param type the atom type.
+   * @param capacity the number of hydrogens or lone pairs of the atom.
+   * @param carbon whether the atom is a carbon donor.
+   * @param sites the sites.
+   */
+  static void
+  addFastSite (const Residue *r, const AtomType *type, unsigned int capacity, bool carbon, vector< FastSite > &sites)
+  {
+    Residue::const_iterator it;
+
+    if (r->end () != (it = r->find (type)))
+      {
+	sites.push_back (FastSite (&*it, capacity, carbon));
+      }
+  }
+
+
+  /**
+   * Gets the base donor and acceptor atoms of a nucleic acid residue used in
+   * the fast pairing screening.  They are the heavy atoms HBondSites pairs
+   * with a hydrogen or a lone pair, the capacity being the number of them.
+   * @param r the residue.
+   * @param donors the donor sites.
+   * @param acceptors the acceptor sites.
+   */
+  static void
+  getFastSites (const Residue *r, vector< FastSite > &donors, vector< FastSite > &acceptors)
+  {
+    const ResidueType *type = r->getType ();
+
+    if (type->isA ())
+      {
+	addFastSite (r, AtomType::aN6, 2, false, donors);
+	addFastSite (r, AtomType::aC2, 1, true, donors);
+	addFastSite (r, AtomType::aC8, 1, true, donors);
+	addFastSite (r, AtomType::aN1, 1, false, acceptors);
+	addFastSite (r, AtomType::aN3, 1, false, acceptors);
+	addFastSite (r, AtomType::aN7, 1, false, acceptors);
+      }
+    else if (type->isG ())
+      {
+	addFastSite (r, AtomType::aN1, 1, false, donors);
+	addFastSite (r, AtomType::aN2, 2, false, donors);
+	addFastSite (r, AtomType::aC8, 1, true, donors);
+	addFastSite (r, AtomType::aO6, 2, false, acceptors);
+	addFastSite (r, AtomType::aN3, 1, false, acceptors);
+	addFastSite (r, AtomType::aN7, 1, false, acceptors);
+      }
+    else if (type->isC ())
+      {
+	addFastSite (r, AtomType::aN4, 2, false, donors);
+	addFastSite (r, AtomType::aC5, 1, true, donors);
+	addFastSite (r, AtomType::aC6, 1, true, donors);
+	addFastSite (r, AtomType::aO2, 2, false, acceptors);
+	addFastSite (r, AtomType::aN3, 1, false, acceptors);
+      }
+    else if (type->isU () || type->isT ())
+      {
+	addFastSite (r, AtomType::aN3, 1, false, donors);
+	addFastSite (r, AtomType::aC6, 1, true, donors);
+	addFastSite (r, (type->isT () ? AtomType::aC5M : AtomType::aC5), 1, true, donors);
+	addFastSite (r, AtomType::aO2, 2, false, acceptors);
+	addFastSite (r, AtomType::aO4, 2, false, acceptors);
+      }
+  }
+
+
+  /**
+   * Adds the donor-acceptor contacts within the fast screening cutoffs.
+   * @param donors the donor sites of a residue.
+   * @param acceptors the acceptor sites of the other residue.
+   * @param refDonor whether the donors are in the reference residue.
+   * @param contacts the contacts.
+   */
+  static void
+  addFastContacts (vector< FastSite > &donors, vector< FastSite > &acceptors, bool refDonor, vector< FastContact > &contacts)
+  {
+    vector< FastSite >::iterator d;
+    vector< FastSite >::iterator a;
+
+    for (d = donors.begin (); donors.end () != d; ++d)
+      {
+	for (a = acceptors.begin (); acceptors.end () != a; ++a)
+	  {
+	    float dist = d->atom->squareDistance (*a->atom);
+
+	    if (dist <= (d->carbon
+			 ? gc_fast_ch_hbond_distance_cutoff_square
+			 : gc_fast_hbond_distance_cutoff_square))
+	      {
+		contacts.push_back (FastContact (dist, &*d, &*a, refDonor));
+	      }
+	  }
+      }
+  }
+
+
+  void
+  Relation::arePairedFast ()
+  {
+    if (ref->getType ()->isNucleicAcid () && res->getType ()->isNucleicAcid ())
+      {
+	try
+	  {
+	    vector< FastSite > refDonors;
+	    vector< FastSite > refAcceptors;
+	    vector< FastSite > resDonors;
+	    vector< FastSite > resAcceptors;
+	    vector< FastContact > contacts;
+	    vector< FastContact >::iterator it;
+	    Vector3D pa;
+	    Vector3D pb;
+	    Vector3D refCenter;
+	    Vector3D resCenter;
+	    Vector3D refNormal;
+	    Vector3D resNormal;
+
+	    getFastSites (ref, refDonors, refAcceptors);
+	    getFastSites (res, resDonors, resAcceptors);
+	    addFastContacts (refDonors, resAcceptors, true, contacts);
+	    addFastContacts (resDonors, refAcceptors, false, contacts);
+	    if (! contacts.empty ())
+	      {
+		sort (contacts.begin (), contacts.end ());
+		refCenter = Relation::_pyrimidine_ring_center (*ref);
+		resCenter = Relation::_pyrimidine_ring_center (*res);
+		refNormal = Relation::_pyrimidine_ring_normal (*ref, refCenter);
+		resNormal = Relation::_pyrimidine_ring_normal (*res, resCenter);
+
+		// The closest contacts are kept first, each atom bonding as many
+		// times as it has hydrogens or lone pairs.  The hydrogen and lone
+		// pair are guessed 1 Angstrom from their heavy atom on the bond.
+		for (it = contacts.begin (); contacts.end () != it; ++it)
+		  {
+		    const Atom &donor = *it->donor->atom;
+		    const Atom &acceptor = *it->acceptor->atom;
+		    Vector3D u = (acceptor - donor).normalize ();
+		    float weight;
+
+		    if (0 == it->donor->capacity
+			|| 0 == it->acceptor->capacity
+			|| fabs (refNormal.dot (u)) > gc_fast_hbond_plane_cutoff
+			|| fabs (resNormal.dot (u)) > gc_fast_hbond_plane_cutoff
+			|| (donor - (it->refDonor ? refCenter : resCenter)).dot (u) < 0
+			|| (acceptor - (it->refDonor ? resCenter : refCenter)).dot (u) > 0)
+		      {
+			continue;
+		      }
+		    --it->donor->capacity;
+		    --it->acceptor->capacity;
+		    weight = it->donor->carbon ? gc_fast_ch_hbond_weight : 1;
+		    if (it->refDonor)
+		      {
+			pa = pa + ((donor + u) * weight);
+			pb = pb + ((acceptor - u) * weight);
+		      }
+		    else
+		      {
+			pa = pa + ((acceptor - u) * weight);
+			pb = pb + ((donor + u) * weight);
+		      }
+		    sum_flow += weight;
+		  }
+
+		if (sum_flow >= PAIRING_CUTOFF)
+		  {
+		    type_aspb |= Relation::pairing_mask;
+		    insertLabel (PropertyType::pPairing);
+		    if (sum_flow < TWO_BONDS_CUTOFF)
+		      {
+			insertLabel (PropertyType::pOneHbond);
+		      }
+		    addPairingOrientation ();
+		    refFace = getFace (ref, pa / sum_flow);
+		    resFace = getFace (res, pb / sum_flow);
+		    if (PropertyType::pNull != refFace && PropertyType::pNull != resFace)
+		      {
+			pairedFaces.push_back (make_pair (refFace, resFace));
+		      }
+		    addCisTrans ();
+		  }
+	      }
+	  }
+	catch (IntLibException& ex)
+	  {
+	    gOut (3) << "An error occured during pairing annotation: " << ex << endl;
+	  }
+      }
+  }
+
+
   void
   Relation::addPairingLabels ()
   {
     Vector3D pa;
     Vector3D pb;
-    Vector3D pc;
-    Vector3D pd;
     list< HBondFlow > hbf (hbonds.begin (), hbonds.end ());
     vector< HBondFlow >::iterator hbIt;
-    float rad;
     unsigned int size_hint;
     const PropertyType *pp;
     const PropertyType *bpo;
 
     type_aspb |= Relation::pairing_mask;
-    labels.insert (PropertyType::pPairing);
+    insertLabel (PropertyType::pPairing);
     if (sum_flow < TWO_BONDS_CUTOFF)
       {
-	labels.insert (PropertyType::pOneHbond);
+	insertLabel (PropertyType::pOneHbond);
       }
 
     // -- parallel/antiparallel orientation
-    bpo = (Relation::_pyrimidine_ring_normal (*ref,
-					      Relation::_pyrimidine_ring_center (*ref)).dot (Relation::_pyrimidine_ring_normal (*res,
-																Relation::_pyrimidine_ring_center (*res))) > 0
-	   ? PropertyType::pParallel
-	   : PropertyType::pAntiparallel);
-    labels.insert (bpo);
+    bpo = addPairingOrientation ();
 
     // Compute contact points and visual contact points
     for (hbIt = hbonds.begin (); hbonds.end () != hbIt; ++hbIt)
@@ -902,11 +1430,36 @@ namespace mccore
 	  }
 	if (0 != (pp = translatePairing (ref, res, bpo, hbf, sum_flow, size_hint)))
 	  {
-	    labels.insert (pp);
+	    insertLabel (pp);
 	  }
       }
 
     // -- cis/trans orientation
+    addCisTrans ();
+  }
+
+
+  const PropertyType*
+  Relation::addPairingOrientation ()
+  {
+    const PropertyType *bpo;
+
+    bpo = (Relation::_pyrimidine_ring_normal (*ref,
+					      Relation::_pyrimidine_ring_center (*ref)).dot (Relation::_pyrimidine_ring_normal (*res,
+																Relation::_pyrimidine_ring_center (*res))) > 0
+	   ? PropertyType::pParallel
+	   : PropertyType::pAntiparallel);
+    insertLabel (bpo);
+    return bpo;
+  }
+
+
+  void
+  Relation::addCisTrans ()
+  {
+    Vector3D pc;
+    Vector3D pd;
+    float rad;
     Vector3D refpyr = Relation::_pyrimidine_ring_center (*ref);
     Vector3D respyr = Relation::_pyrimidine_ring_center (*res);
 
@@ -917,7 +1470,7 @@ namespace mccore
     pd = pd - *res->safeFind (AtomType::aPSY);
     pd = pd + respyr;
     rad = fabs (refpyr.torsionAngle (pc, respyr, pd));
-    labels.insert (rad < M_PI / 2 ? PropertyType::pCis : PropertyType::pTrans);
+    insertLabel (rad < M_PI / 2 ? PropertyType::pCis : PropertyType::pTrans);
   }
 
 
@@ -1136,7 +1689,7 @@ namespace mccore
 	      stacking = Relation::_ring_stacking (imidCA, imidNA, imidCB, imidNB);
 
 	    if (PropertyType::pNull != stacking)
-	      labels.insert (stacking);
+	      insertLabel (stacking);
 	  }
 	catch (IntLibException& ex)
 	  {
@@ -1170,8 +1723,8 @@ namespace mccore
   {
     const Residue* rt;
     const PropertyType* pt;
-    set< const PropertyType* > lt;
-    set< const PropertyType* >::const_iterator it;
+    vector< const PropertyType* > lt;
+    vector< const PropertyType* >::const_iterator it;
     vector< pair< const PropertyType*, const PropertyType* > >::iterator pfit;
 
     // -- invert residues and faces
@@ -1182,15 +1735,26 @@ namespace mccore
     refFace = resFace;
     resFace = pt;
 
-    // -- invert transfos
-    this->tfo = this->tfo.invert ();
-    if (this->isAdjacent ())
-      this->po4_tfo = this->tfo * this->po4_tfo;
+    // -- invert transfos, those not computed yet will be from the
+    // -- inverted residues
+    if (0 != tfo)
+      {
+	*tfo = tfo->invert ();
+	if (0 != po4_tfo && this->isAdjacent ())
+	  *po4_tfo = *tfo * *po4_tfo;
+      }
+    else if (0 != po4_tfo && this->isAdjacent ())
+      {
+	delete po4_tfo;
+	po4_tfo = 0;
+      }
 
     // -- invert labels
-    for (it = labels.begin (); it != labels.end (); ++it)
-      lt.insert (PropertyType::invert (*it));
-    labels = lt;
+    labels.toVector (lt);
+    labels.clear ();
+    for (it = lt.begin (); it != lt.end (); ++it)
+      labels.insert (PropertyType::invert (*it));
+    dropLabelSet ();
     for (pfit = pairedFaces.begin (); pairedFaces.end () != pfit; ++pfit)
       {
 	swap (pfit->first, pfit->second);
@@ -1208,12 +1772,14 @@ namespace mccore
     if (ref != 0 && res != 0)
       {
 	vector< pair< const PropertyType*, const PropertyType* > >::const_iterator it;
+	set< const PropertyType* > lt;
 
+	labels.toSet (lt);
 	os << "{"
 	   << ref->getResId () << ref->getType () << " -> "
 	   << res->getResId () << res->getType () << ": ";
-	copy (labels.begin (), labels.end (), ostream_iterator< const PropertyType* > (os, " "));
-	for (it = pairedFaces.begin (); pairedFaces.end () != it; ++it)
+	copy (lt.begin (), lt.end (), ostream_iterator< const PropertyType* > (os, " "));
+	for (it = getPairedFaces ().begin (); getPairedFaces ().end () != it; ++it)
 	  {
 	    os << *it->first << "/" << *it->second << ' ';
 	  }
@@ -1474,21 +2040,20 @@ namespace mccore
   const PropertyType*
   Relation::translatePairing (const Residue *ra, const Residue *rb, const PropertyType *bpo, list< HBondFlow > &hbf, float total_flow, unsigned int size_hint)
   {
-    list< PairingPattern >::const_iterator i;
+    vector< const PairingPattern* > candidates;
+    vector< const PairingPattern* >::const_iterator i;
     const PropertyType *type;
     const PropertyType *best_type = 0;
     unsigned int best_size = 0;
 
-    for (i = PairingPattern::patternList ().begin ();
-	 i != PairingPattern::patternList().end ();
-	 ++i)
+    PairingPattern::candidatePatterns (ra, rb, bpo, hbf, size_hint, candidates);
+    for (i = candidates.begin (); candidates.end () != i; ++i)
       {
-	if (size_hint >= (*i).size ()
-	    && (type = (*i).evaluate (ra, rb, bpo, hbf)) != 0)
+	if ((type = (*i)->evaluate (ra, rb, bpo, hbf)) != 0)
 	  {
-	    if ((*i).size () > best_size)
+	    if ((*i)->size () > best_size)
 	      {
-		best_size = (*i).size ();
+		best_size = (*i)->size ();
 		best_type = type;
 	      }
 	  }
@@ -1503,6 +2068,7 @@ namespace mccore
     ResId id;
     map<ResId, const Residue* >::const_iterator rmIt;
     mccore::bin_ui64 qty = 0;
+    float flag;
 
     is >> id;
     if (resMap.end () == (rmIt = resMap.find (id)))
@@ -1528,9 +2094,29 @@ namespace mccore
       {
 	res = rmIt->second;
       }
-    is >> tfo >> po4_tfo;
+    dropTransfos ();
+    is >> flag;
+    if (flag == flag)
+      {
+	HomogeneousTransfo t;
+	float m[16];
+	unsigned int i;
+
+	// -- the flag was the first coefficient, see HomogeneousTransfo::write
+	m[0] = flag;
+	for (i = 1; 16 > i; ++i)
+	  {
+	    is >> m[i];
+	  }
+	tfo = new HomogeneousTransfo (m[0], m[4], m[8], m[12],
+				      m[1], m[5], m[9], m[13],
+				      m[2], m[6], m[10], m[14]);
+	is >> t;
+	po4_tfo = new HomogeneousTransfo (t);
+      }
     is >> refFace >> resFace;
     labels.clear ();
+    dropLabelSet ();
     is >> qty;
     while (0 < qty)
       {
@@ -1544,7 +2130,7 @@ namespace mccore
 	const PropertyType *prop;
 
 	is >> prop;
-	labels.insert (prop);
+	insertLabel (prop);
 	--qty;
       }
     is >> type_aspb;
@@ -1588,28 +2174,46 @@ namespace mccore
   oBinstream&
   Relation::write (oBinstream &os) const
   {
+    return write (os, true);
+  }
+
+
+  oBinstream&
+  Relation::write (oBinstream &os, bool transfos) const
+  {
+    const vector< HBondFlow > &flows = getHBondFlows ();
+    const vector< pair< const PropertyType*, const PropertyType* > > &faces = getPairedFaces ();
+    set< const PropertyType* > lt;
     set< const PropertyType* >::const_iterator propsIt;
     vector< HBondFlow >::const_iterator hfsIt;
     vector< pair< const PropertyType*, const PropertyType* > >::const_iterator pfit;
 
+    labels.toSet (lt);
     os << ref->getResId ();
     os << res->getResId ();
-    os << tfo << po4_tfo;
+    if (transfos)
+      {
+	os << getTransfo () << getPhosphateTransfo ();
+      }
+    else
+      {
+	os << numeric_limits< float >::quiet_NaN ();
+      }
     os << refFace << resFace;
-    os << (mccore::bin_ui64) labels.size ();
-    for (propsIt = labels.begin (); labels.end () != propsIt; ++propsIt)
+    os << (mccore::bin_ui64) lt.size ();
+    for (propsIt = lt.begin (); lt.end () != propsIt; ++propsIt)
       {
 	os << *propsIt;
       }
     os << type_aspb;
-    os << (mccore::bin_ui64) hbonds.size ();
-    for (hfsIt = hbonds.begin (); hbonds.end () != hfsIt; ++hfsIt)
+    os << (mccore::bin_ui64) flows.size ();
+    for (hfsIt = flows.begin (); flows.end () != hfsIt; ++hfsIt)
       {
 	hfsIt->write (os);
       }
     os << sum_flow;
-    os << (mccore::bin_ui64) pairedFaces.size ();
-    for (pfit = pairedFaces.begin (); pairedFaces.end () != pfit; ++pfit)
+    os << (mccore::bin_ui64) faces.size ();
+    for (pfit = faces.begin (); faces.end () != pfit; ++pfit)
       {
 	os << pfit->first << pfit->second;
       }
@@ -33,9 +33,11 @@
 #include <vector>
 
 #include "Algo.h"
+#include "Arena.h"
 #include "Exception.h"
 #include "HBond.h"
 #include "HomogeneousTransfo.h"
+#include "PropertyTypeSet.h"
 #include "ResId.h"
 #include "Residue.h"
 #include "Vector3D.h"
@@ -46,6 +48,8 @@ using namespace std;
 
 namespace mccore
 {
+  class AnnotationCache;
+  class HBondSites;
   class PropertyType;
   class iBinstream;
   class oBinstream;
@@ -78,7 +82,7 @@ namespace mccore
    * @author Patrick Gendron (<a href="mailto:gendrop@iro.umontreal.ca">gendrop@iro.umontreal.ca</a>)
    * @version $Id: Relation.h,v 1.30 2007-01-09 00:02:22 larosem Exp $
    */
-  class Relation
+  class Relation : public ArenaObject
   {
   protected:
     
@@ -94,15 +98,16 @@ namespace mccore
 
     /**
      * The homogeneous matrix that expresses the transformation from the ref
-     * to the res.
+     * to the res, or null until computed on first access, see getTransfo.
      */
-    HomogeneousTransfo tfo;
+    mutable HomogeneousTransfo *volatile tfo;
 
     /**
      * The homogeneous matrix that expresses the transformation from
-     * the reference residue to the phosphate residue.
+     * the reference residue to the phosphate residue, or null until
+     * computed on first access, see getPhosphateTransfo.
      */
-    HomogeneousTransfo po4_tfo;
+    mutable HomogeneousTransfo *volatile po4_tfo;
     
     /**
      * A property for the interacting face of the ref.
@@ -117,7 +122,14 @@ namespace mccore
     /**
      * General properties of the interaction.
      */
-    set< const PropertyType* > labels;
+    PropertyTypeSet labels;
+
+    /**
+     * The shared std::set of the labels (see PropertyTypeSet::toSharedSet),
+     * looked up on the first call to getLabels and dropped when the labels
+     * change.
+     */
+    mutable const set< const PropertyType* > *volatile labelSet;
 
     /**
      * The four-bits annotation type: msb<-[adjacent][stacking][pairing][backbone]->lsb
@@ -165,6 +177,14 @@ namespace mccore
      */
     static const unsigned char bhbond_mask = 1;
 
+    /**
+     * The fast screening mask (10000).  Combined with the pairing mask, base
+     * pairs are called from the base geometry (see arePairedFast) instead of
+     * the statistical hydrogen bond evaluation, so that the hydrogens and
+     * lone pairs need not be placed.
+     */
+    static const unsigned char fast_mask = 16;
+
   protected:
 
     static vector< pair< Vector3D, const PropertyType* > > faces_A;
@@ -235,7 +255,7 @@ namespace mccore
     /**
      * Destroys the object.
      */
-    virtual ~Relation () { }
+    virtual ~Relation ();
 
     // OPERATORS ------------------------------------------------------------
 
@@ -269,9 +289,17 @@ namespace mccore
     const PropertyType* getResFace () const { return resFace; }
 
     /**
-     * Returns the properties of the relation.
+     * Returns the properties of the relation.  The set is shared by every
+     * relation holding the same labels and stays valid for the lifetime of
+     * the process.  It is looked up on the first call after the labels
+     * change; concurrent calls on a const relation are safe.
+     */
+    const set< const PropertyType* >& getLabels () const;
+
+    /**
+     * Returns the properties of the relation as a bitset.
      */
-    const set< const PropertyType* >& getLabels () const { return labels; }
+    const PropertyTypeSet& getLabelBits () const { return labels; }
 
     /**
      * Gets the annotation type bits.
@@ -283,22 +311,35 @@ namespace mccore
     }
     
     /**
-     * Returns the transformation between the residues of the relation.
+     * Returns the transformation between the residues of the relation.  It
+     * is computed from the residue positions on first access and kept out
+     * of line until the relation is reset, annotated or read.  Concurrent
+     * calls on a const relation are safe: racing threads compute the same
+     * transformation and the first one stored is kept.
      */
-    const HomogeneousTransfo& getTransfo () const { return tfo; }
+    const HomogeneousTransfo& getTransfo () const;
 
     /**
      * Returns the transformation between the phosphate and the reference
-     * residue of the relation.
+     * residue of the relation.  It is the identity unless the relation
+     * holds nucleic acids labeled adjacent.  It is computed on first
+     * access, as getTransfo.
+     */
+    const HomogeneousTransfo& getPhosphateTransfo () const;
+
+    /**
+     * Forgets and frees the transformations, so that they are computed
+     * again from the residue positions on next access, for instance after
+     * the residues moved.
      */
-    const HomogeneousTransfo& getPhosphateTransfo () const { return po4_tfo; }
+    void dropTransfos ();
 
     /**
      * Gets the hbonds flow collection.  Empty in case of a non pairing
      * relation.
      * @return the HBondFlow vector.
      */
-    const vector< HBondFlow >& getHBondFlows () const { return hbonds; }
+    virtual const vector< HBondFlow >& getHBondFlows () const { return hbonds; }
 
     /**
      * Gets the pairing flow sum.  0 in case of a non pairing relation.
@@ -310,7 +351,7 @@ namespace mccore
      * Gets the pairing faces vector.
      * @return the collection of pairing faces.
      */
-    const vector< pair< const PropertyType*, const PropertyType* > >& getPairedFaces () const { return pairedFaces; }
+    virtual const vector< pair< const PropertyType*, const PropertyType* > >& getPairedFaces () const { return pairedFaces; }
 
     /**
      * Replaces the Residue pointers with those coming from the set.  It
@@ -376,6 +417,7 @@ namespace mccore
      *   S  annotate base stacking
      *   P  annotate base pairing
      *   B  annotate hydrogen-bonding with backbone
+     *   F  annotate base pairing from the base geometry (fast screening)
      *
      * Throws an @ref IntLibException for any other character.
      *
@@ -400,6 +442,32 @@ namespace mccore
      */
     bool annotate (unsigned char aspb = adjacent_mask|pairing_mask|stacking_mask|bhbond_mask);
     
+    /** 
+     * Describes the interaction with the hydrogen bond sites of the
+     * residues already computed, as done once per residue in an annotation
+     * pass.
+     * @param refSites the hydrogen bond sites of the reference residue.
+     * @param resSites the hydrogen bond sites of the other residue.
+     * @param asbp Bit mask controlling annotation tasks: adjacency, 
+     *        stacking, pairing and pairing with backbone (default: all).
+     * @return true if there is indeed a relation between the bases.
+     */
+    bool annotate (const HBondSites &refSites, const HBondSites &resSites, unsigned char aspb = adjacent_mask|pairing_mask|stacking_mask|bhbond_mask);
+
+    /**
+     * Describes the interaction, reusing the annotation cached for the
+     * conformers and the relative position of the residues if any.  A new
+     * annotation is stored into the cache.  Unlike the other annotate
+     * methods, the previous annotation of the relation is replaced.
+     * @param cache the annotation cache.
+     * @param refSites the hydrogen bond sites of the reference residue.
+     * @param resSites the hydrogen bond sites of the other residue.
+     * @param asbp Bit mask controlling annotation tasks: adjacency, 
+     *        stacking, pairing and pairing with backbone (default: all).
+     * @return true if there is indeed a relation between the bases.
+     */
+    bool annotate (AnnotationCache &cache, const HBondSites &refSites, const HBondSites &resSites, unsigned char aspb = adjacent_mask|pairing_mask|stacking_mask|bhbond_mask);
+    
     /**
      * Tests for adjacency relation.
      */
@@ -410,11 +478,39 @@ namespace mccore
      */
     void areBHBonded ();
 
+    /**
+     * Tests for backbone hydrogen bonded relation with the hydrogen bond
+     * sites of the residues.
+     * @param refSites the hydrogen bond sites of the reference residue.
+     * @param resSites the hydrogen bond sites of the other residue.
+     */
+    void areBHBonded (const HBondSites &refSites, const HBondSites &resSites);
+
     /**
      * Test for pairing relation.
      */
     void arePaired ();
 
+    /**
+     * Test for pairing relation with the hydrogen bond sites of the
+     * residues.
+     * @param refSites the hydrogen bond sites of the reference residue.
+     * @param resSites the hydrogen bond sites of the other residue.
+     */
+    void arePaired (const HBondSites &refSites, const HBondSites &resSites);
+
+    /**
+     * Test for pairing relation from the base geometry only, for the fast
+     * screening of large sets of models.  The hydrogen bonds are guessed
+     * from the distances between the donor and acceptor atoms of the bases
+     * and from their direction relative to the base planes, without
+     * hydrogens, lone pairs or maximum flow.  The pairing, orientation,
+     * cis/trans and face labels are set as in arePaired but no H-bond flow
+     * nor Saenger classification is kept, and the flow sum counts the
+     * guessed hydrogen bonds.
+     */
+    void arePairedFast ();
+
     /**
      * Tests for stacking relation.
      */
@@ -422,11 +518,57 @@ namespace mccore
 
   private:
 
+    /**
+     * Computes the transformation from the ref to the res.
+     * @return the transformation, the identity if a residue is missing.
+     */
+    HomogeneousTransfo computeTransfo () const;
+
+    /**
+     * Copies the transformations of the other relation that are computed.
+     * @param other the relation to copy from.
+     */
+    void copyTransfos (const Relation &other);
+
+    /**
+     * Computes the transformation from the ref to the phosphate linking
+     * adjacent nucleic acids.
+     * @return the transformation, the identity if the relation is not an
+     * adjacency of nucleic acids or if an atom is missing.
+     */
+    HomogeneousTransfo computePhosphateTransfo () const;
+
+    /**
+     * Inserts a label and drops the shared std::set of the labels.
+     * @param t the label.
+     */
+    void insertLabel (const PropertyType *t)
+    {
+      labels.insert (t);
+      dropLabelSet ();
+    }
+
+    /**
+     * Drops the shared std::set of the labels.
+     */
+    void dropLabelSet () { labelSet = 0; }
+
     /**
      * Adds the pairing labels into the Relation.
      */
     void addPairingLabels ();
 
+    /**
+     * Adds the parallel or antiparallel label of a base pair.
+     * @return the orientation label.
+     */
+    const PropertyType* addPairingOrientation ();
+
+    /**
+     * Adds the cis or trans label of a base pair.
+     */
+    void addCisTrans ();
+
   public:
 
     /**
@@ -583,6 +725,16 @@ namespace mccore
      * @return the binary output stream.
      */
     virtual oBinstream& write (oBinstream &os) const;
+
+    /**
+     * Writes the relation to a binary stream, optionally leaving the
+     * transformations out.  They are then replaced by a NaN flag and
+     * computed again from the residues on first access after read.
+     * @param os the binary output stream.
+     * @param transfos whether the transformations are written.
+     * @return the binary output stream.
+     */
+    oBinstream& write (oBinstream &os, bool transfos) const;
     
   };
 
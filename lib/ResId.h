@@ -26,8 +26,9 @@
 #ifndef _mccore_ResId_h_
 #define _mccore_ResId_h_
 
-#include <iostream>
+#include <climits>
 #include <cstdlib>
+#include <iostream>
 
 using namespace std;
 
@@ -48,11 +49,24 @@ namespace mccore
    *
    * "(?:'(.)'|([^0-9]))?([0-9]+)"
    *
+   * A residue id can be packed in an order-preserving 64 bits integer key
+   * (see getKey).  Comparing keys is equivalent to comparing ids, which
+   * makes them suitable for hashing and radix sorting.
+   *
    * @author Patrick Gendron (<a href="gendrop@iro.umontreal.ca">gendrop@iro.umontreal.ca</a>)
    * @version $Id: ResId.h,v 1.14 2005-03-10 22:58:57 larosem Exp $
    */
   class ResId
   {
+  public:
+
+    /**
+     * The packed residue id type.
+     */
+    typedef unsigned long long key_type;
+
+  private:
+
     /**
      * The residue chain id.
      */
@@ -139,11 +153,7 @@ namespace mccore
      */
     bool operator< (const ResId &other) const
     {
-      return (chain < other.chain
-	      || (chain == other.chain && no < other.no)
-	      || (chain == other.chain
-		  && no == other.no
-		  && iCode < other.iCode));
+      return getKey () < other.getKey ();
     }
 
     /**
@@ -205,6 +215,43 @@ namespace mccore
      */
     void setInsertionCode (char ic) { iCode = ic; }
 
+    /**
+     * Gets the packed key of the residue id.  The chain id, the residue
+     * number and the insertion code are stored in bits 40-47, 8-39 and 0-7
+     * respectively, biased so that the unsigned key order is the ResId
+     * order.
+     * @return the packed key.
+     */
+    key_type getKey () const
+    {
+      return (((key_type) (unsigned char) (chain - CHAR_MIN) << 40)
+	      | ((key_type) ((unsigned int) no ^ 0x80000000u) << 8)
+	      | (key_type) (unsigned char) (iCode - CHAR_MIN));
+    }
+
+    /**
+     * Creates the residue id corresponding to a packed key.
+     * @param key the packed key (see getKey).
+     * @return the residue id.
+     */
+    static ResId fromKey (key_type key)
+    {
+      return ResId ((char) ((int) ((key >> 40) & 0xff) + CHAR_MIN),
+		    (int) ((unsigned int) (key >> 8) ^ 0x80000000u),
+		    (char) ((int) (key & 0xff) + CHAR_MIN));
+    }
+
+    /**
+     * Gets a hash value for the residue id, computed from the packed key.
+     * @return the hash value.
+     */
+    size_t hash () const
+    {
+      key_type h = getKey () * 0x9e3779b97f4a7c15ULL;
+
+      return (size_t) (h ^ (h >> 32));
+    }
+
     // METHODS --------------------------------------------------------------
 
     /**
@@ -228,6 +275,16 @@ namespace mccore
     
   };
 
+  /**
+   * Hash function object over residue ids, for use with hashed
+   * containers.
+   */
+  class ResIdHash
+  {
+  public:
+    size_t operator() (const ResId &id) const { return id.hash (); }
+  };
+
   /**
    * Outputs the residue id to the exception stream.
    * @param os the exception stream.
@@ -0,0 +1,92 @@
+//                              -*- Mode: C++ -*-
+// ResIdIndex.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 00:44:57 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+// cmake generated defines
+#include <config.h>
+
+#include "ResIdIndex.h"
+
+
+
+namespace mccore
+{
+
+  const ResIdIndex::size_type ResIdIndex::npos = (ResIdIndex::size_type) -1;
+
+
+  ResIdIndex::size_type
+  ResIdIndex::find (const ResId &id) const
+  {
+    vector< Entry >::const_iterator it;
+
+    ResId::key_type key = id.getKey ();
+
+    it = std::lower_bound (entries.begin (), entries.end (),
+			   make_pair (key, (size_type) 0));
+    return (entries.end () != it && key == it->first
+	    ? it->second
+	    : npos);
+  }
+
+
+  void
+  ResIdIndex::insert (const ResId &id, size_type pos)
+  {
+    vector< Entry >::iterator it;
+
+    if (pos < entries.size ())
+      {
+	for (it = entries.begin (); entries.end () != it; ++it)
+	  {
+	    if (it->second >= pos)
+	      {
+		++it->second;
+	      }
+	  }
+      }
+    Entry entry (id.getKey (), pos);
+    entries.insert (std::upper_bound (entries.begin (), entries.end (), entry),
+		    entry);
+  }
+
+
+  void
+  ResIdIndex::erase (const ResId &id, size_type pos)
+  {
+    vector< Entry >::iterator it;
+    Entry entry (id.getKey (), pos);
+
+    it = std::lower_bound (entries.begin (), entries.end (), entry);
+    if (entries.end () != it && entry == *it)
+      {
+	entries.erase (it);
+      }
+    for (it = entries.begin (); entries.end () != it; ++it)
+      {
+	if (it->second > pos)
+	  {
+	    --it->second;
+	  }
+      }
+  }
+
+}
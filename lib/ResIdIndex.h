@@ -0,0 +1,181 @@
+//                              -*- Mode: C++ -*-
+// ResIdIndex.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 00:44:57 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+#ifndef _mccore_ResIdIndex_h_
+#define _mccore_ResIdIndex_h_
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include <vector>
+
+#include "ResId.h"
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * @short Sorted index from residue ids to model positions.
+   *
+   * The index is a flat vector of (ResId key, position) pairs kept sorted
+   * over the packed ResId key (see ResId::getKey), then over the position.  Duplicated ids are kept so
+   * that find returns the lowest position, as a linear scan would.
+   * Lookups are logarithmic and range queries over a chain and a residue
+   * number interval return the positions in ResId order.  Insertions and
+   * erasures shift the stored positions, which is linear like the
+   * corresponding vector operation in the model.
+   */
+  class ResIdIndex
+  {
+  public:
+
+    typedef vector< ResId >::size_type size_type;
+
+    /**
+     * Position returned when an id is not indexed.
+     */
+    static const size_type npos;
+
+  private:
+
+    typedef pair< ResId::key_type, size_type > Entry;
+
+    /**
+     * The sorted entries.
+     */
+    vector< Entry > entries;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the object.
+     */
+    ResIdIndex () { }
+
+    /**
+     * Destroys the object.
+     */
+    ~ResIdIndex () { }
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of indexed ids.
+     * @return the number of entries.
+     */
+    size_type size () const { return entries.size (); }
+
+    /**
+     * Tells if the index is empty.
+     * @return whether the index is empty.
+     */
+    bool empty () const { return entries.empty (); }
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Removes every entry.
+     */
+    void clear () { entries.clear (); }
+
+    /**
+     * Finds the lowest position associated to the residue id.
+     * @param id the residue id.
+     * @return the position or npos if the id is not indexed.
+     */
+    size_type find (const ResId &id) const;
+
+    /**
+     * Indexes the residue id at position pos.  The positions greater or
+     * equal to pos are shifted by one.
+     * @param id the residue id.
+     * @param pos the position in the model.
+     */
+    void insert (const ResId &id, size_type pos);
+
+    /**
+     * Removes the residue id at position pos from the index.  The positions
+     * greater than pos are shifted down by one.
+     * @param id the residue id that was at position pos.
+     * @param pos the position in the model.
+     */
+    void erase (const ResId &id, size_type pos);
+
+    /**
+     * Rebuilds the index from a range of residues.
+     * @param f the iterator on the first residue.
+     * @param l the iterator past the last residue.
+     */
+    template< class InputIterator >
+    void rebuild (InputIterator f, InputIterator l)
+    {
+      size_type pos;
+
+      entries.clear ();
+      for (pos = 0; l != f; ++f, ++pos)
+	{
+	  entries.push_back (make_pair (f->getResId ().getKey (), pos));
+	}
+      std::sort (entries.begin (), entries.end ());
+    }
+
+    /**
+     * Gets the positions of the residues in chain whose number is within
+     * [first, last].  Positions are written in ResId order.
+     * @param chain the chain id.
+     * @param first the lowest residue number.
+     * @param last the highest residue number.
+     * @param out the output iterator receiving the positions.
+     */
+    template< class OutputIterator >
+    void range (char chain, int first, int last, OutputIterator out) const
+    {
+      vector< Entry >::const_iterator it;
+      vector< Entry >::const_iterator stop;
+
+      if (first > last)
+	{
+	  return;
+	}
+      it = std::lower_bound (entries.begin (), entries.end (),
+			     make_pair (ResId (chain, first, CHAR_MIN).getKey (),
+					(size_type) 0));
+      stop = std::upper_bound (it, entries.end (),
+			       make_pair (ResId (chain, last, CHAR_MAX).getKey (),
+					  npos));
+      for (; stop != it; ++it)
+	{
+	  *out++ = it->second;
+	}
+    }
+
+  };
+
+}
+
+#endif
@@ -26,6 +26,9 @@
 // cmake generated defines
 #include <config.h>
 
+#include <algorithm>
+#include <string.h>
+
 #include "Binstream.h"
 #include "Exception.h"
 #include "Messagestream.h"
@@ -58,11 +61,570 @@ strsep (char **stringp, const char *delim)
 
 namespace mccore
 {
+
+  const ResIdSet::size_type ResIdSet::maxSpan = 1 << 16;
+
+
+  /**
+   * Counts the bits set in a word.
+   */
+  static inline unsigned int
+  bitCount (unsigned long w)
+  {
+#ifdef __GNUC__
+    return __builtin_popcountl (w);
+#else
+    unsigned int n;
+
+    for (n = 0; 0 != w; ++n)
+      {
+	w &= w - 1;
+      }
+    return n;
+#endif
+  }
+
+
+  /**
+   * Gets the index of the lowest bit set in a non null word.
+   */
+  static inline unsigned int
+  lowestBit (unsigned long w)
+  {
+#ifdef __GNUC__
+    return __builtin_ctzl (w);
+#else
+    unsigned int n;
+
+    for (n = 0; 0 == (w & 1); ++n)
+      {
+	w >>= 1;
+      }
+    return n;
+#endif
+  }
+
+
+
+  /**
+   * Gets the index of the highest bit set in a non null word.
+   */
+  static inline unsigned int
+  highestBit (unsigned long w)
+  {
+#ifdef __GNUC__
+    return sizeof (unsigned long) * CHAR_BIT - 1 - __builtin_clzl (w);
+#else
+    unsigned int n;
+
+    for (n = 0; 0 != (w >>= 1); ++n)
+      ;
+    return n;
+#endif
+  }
+
+  // ChainBitmap --------------------------------------------------------------
+
+  long long
+  ResIdSet::ChainBitmap::alignDown (long long no)
+  {
+    long long w = wordBits ();
+
+    return no >= 0 ? no - no % w : -((-no + w - 1) / w) * w;
+  }
+
+
+  ResIdSet::word_type
+  ResIdSet::ChainBitmap::wordAt (long long no) const
+  {
+    return inWindow (no) ? words[(no - offset) / wordBits ()] : 0;
+  }
+
+
+  bool
+  ResIdSet::ChainBitmap::contains (const ResId &id) const
+  {
+    if (' ' == id.getInsertionCode () && inWindow (id.getResNo ()))
+      {
+	return test (id.getResNo ());
+      }
+    return std::binary_search (extras.begin (), extras.end (), id.getKey ());
+  }
+
+
+  bool
+  ResIdSet::ChainBitmap::grow (long long lo, long long hi)
+  {
+    long long w = wordBits ();
+    long long newOffset = alignDown (lo);
+    long long newLimit = alignDown (hi) + w;
+    vector< ResId::key_type >::iterator it;
+
+    if (! words.empty ())
+      {
+	newOffset = std::min (newOffset, offset);
+	newLimit = std::max (newLimit, limit ());
+      }
+    if (newLimit - newOffset > (long long) maxSpan)
+      {
+	return false;
+      }
+    if (words.empty ())
+      {
+	offset = newOffset;
+	words.resize ((newLimit - newOffset) / w, 0);
+      }
+    else
+      {
+	words.insert (words.begin (), (offset - newOffset) / w, 0);
+	offset = newOffset;
+	words.resize ((newLimit - newOffset) / w, 0);
+      }
+
+    // Move the extras now covered by the bitmap.
+    for (it = extras.begin (); extras.end () != it;)
+      {
+	ResId id = ResId::fromKey (*it);
+
+	if (' ' == id.getInsertionCode () && inWindow (id.getResNo ()))
+	  {
+	    words[(id.getResNo () - offset) / w] |= (word_type) 1 << ((id.getResNo () - offset) % w);
+	    it = extras.erase (it);
+	  }
+	else
+	  {
+	    ++it;
+	  }
+      }
+    return true;
+  }
+
+
+  bool
+  ResIdSet::ChainBitmap::insert (const ResId &id)
+  {
+    vector< ResId::key_type >::iterator it;
+    ResId::key_type key;
+
+    if (' ' == id.getInsertionCode ()
+	&& grow (id.getResNo (), id.getResNo ()))
+      {
+	long long pos = id.getResNo () - offset;
+	word_type mask = (word_type) 1 << (pos % wordBits ());
+
+	if (0 != (words[pos / wordBits ()] & mask))
+	  {
+	    return false;
+	  }
+	words[pos / wordBits ()] |= mask;
+	++count;
+	return true;
+      }
+    key = id.getKey ();
+    it = std::lower_bound (extras.begin (), extras.end (), key);
+    if (extras.end () != it && key == *it)
+      {
+	return false;
+      }
+    extras.insert (it, key);
+    ++count;
+    return true;
+  }
+
+
+  void
+  ResIdSet::ChainBitmap::insertRange (int first, int last)
+  {
+    long long no;
+
+    if (grow (first, last))
+      {
+	for (no = first; no <= last; ++no)
+	  {
+	    words[(no - offset) / wordBits ()] |= (word_type) 1 << ((no - offset) % wordBits ());
+	  }
+	recount ();
+      }
+    else
+      {
+	for (no = first; no <= last; ++no)
+	  {
+	    insert (ResId (chain, (int) no));
+	  }
+      }
+  }
+
+
+  bool
+  ResIdSet::ChainBitmap::erase (const ResId &id)
+  {
+    if (' ' == id.getInsertionCode () && inWindow (id.getResNo ()))
+      {
+	long long pos = id.getResNo () - offset;
+	word_type mask = (word_type) 1 << (pos % wordBits ());
+
+	if (0 == (words[pos / wordBits ()] & mask))
+	  {
+	    return false;
+	  }
+	words[pos / wordBits ()] &= ~mask;
+	--count;
+	return true;
+      }
+    else
+      {
+	vector< ResId::key_type >::iterator it;
+	ResId::key_type key = id.getKey ();
+
+	it = std::lower_bound (extras.begin (), extras.end (), key);
+	if (extras.end () == it || key != *it)
+	  {
+	    return false;
+	  }
+	extras.erase (it);
+	--count;
+	return true;
+      }
+  }
+
+
+  long long
+  ResIdSet::ChainBitmap::nextBit (long long no) const
+  {
+    vector< word_type >::size_type index;
+    word_type w;
+
+    if (no < offset)
+      {
+	no = offset;
+      }
+    if (no >= limit ())
+      {
+	return LLONG_MAX;
+      }
+    index = (no - offset) / wordBits ();
+    w = words[index] & (~(word_type) 0 << ((no - offset) % wordBits ()));
+    while (0 == w)
+      {
+	if (words.size () == ++index)
+	  {
+	    return LLONG_MAX;
+	  }
+	w = words[index];
+      }
+    return offset + (long long) index * wordBits () + lowestBit (w);
+  }
+
+
+  long long
+  ResIdSet::ChainBitmap::prevBit (long long no) const
+  {
+    vector< word_type >::size_type index;
+    word_type w;
+
+    if (no >= limit ())
+      {
+	no = limit () - 1;
+      }
+    if (no < offset)
+      {
+	return LLONG_MIN;
+      }
+    index = (no - offset) / wordBits ();
+    w = words[index] & (~(word_type) 0 >> (wordBits () - 1 - (no - offset) % wordBits ()));
+    while (0 == w)
+      {
+	if (0 == index)
+	  {
+	    return LLONG_MIN;
+	  }
+	w = words[--index];
+      }
+    return offset + (long long) index * wordBits () + highestBit (w);
+  }
+
+
+  void
+  ResIdSet::ChainBitmap::recount ()
+  {
+    vector< word_type >::const_iterator it;
+
+    count = extras.size ();
+    for (it = words.begin (); words.end () != it; ++it)
+      {
+	count += bitCount (*it);
+      }
+  }
+
+
+  void
+  ResIdSet::ChainBitmap::unite (const ChainBitmap &right)
+  {
+    vector< ResId::key_type >::const_iterator it;
+
+    if (! right.words.empty ())
+      {
+	if (grow (right.offset, right.limit () - 1))
+	  {
+	    vector< word_type >::size_type shift;
+	    vector< word_type >::size_type i;
+
+	    shift = (right.offset - offset) / wordBits ();
+	    for (i = 0; i < right.words.size (); ++i)
+	      {
+		words[shift + i] |= right.words[i];
+	      }
+	  }
+	else
+	  {
+	    long long no;
+
+	    for (no = right.nextBit (right.offset); LLONG_MAX != no; no = right.nextBit (no + 1))
+	      {
+		insert (ResId (chain, (int) no));
+	      }
+	  }
+      }
+    for (it = right.extras.begin (); right.extras.end () != it; ++it)
+      {
+	insert (ResId::fromKey (*it));
+      }
+    recount ();
+  }
+
+
+  void
+  ResIdSet::ChainBitmap::intersect (const ChainBitmap &right)
+  {
+    vector< word_type > result (words.size (), 0);
+    vector< ResId::key_type > kept;
+    vector< ResId::key_type >::const_iterator it;
+    vector< word_type >::size_type i;
+
+    for (it = extras.begin (); extras.end () != it; ++it)
+      {
+	if (right.contains (ResId::fromKey (*it)))
+	  {
+	    kept.push_back (*it);
+	  }
+      }
+    for (i = 0; i < words.size (); ++i)
+      {
+	result[i] = words[i] & right.wordAt (offset + (long long) i * wordBits ());
+      }
+    // Ids of our bitmap that right keeps in its extras.
+    for (it = right.extras.begin (); right.extras.end () != it; ++it)
+      {
+	ResId id = ResId::fromKey (*it);
+
+	if (' ' == id.getInsertionCode ()
+	    && inWindow (id.getResNo ())
+	    && test (id.getResNo ()))
+	  {
+	    long long pos = id.getResNo () - offset;
+
+	    result[pos / wordBits ()] |= (word_type) 1 << (pos % wordBits ());
+	  }
+      }
+    words.swap (result);
+    extras.swap (kept);
+    recount ();
+  }
+
+
+  void
+  ResIdSet::ChainBitmap::subtract (const ChainBitmap &right)
+  {
+    vector< ResId::key_type > kept;
+    vector< ResId::key_type >::const_iterator it;
+    vector< word_type >::size_type i;
+
+    for (it = extras.begin (); extras.end () != it; ++it)
+      {
+	if (! right.contains (ResId::fromKey (*it)))
+	  {
+	    kept.push_back (*it);
+	  }
+      }
+    for (i = 0; i < words.size (); ++i)
+      {
+	words[i] &= ~right.wordAt (offset + (long long) i * wordBits ());
+      }
+    for (it = right.extras.begin (); right.extras.end () != it; ++it)
+      {
+	ResId id = ResId::fromKey (*it);
+
+	if (' ' == id.getInsertionCode () && inWindow (id.getResNo ()))
+	  {
+	    long long pos = id.getResNo () - offset;
+
+	    words[pos / wordBits ()] &= ~((word_type) 1 << (pos % wordBits ()));
+	  }
+      }
+    extras.swap (kept);
+    recount ();
+  }
+
+  // ResIdSetIterator ---------------------------------------------------------
+
+  void
+  ResIdSet::ResIdSetIterator::startChain ()
+  {
+    for (; owner->chains.size () > chainIndex; ++chainIndex)
+      {
+	bit = owner->chains[chainIndex].offset;
+	extraIndex = 0;
+	if (settle ())
+	  {
+	    return;
+	  }
+      }
+  }
+
+
+  bool
+  ResIdSet::ResIdSetIterator::settle ()
+  {
+    const ChainBitmap &chain = owner->chains[chainIndex];
+    long long no = chain.nextBit (bit);
+    bool hasExtra = chain.extras.size () > extraIndex;
+
+    if (LLONG_MAX == no && ! hasExtra)
+      {
+	return false;
+      }
+    if (LLONG_MAX != no)
+      {
+	ResId id (chain.chain, (int) no);
+
+	if (! hasExtra || id.getKey () < chain.extras[extraIndex])
+	  {
+	    bit = no;
+	    fromBitmap = true;
+	    current = id;
+	    return true;
+	  }
+      }
+    fromBitmap = false;
+    current = ResId::fromKey (chain.extras[extraIndex]);
+    return true;
+  }
+
+
+  ResIdSet::ResIdSetIterator&
+  ResIdSet::ResIdSetIterator::operator++ ()
+  {
+    if (fromBitmap)
+      {
+	++bit;
+      }
+    else
+      {
+	++extraIndex;
+      }
+    if (! settle ())
+      {
+	++chainIndex;
+	startChain ();
+      }
+    return *this;
+  }
+
+
+
+  bool
+  ResIdSet::ResIdSetIterator::retreat (const ResId *limit)
+  {
+    const ChainBitmap &chain = owner->chains[chainIndex];
+    vector< ResId::key_type >::size_type e;
+    long long no;
+
+    // The last bitmap number and the number of extras before the limit.
+    if (0 == limit)
+      {
+	no = chain.prevBit (LLONG_MAX);
+	e = chain.extras.size ();
+      }
+    else
+      {
+	no = chain.prevBit (' ' < limit->getInsertionCode ()
+			    ? (long long) limit->getResNo ()
+			    : (long long) limit->getResNo () - 1);
+	e = std::lower_bound (chain.extras.begin (), chain.extras.end (), limit->getKey ()) - chain.extras.begin ();
+      }
+    if (LLONG_MIN == no && 0 == e)
+      {
+	return false;
+      }
+    if (LLONG_MIN != no
+	&& (0 == e || chain.extras[e - 1] < ResId (chain.chain, (int) no).getKey ()))
+      {
+	fromBitmap = true;
+	bit = no;
+	extraIndex = e;
+	current = ResId (chain.chain, (int) no);
+      }
+    else
+      {
+	fromBitmap = false;
+	extraIndex = e - 1;
+	current = ResId::fromKey (chain.extras[e - 1]);
+	bit = (long long) current.getResNo () + 1;
+      }
+    return true;
+  }
+
+
+  ResIdSet::ResIdSetIterator&
+  ResIdSet::ResIdSetIterator::operator-- ()
+  {
+    ResId limit (current);
+    bool found;
+
+    found = owner->chains.size () > chainIndex && retreat (&limit);
+    while (! found && 0 < chainIndex)
+      {
+	--chainIndex;
+	found = retreat (0);
+      }
+    return *this;
+  }
+
+  // ResIdSet -----------------------------------------------------------------
+
+  ResIdSet::ResIdSet ()
+    : total (0)
+  {
+    std::fill (chainSlots, chainSlots + UCHAR_MAX + 1, 0);
+    mIndex = begin ();
+  }
+
+
+  ResIdSet::ResIdSet (const ResIdSet &right)
+    : chains (right.chains),
+      total (right.total),
+      mIndex (right.mIndex)
+  {
+    std::copy (right.chainSlots, right.chainSlots + UCHAR_MAX + 1, chainSlots);
+    mIndex.owner = this;
+  }
+
+
+  ResIdSet::ResIdSet (const char *str)
+    : total (0)
+  {
+    std::fill (chainSlots, chainSlots + UCHAR_MAX + 1, 0);
+    _parse_and_insert (str);
+    mIndex = begin ();
+  }
+
   
   ResIdSet::ResIdSet (int resno, char chainid)
-    : mIndex (begin ())
+    : total (0)
   {
+    std::fill (chainSlots, chainSlots + UCHAR_MAX + 1, 0);
     insert (resno, chainid);
+    mIndex = begin ();
   }
   
   
@@ -71,11 +633,108 @@ namespace mccore
   {
     if (this != &right)
       {
-	set< ResId >::operator= (right);
+	chains = right.chains;
+	std::copy (right.chainSlots, right.chainSlots + UCHAR_MAX + 1, chainSlots);
+	total = right.total;
 	mIndex = right.mIndex;
+	mIndex.owner = this;
+      }
+    return *this;
+  }
+
+
+  bool
+  ResIdSet::operator== (const ResIdSet &right) const
+  {
+    const_iterator cit;
+
+    if (this == &right)
+      {
+	return true;
+      }
+    if (size () != right.size ())
+      {
+	return false;
+      }
+    for (cit = begin (); end () != cit; ++cit)
+      {
+	if (! right.contains (*cit))
+	  {
+	    return false;
+	  }
+      }
+    return true;
+  }
+
+
+  ResIdSet&
+  ResIdSet::operator|= (const ResIdSet &right)
+  {
+    vector< ChainBitmap >::const_iterator it;
+
+    if (this != &right)
+      {
+	for (it = right.chains.begin (); right.chains.end () != it; ++it)
+	  {
+	    if (0 != it->count)
+	      {
+		getChain (it->chain).unite (*it);
+	      }
+	  }
+	normalize ();
       }
     return *this;
   }
+
+
+  ResIdSet&
+  ResIdSet::operator&= (const ResIdSet &right)
+  {
+    vector< ChainBitmap >::iterator it;
+
+    if (this != &right)
+      {
+	for (it = chains.begin (); chains.end () != it; ++it)
+	  {
+	    short slot = right.chainSlots[(unsigned char) it->chain];
+
+	    if (0 == slot)
+	      {
+		it->count = 0;
+	      }
+	    else
+	      {
+		it->intersect (right.chains[slot - 1]);
+	      }
+	  }
+	normalize ();
+      }
+    return *this;
+  }
+
+
+  ResIdSet&
+  ResIdSet::operator-= (const ResIdSet &right)
+  {
+    vector< ChainBitmap >::iterator it;
+
+    if (this == &right)
+      {
+	clear ();
+	return *this;
+      }
+    for (it = chains.begin (); chains.end () != it; ++it)
+      {
+	short slot = right.chainSlots[(unsigned char) it->chain];
+
+	if (0 != slot)
+	  {
+	    it->subtract (right.chains[slot - 1]);
+	  }
+      }
+    normalize ();
+    return *this;
+  }
   
   
   ResIdSet&
@@ -109,6 +768,140 @@ namespace mccore
   }
 
 
+  ResIdSet::const_iterator
+  ResIdSet::find (const ResId &resid) const
+  {
+    short slot = chainSlots[(unsigned char) resid.getChainId ()];
+    const_iterator it;
+    const ChainBitmap *chain;
+
+    if (0 == slot || ! chains[slot - 1].contains (resid))
+      {
+	return end ();
+      }
+    chain = &chains[slot - 1];
+    it.owner = this;
+    it.chainIndex = slot - 1;
+    it.bit = (' ' < resid.getInsertionCode ()
+	      ? (long long) resid.getResNo () + 1
+	      : resid.getResNo ());
+    it.extraIndex = std::lower_bound (chain->extras.begin (), chain->extras.end (), resid.getKey ()) - chain->extras.begin ();
+    it.settle ();
+    return it;
+  }
+
+
+  ResIdSet::const_iterator
+  ResIdSet::lower_bound (const ResId &resid) const
+  {
+    short slot = chainSlots[(unsigned char) resid.getChainId ()];
+    const_iterator it;
+    const ChainBitmap *chain;
+
+    it.owner = this;
+    if (0 == slot)
+      {
+	for (it.chainIndex = 0;
+	     chains.size () > it.chainIndex && ResId (chains[it.chainIndex].chain, 0) < ResId (resid.getChainId (), 0);
+	     ++it.chainIndex)
+	  ;
+	it.startChain ();
+	return it;
+      }
+    chain = &chains[slot - 1];
+    it.chainIndex = slot - 1;
+    it.bit = (' ' < resid.getInsertionCode ()
+	      ? (long long) resid.getResNo () + 1
+	      : resid.getResNo ());
+    it.extraIndex = std::lower_bound (chain->extras.begin (), chain->extras.end (), resid.getKey ()) - chain->extras.begin ();
+    if (! it.settle ())
+      {
+	++it.chainIndex;
+	it.startChain ();
+      }
+    return it;
+  }
+
+
+  ResIdSet::const_iterator
+  ResIdSet::upper_bound (const ResId &resid) const
+  {
+    const_iterator it = lower_bound (resid);
+
+    if (end () != it && *it == resid)
+      {
+	++it;
+      }
+    return it;
+  }
+
+
+  void
+  ResIdSet::clear ()
+  {
+    chains.clear ();
+    std::fill (chainSlots, chainSlots + UCHAR_MAX + 1, 0);
+    total = 0;
+    mIndex = begin ();
+  }
+
+
+  ResIdSet::ChainBitmap&
+  ResIdSet::getChain (char chain)
+  {
+    short slot = chainSlots[(unsigned char) chain];
+    vector< ChainBitmap >::iterator it;
+
+    if (0 != slot)
+      {
+	return chains[slot - 1];
+      }
+    for (it = chains.begin ();
+	 chains.end () != it && ResId (it->chain, 0) < ResId (chain, 0);
+	 ++it)
+      ;
+    it = chains.insert (it, ChainBitmap (chain));
+    rebuildSlots ();
+    return *it;
+  }
+
+
+  void
+  ResIdSet::rebuildSlots ()
+  {
+    vector< ChainBitmap >::size_type i;
+
+    std::fill (chainSlots, chainSlots + UCHAR_MAX + 1, 0);
+    for (i = 0; i < chains.size (); ++i)
+      {
+	chainSlots[(unsigned char) chains[i].chain] = i + 1;
+      }
+  }
+
+
+  void
+  ResIdSet::normalize ()
+  {
+    vector< ChainBitmap >::iterator it;
+
+    total = 0;
+    for (it = chains.begin (); chains.end () != it;)
+      {
+	if (0 == it->count)
+	  {
+	    it = chains.erase (it);
+	  }
+	else
+	  {
+	    total += it->count;
+	    ++it;
+	  }
+      }
+    rebuildSlots ();
+    mIndex = begin ();
+  }
+
+
   void
   ResIdSet::_parse_and_insert (const char *str)
   {
@@ -131,7 +924,7 @@ namespace mccore
 	    upper = strsep (&token, "-");
 
 	    ResId low (lower);
-	    insert (low);
+	    add (low);
 	    if (upper)
 	      {
 		ResId upp (upper);
@@ -139,12 +932,11 @@ namespace mccore
 		if (low.getChainId () == upp.getChainId ()
 		    && low.getResNo () < upp.getResNo ())
 		  {
-		    char chain = low.getChainId ();
-		    int start = low.getResNo () + 1;
-		    int end = upp.getResNo ();
-		  
-		    for (; start <= end; ++start)
-		      insert (start, chain);
+		    ChainBitmap &chain = getChain (low.getChainId ());
+		    size_type before = chain.count;
+
+		    chain.insertRange (low.getResNo () + 1, upp.getResNo ());
+		    total += chain.count - before;
 		  }
 		else
 		  {
@@ -162,7 +954,58 @@ namespace mccore
   void
   ResIdSet::insert (int resno, char chainid)
   {
-    set< ResId >::insert (ResId (chainid, resno));
+    add (ResId (chainid, resno));
+  }
+
+
+  bool
+  ResIdSet::add (const ResId &resid)
+  {
+    if (getChain (resid.getChainId ()).insert (resid))
+      {
+	++total;
+	return true;
+      }
+    return false;
+  }
+
+
+  ResIdSet::size_type
+  ResIdSet::erase (const ResId &resid)
+  {
+    short slot = chainSlots[(unsigned char) resid.getChainId ()];
+
+    if (0 != slot && chains[slot - 1].erase (resid))
+      {
+	--total;
+	return 1;
+      }
+    return 0;
+  }
+
+
+  void
+  ResIdSet::erase (iterator first, iterator last)
+  {
+    vector< ResId > ids (first, last);
+    vector< ResId >::iterator it;
+
+    for (it = ids.begin (); ids.end () != it; ++it)
+      {
+	erase (*it);
+      }
+  }
+
+
+  void
+  ResIdSet::swap (ResIdSet &right)
+  {
+    chains.swap (right.chains);
+    std::swap_ranges (chainSlots, chainSlots + UCHAR_MAX + 1, right.chainSlots);
+    std::swap (total, right.total);
+    std::swap (mIndex, right.mIndex);
+    mIndex.owner = this;
+    right.mIndex.owner = &right;
   }
 
 
@@ -185,7 +1028,7 @@ namespace mccore
       ResId id;
 
       ibs >> id;
-      obj.insert (obj.end (), id);
+      obj.insert (id);
     }
     return ibs;
   }
@@ -26,7 +26,12 @@
 #ifndef _mccore_ResIdSet_h_
 #define _mccore_ResIdSet_h_
 
+#include <climits>
+#include <functional>
+#include <iterator>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "ResId.h"
 #include "Messagestream.h"
@@ -46,16 +51,260 @@ namespace mccore
    * 
    * This class represents the idea of a range of residue id.
    *
+   * The ids are stored per chain.  Ids without insertion code are bits in
+   * a bitmap covering the chain residue number interval, so membership is
+   * tested in constant time and set algebra (|=, &=, -=) works a word at a
+   * time.  Ids with an insertion code, or whose number would stretch the
+   * bitmap beyond maxSpan residues, are kept in a sorted list of packed
+   * keys.  Iteration yields the ids in ResId order.
+   *
+   * The class keeps the interface of the set< ResId > it used to derive
+   * from: the set typedefs, bidirectional const iterators, find,
+   * lower_bound, upper_bound, equal_range, the insert and erase overloads
+   * and swap.  Ids are values computed on the fly, so the iterators hold
+   * the current id and reverse iterators are not provided.
+   *
+   * A ResIdSet is no longer a set< ResId >: it converts to a const
+   * set< ResId > copy, so it may still be passed by value or by const
+   * reference where a set is expected, but not as a non const
+   * set< ResId >& nor through a set< ResId > pointer.
+   *
    * @author Martin Larose (<a href="larosem@iro.umontreal.ca">larosem@iro.umontreal.ca</a>)
    */
-  class ResIdSet : public set< ResId >
+  class ResIdSet
   {
   public:
-    typedef ResId     value_type;
-    typedef ResId&    reference;
-    typedef ResId*    pointer;
+    typedef ResId          key_type;
+    typedef ResId          value_type;
+    typedef less< ResId >  key_compare;
+    typedef less< ResId >  value_compare;
+    typedef const ResId&   reference;
+    typedef const ResId&   const_reference;
+    typedef const ResId*   pointer;
+    typedef const ResId*   const_pointer;
+    typedef unsigned int   size_type;
+    typedef ptrdiff_t      difference_type;
+
+    /**
+     * The maximum number of residue numbers a chain bitmap may cover.
+     */
+    static const size_type maxSpan;
+
+  private:
+
+    typedef unsigned long word_type;
+
+    /**
+     * The ids of a single chain.
+     */
+    class ChainBitmap
+    {
+    public:
+
+      /**
+       * The chain id.
+       */
+      char chain;
+
+      /**
+       * The residue number of the first bit, a multiple of the word size.
+       */
+      long long offset;
+
+      /**
+       * The bitmap over residue numbers (no insertion code).
+       */
+      vector< word_type > words;
+
+      /**
+       * The sorted packed keys of the ids not in the bitmap.
+       */
+      vector< ResId::key_type > extras;
+
+      /**
+       * The number of ids in the chain.
+       */
+      size_type count;
+
+      ChainBitmap (char c) : chain (c), offset (0), count (0) { }
+
+      long long limit () const
+      {
+	return offset + (long long) words.size () * wordBits ();
+      }
+
+      bool inWindow (long long no) const
+      {
+	return offset <= no && no < limit ();
+      }
+
+      bool test (long long no) const
+      {
+	return 0 != (words[(no - offset) / wordBits ()]
+		     & ((word_type) 1 << ((no - offset) % wordBits ())));
+      }
+
+      bool contains (const ResId &id) const;
+
+      bool insert (const ResId &id);
+
+      void insertRange (int first, int last);
+
+      bool erase (const ResId &id);
+
+      bool grow (long long lo, long long hi);
+
+      long long nextBit (long long no) const;
+
+      long long prevBit (long long no) const;
+
+      void recount ();
+
+      void unite (const ChainBitmap &right);
+
+      void intersect (const ChainBitmap &right);
+
+      void subtract (const ChainBitmap &right);
+
+      word_type wordAt (long long no) const;
+
+      static unsigned int wordBits () { return sizeof (word_type) * CHAR_BIT; }
+
+      static long long alignDown (long long no);
+    };
+
+  public:
+
+    // ITERATORS ------------------------------------------------------------
+
+    /**
+     * @short Bidirectional iterator over the ids of a ResIdSet, in ResId
+     * order.
+     */
+    class ResIdSetIterator
+    {
+      friend class ResIdSet;
+
+    public:
+
+      typedef bidirectional_iterator_tag iterator_category;
+      typedef ResId value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const ResId* pointer;
+      typedef const ResId& reference;
+
+    private:
+
+      /**
+       * The iterated set.
+       */
+      const ResIdSet *owner;
+
+      /**
+       * The current chain index.
+       */
+      vector< ChainBitmap >::size_type chainIndex;
+
+      /**
+       * The next bitmap residue number to consider.
+       */
+      long long bit;
+
+      /**
+       * The next extra index to consider.
+       */
+      vector< ResId::key_type >::size_type extraIndex;
+
+      /**
+       * Whether the current id comes from the bitmap.
+       */
+      bool fromBitmap;
+
+      /**
+       * The current id.
+       */
+      ResId current;
+
+      ResIdSetIterator (const ResIdSet *s, vector< ChainBitmap >::size_type c)
+	: owner (s), chainIndex (c), bit (0), extraIndex (0), fromBitmap (false)
+      {
+	startChain ();
+      }
+
+      void startChain ();
+
+      bool settle ();
+
+      bool retreat (const ResId *limit);
+
+    public:
+
+      /**
+       * Initializes the iterator.
+       */
+      ResIdSetIterator ()
+	: owner (0), chainIndex (0), bit (0), extraIndex (0), fromBitmap (false)
+      { }
+
+      const ResId& operator* () const { return current; }
+
+      const ResId* operator-> () const { return &current; }
+
+      ResIdSetIterator& operator++ ();
+
+      ResIdSetIterator operator++ (int)
+      {
+	ResIdSetIterator copy (*this);
+
+	operator++ ();
+	return copy;
+      }
+
+      ResIdSetIterator& operator-- ();
+
+      ResIdSetIterator operator-- (int)
+      {
+	ResIdSetIterator copy (*this);
+
+	operator-- ();
+	return copy;
+      }
+
+      bool operator== (const ResIdSetIterator &right) const
+      {
+	return (owner == right.owner
+		&& chainIndex == right.chainIndex
+		&& (owner == 0
+		    || owner->chains.size () == chainIndex
+		    || current == right.current));
+      }
+
+      bool operator!= (const ResIdSetIterator &right) const
+      {
+	return ! operator== (right);
+      }
+    };
+
+    typedef ResIdSetIterator iterator;
+    typedef ResIdSetIterator const_iterator;
+
+  private:
+
+    /**
+     * The chains sorted in ResId chain order.
+     */
+    vector< ChainBitmap > chains;
+
+    /**
+     * Chain id to index in chains plus one, 0 when absent.
+     */
+    short chainSlots[UCHAR_MAX + 1];
+
+    /**
+     * The number of ids in the set.
+     */
+    size_type total;
     
-  private:  
     /**
      * The index over the set.
      */
@@ -68,21 +317,20 @@ namespace mccore
     /**
      * Initializes the object.
      */
-    ResIdSet () : set< ResId > (), mIndex (begin ()) { }
+    ResIdSet ();
     
     /**
      * Initializes the object with the right's content.
      * @param right the object to copy.
      */
-    ResIdSet (const ResIdSet &right)
-      : set< ResId > (right), mIndex (right.mIndex) { }
+    ResIdSet (const ResIdSet &right);
     
     /**
      * Initializes the object with a range of residue id.  See the
      * _parse_and_insert method.
      * @param str the string containing the range.
      */
-    ResIdSet (const char *str) { _parse_and_insert (str); }
+    ResIdSet (const char *str);
     
     /**
      * Initializes the object with a residue number and a chain id.
@@ -104,6 +352,44 @@ namespace mccore
      * @return itself.
      */
     ResIdSet& operator= (const ResIdSet &right);
+
+    /**
+     * Tests whether the sets contain the same ids.
+     * @param right the set to compare.
+     * @return whether the sets are equal.
+     */
+    bool operator== (const ResIdSet &right) const;
+
+    /**
+     * Tests whether the sets differ.
+     * @param right the set to compare.
+     * @return whether the sets differ.
+     */
+    bool operator!= (const ResIdSet &right) const
+    {
+      return ! operator== (right);
+    }
+
+    /**
+     * Adds the ids of right to this set.
+     * @param right the set to unite with.
+     * @return itself.
+     */
+    ResIdSet& operator|= (const ResIdSet &right);
+
+    /**
+     * Keeps only the ids also present in right.
+     * @param right the set to intersect with.
+     * @return itself.
+     */
+    ResIdSet& operator&= (const ResIdSet &right);
+
+    /**
+     * Removes the ids present in right.
+     * @param right the set to subtract.
+     * @return itself.
+     */
+    ResIdSet& operator-= (const ResIdSet &right);
     
     /**
      * Pre-increases the index.
@@ -131,8 +417,113 @@ namespace mccore
      * @return the residue number.
      */
     int getResNo () const;
+
+    /**
+     * Gets the iterator over the first id.
+     * @return the iterator.
+     */
+    const_iterator begin () const { return const_iterator (this, 0); }
+
+    /**
+     * Gets the iterator past the last id.
+     * @return the iterator.
+     */
+    const_iterator end () const { return const_iterator (this, chains.size ()); }
+
+    /**
+     * Gets the number of ids in the set.
+     * @return the number of ids.
+     */
+    size_type size () const { return total; }
+
+    /**
+     * Tells if the set is empty.
+     * @return whether the set is empty.
+     */
+    bool empty () const { return 0 == total; }
+
+    /**
+     * Gets the maximum number of ids in a set.
+     * @return the maximum number of ids.
+     */
+    size_type max_size () const { return UINT_MAX; }
+
+    /**
+     * Gets the id comparison function.
+     * @return the comparison function.
+     */
+    key_compare key_comp () const { return key_compare (); }
+
+    /**
+     * Gets the id comparison function.
+     * @return the comparison function.
+     */
+    value_compare value_comp () const { return value_compare (); }
     
     // METHODS --------------------------------------------------------------
+
+    /**
+     * Tests in constant time whether the id is in the set.
+     * @param resid the residue id.
+     * @return whether the id is in the set.
+     */
+    bool contains (const ResId &resid) const
+    {
+      short slot = chainSlots[(unsigned char) resid.getChainId ()];
+
+      return 0 != slot && chains[slot - 1].contains (resid);
+    }
+
+    /**
+     * Counts the occurences of the id in the set.
+     * @param resid the residue id.
+     * @return 1 if the id is in the set, 0 otherwise.
+     */
+    size_type count (const ResId &resid) const { return contains (resid) ? 1 : 0; }
+
+    /**
+     * Finds an id in the set.
+     * @param resid the residue id.
+     * @return the iterator over the id or end () if not found.
+     */
+    const_iterator find (const ResId &resid) const;
+
+    /**
+     * Finds the first id not less than resid.
+     * @param resid the residue id.
+     * @return the iterator over the id or end () if there is none.
+     */
+    const_iterator lower_bound (const ResId &resid) const;
+
+    /**
+     * Finds the first id greater than resid.
+     * @param resid the residue id.
+     * @return the iterator over the id or end () if there is none.
+     */
+    const_iterator upper_bound (const ResId &resid) const;
+
+    /**
+     * Finds the range of the ids equal to resid.
+     * @param resid the residue id.
+     * @return the lower and upper bounds of resid.
+     */
+    pair< const_iterator, const_iterator > equal_range (const ResId &resid) const
+    {
+      return make_pair (lower_bound (resid), upper_bound (resid));
+    }
+
+    /**
+     * Removes every id from the set.
+     */
+    void clear ();
+
+    // CONVERSION -----------------------------------------------------------
+
+    /**
+     * Copies the ids into a set< ResId >.
+     * @return the set of ids.
+     */
+    operator set< ResId > () const { return set< ResId > (begin (), end ()); }
     
   private:
     /**
@@ -151,6 +542,32 @@ namespace mccore
      * @exception IntLibException.
      */
     void _parse_and_insert (const char *str);
+
+    /**
+     * Gets the chain bitmap, creating it if needed.
+     * @param chain the chain id.
+     * @return the chain bitmap.
+     */
+    ChainBitmap& getChain (char chain);
+
+    /**
+     * Rebuilds the chain slots from the chain vector.
+     */
+    void rebuildSlots ();
+
+    /**
+     * Removes the empty chains, rebuilds the chain slots and recomputes the
+     * total.
+     */
+    void normalize ();
+
+    /**
+     * Inserts a ResId without looking up its position.
+     * @param resid the residue id to insert.
+     * @return whether the id was not already in the set.
+     */
+    bool add (const ResId &resid);
+
   public:
     
     /**
@@ -174,8 +591,15 @@ namespace mccore
     /**
      * Inserts a ResId in the range.
      * @param resid the residue id to insert.
+     * @return the iterator over the id and whether it was inserted, as
+     * set< ResId >::insert.
      */
-    void insert (const ResId &resid) { set< ResId >::insert (resid); }
+    pair< const_iterator, bool > insert (const ResId &resid)
+    {
+      bool inserted = add (resid);
+
+      return make_pair (find (resid), inserted);
+    }
     
     /**
      * Inserts a range of ResId in the object.
@@ -184,17 +608,49 @@ namespace mccore
      */
     template<class _InputIterator>
     void insert (_InputIterator __first, _InputIterator __last)
-    { set< ResId >::insert (__first, __last); }
+    {
+      for (; __last != __first; ++__first)
+	{
+	  add (*__first);
+	}
+    }
     
     /**
-     * Inserts a residue id into the object using a position as a hint to
-     * where it will be inserted.
-     * @param __pos the position.
+     * Inserts a residue id into the object.  The position hint is ignored,
+     * it is kept for compatibility.
      * @param resid the residue id to insert.
      * @return the iterator over the inserted element.
      */
-    iterator insert (iterator __pos, const value_type &resid)
-    { return set< ResId >::insert (__pos, resid); }
+    iterator insert (iterator, const value_type &resid)
+    {
+      return insert (resid).first;
+    }
+
+    /**
+     * Removes an id from the set.
+     * @param resid the residue id to remove.
+     * @return the number of removed ids.
+     */
+    size_type erase (const ResId &resid);
+
+    /**
+     * Removes the id at an iterator.
+     * @param pos the iterator over the id.
+     */
+    void erase (iterator pos) { erase (*pos); }
+
+    /**
+     * Removes the ids of a range.
+     * @param first the iterator over the first id to remove.
+     * @param last the iterator past the last id to remove.
+     */
+    void erase (iterator first, iterator last);
+
+    /**
+     * Exchanges the content of two sets.
+     * @param right the set to exchange with.
+     */
+    void swap (ResIdSet &right);
     
     /**
      * Resets the internal iterator to the beginning of the set.
@@ -204,6 +660,45 @@ namespace mccore
     // I/O  -----------------------------------------------------------------
     
   };
+
+  /**
+   * Computes the union of two sets.
+   * @param left the left operand.
+   * @param right the right operand.
+   * @return the union.
+   */
+  inline ResIdSet operator| (const ResIdSet &left, const ResIdSet &right)
+  {
+    ResIdSet result (left);
+
+    return result |= right;
+  }
+
+  /**
+   * Computes the intersection of two sets.
+   * @param left the left operand.
+   * @param right the right operand.
+   * @return the intersection.
+   */
+  inline ResIdSet operator& (const ResIdSet &left, const ResIdSet &right)
+  {
+    ResIdSet result (left);
+
+    return result &= right;
+  }
+
+  /**
+   * Computes the difference of two sets.
+   * @param left the left operand.
+   * @param right the right operand.
+   * @return the ids of left absent from right.
+   */
+  inline ResIdSet operator- (const ResIdSet &left, const ResIdSet &right)
+  {
+    ResIdSet result (left);
+
+    return result -= right;
+  }
   
   /**
    * Inputs the residue id set from a binary stream.
@@ -103,8 +103,12 @@ namespace mccore
       rib_O3p (0), rib_O4p (0), rib_O5p (0), rib_O1P (0), rib_O2P (0), rib_P (0),
       rib_dirty_ref (true),
       rib_built_valid (false),
-      rib_built_count (0)
+      rib_built_count (0),
+      arena (Arena::current ()),
+      conformer (0)
   {
+    if (0 != arena)
+      arena->ref ();
     this->setType (0);
   }
 
@@ -115,8 +119,12 @@ namespace mccore
       rib_O3p (0), rib_O4p (0), rib_O5p (0), rib_O1P (0), rib_O2P (0), rib_P (0),
       rib_dirty_ref (true),
       rib_built_valid (false),
-      rib_built_count (0)
+      rib_built_count (0),
+      arena (Arena::current ()),
+      conformer (0)
   {
+    if (0 != arena)
+      arena->ref ();
     this->setType (t);
   }
 
@@ -127,8 +135,12 @@ namespace mccore
       rib_O3p (0), rib_O4p (0), rib_O5p (0), rib_O1P (0), rib_O2P (0), rib_P (0),
       rib_dirty_ref (true),
       rib_built_valid (false),
-      rib_built_count (0)
+      rib_built_count (0),
+      arena (Arena::current ()),
+      conformer (0)
   {
+    if (0 != arena)
+      arena->ref ();
     vector< Atom >::const_iterator it;
 
     this->setType (t);
@@ -146,16 +158,21 @@ namespace mccore
       rib_O3p (0), rib_O4p (0), rib_O5p (0), rib_O1P (0), rib_O2P (0), rib_P (0),
       rib_dirty_ref (true),
       rib_built_valid (res.rib_built_valid),
-      rib_built_count (res.rib_built_count)
+      rib_built_count (res.rib_built_count),
+      arena (Arena::current ()),
+      conformer (res.conformer)
   {
     vector< Atom* >::iterator cit;
 
+    if (0 != arena)
+      arena->ref ();
+
     res.place (); // places globals if "res" is an ExtendedResidue
     this->atomGlobal = res.atomGlobal;
 
     // harden atoms
     for (cit = this->atomGlobal.begin (); cit != this->atomGlobal.end (); ++cit)
-      *cit = (*cit)->clone ();
+      *cit = this->_clone_atom (**cit);
   }
 
 
@@ -165,6 +182,8 @@ namespace mccore
 
     for (it = this->atomGlobal.begin (); it != this->atomGlobal.end (); ++it)
       delete *it;
+    if (0 != arena)
+      arena->unref ();
   }
 
   // VIRTUAL ASSIGNATION --------------------------------------------------
@@ -187,13 +206,14 @@ namespace mccore
     this->type = res.type;
     this->resId = res.resId;
     this->atomIndex = res.atomIndex;
+    this->conformer = res.conformer;
 
     // -- deep copy for atomGlobal
     for (it = this->atomGlobal.begin (); it != this->atomGlobal.end (); ++it)
       delete *it;
     this->atomGlobal = res.atomGlobal;
     for (it = this->atomGlobal.begin (); it != this->atomGlobal.end (); ++it)
-      *it = (*it)->clone ();
+      *it = this->_clone_atom (**it);
 
     // -- ribose pointers are reset, but building validity is kept from
     //    copied object.
@@ -427,7 +447,7 @@ namespace mccore
 
     if (inserted.second)
     {
-      atomGlobal.push_back (atom.clone ());
+      atomGlobal.push_back (_clone_atom (atom));
       rib_dirty_ref = true;
     }
     else
@@ -2326,7 +2346,7 @@ namespace mccore
 
     if (inserted.second)
     {
-      atomGlobal.push_back (new Atom (0.0, 0.0, 0.0, aType));
+      atomGlobal.push_back (new (arena) Atom (0.0, 0.0, 0.0, aType));
       rib_dirty_ref = true;
       return atomGlobal[pos];
     }
@@ -2337,6 +2357,15 @@ namespace mccore
   }
 
 
+  Atom*
+  Residue::_clone_atom (const Atom &atom) const
+  {
+    Arena::Scope scope (arena);
+
+    return atom.clone ();
+  }
+
+
   void
   Residue::_set_pseudos ()
   {
@@ -30,6 +30,7 @@
 #include <vector>
 #include <map>
 
+#include "Arena.h"
 #include "ResId.h"
 #include "Atom.h"
 #include "AtomType.h"
@@ -64,7 +65,7 @@ namespace mccore
    * @author Patrick Gendron (<a href="gendrop@iro.umontreal.ca">gendrop@iro.umontreal.ca</a>
    * @version $Id: Residue.h,v 1.43 2007-01-14 18:21:04 larosem Exp $
    */
-  class Residue
+  class Residue : public ArenaObject
   {
   public:
 
@@ -137,6 +138,17 @@ namespace mccore
      */
     unsigned int rib_built_count;
 
+    /**
+     * The arena receiving the atoms, null for the heap.  It is the arena
+     * current when the residue was built.
+     */
+    Arena *arena;
+
+    /**
+     * The conformer id, 0 when unknown.
+     */
+    unsigned int conformer;
+
   public:
 
     /**
@@ -638,6 +650,23 @@ namespace mccore
      */
     void setType (const ResidueType* t);
 
+    /**
+     * Gets the conformer id of the residue.
+     * @return the conformer id, 0 when unknown.
+     */
+    unsigned int getConformer () const { return conformer; }
+
+    /**
+     * Sets the conformer id of the residue.  Residues sharing a non null
+     * conformer id are declared to be rigid copies of each other: the same
+     * type and atoms, up to their referential.  The id is kept by copies and
+     * by rigid transformations, it is up to the caller to change it when the
+     * atoms of the residue are modified otherwise.  AnnotationCache relies
+     * on it to reuse the annotation of residue pairs.
+     * @param id the conformer id, 0 when unknown.
+     */
+    void setConformer (unsigned int id) { conformer = id; }
+
     /**
      * Gets the iterator begin.
      * @return the iterator over the first element.
@@ -1215,6 +1244,14 @@ namespace mccore
      */
     virtual Atom* _get_or_create (const AtomType *aType);
 
+    /**
+     * @internal
+     * Copies an atom in the residue's arena.
+     * @param atom the atom to copy.
+     * @return the new atom.
+     */
+    Atom* _clone_atom (const Atom &atom) const;
+
     /**
      * @internal
      * Set pseudo atoms PSX, PSY, PSZ and PSO to form a referential
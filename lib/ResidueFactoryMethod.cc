@@ -26,6 +26,7 @@
 // cmake generated defines
 #include <config.h>
 
+#include "Arena.h"
 #include "ExtendedResidue.h"
 #include "ResidueFactoryMethod.h"
 #include "Residue.h"
@@ -40,15 +41,56 @@
 namespace mccore
 {
 
-  ResidueFactoryMethod::ResidueFactoryMethod ()
+  ResidueFactoryMethod::ResidueFactoryMethod (bool pooled)
+    : arena (pooled ? new Arena () : 0)
   {
   }
 
 
   ResidueFactoryMethod::ResidueFactoryMethod (const ResidueFactoryMethod &right)
+    : arena (0 == right.arena ? 0 : new Arena ())
   {
   }
 
+
+  ResidueFactoryMethod::~ResidueFactoryMethod ()
+  {
+    if (0 != arena)
+      {
+	arena->unref ();
+      }
+  }
+
+
+  ResidueFactoryMethod&
+  ResidueFactoryMethod::operator= (const ResidueFactoryMethod &right)
+  {
+    if (this != &right)
+      {
+	if (0 != arena)
+	  {
+	    arena->unref ();
+	  }
+	arena = 0 == right.arena ? 0 : new Arena ();
+      }
+    return *this;
+  }
+
+
+  void
+  ResidueFactoryMethod::setPooled (bool pooled)
+  {
+    if (pooled && 0 == arena)
+      {
+	arena = new Arena ();
+      }
+    else if (! pooled && 0 != arena)
+      {
+	arena->unref ();
+	arena = 0;
+      }
+  }
+
   ResidueFactoryMethod*
   ResidueFactoryMethod::read (iBinstream& ibs)
   {
@@ -73,6 +115,8 @@ namespace mccore
   Residue* 
   ResidueFM::createResidue () const
   {
+    Arena::Scope scope (arena);
+
     return new Residue ();
   }
 
@@ -80,6 +124,8 @@ namespace mccore
   Residue* 
   ResidueFM::createResidue (const Residue& res) const
   {
+    Arena::Scope scope (arena);
+
     return new Residue (res);
   }
 
@@ -94,6 +140,8 @@ namespace mccore
   Residue* 
   ExtendedResidueFM::createResidue () const
   {
+    Arena::Scope scope (arena);
+
     return new ExtendedResidue ();
   }
 
@@ -101,6 +149,8 @@ namespace mccore
   Residue* 
   ExtendedResidueFM::createResidue (const Residue& res) const
   {
+    Arena::Scope scope (arena);
+
     return new ExtendedResidue (res);
   }
 
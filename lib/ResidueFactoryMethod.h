@@ -30,6 +30,7 @@
 
 namespace mccore
 {
+  class Arena;
   class Residue;
   class iBinstream;
   class oBinstream;
@@ -38,7 +39,11 @@ namespace mccore
    * @short Abstract class for residue factory methods.
    *
    * This class is used in Model to generate a given type of residue on input
-   * methods.
+   * methods.  A factory method may own an arena: the residues it creates,
+   * their atoms and the relations built over them are then allocated in
+   * the arena, and the memory is released in bulk with the factory method.
+   * Copies of the factory method get their own arena, so that each model
+   * owns one.
    *
    * @author Martin Larose (<a href="larosem@iro.umontreal.ca">larosem@iro.umontreal.ca</a>)
    * @version $Id: ResidueFactoryMethod.h,v 1.7 2005-02-25 16:48:14 thibaup Exp $
@@ -46,14 +51,22 @@ namespace mccore
   class ResidueFactoryMethod
   {
 
+  protected:
+
+    /**
+     * The arena receiving the residues, null for the heap.
+     */
+    Arena *arena;
+
   public:
 
     // LIFECYCLE ------------------------------------------------------------
 
     /**
      * Initializes the object.
+     * @param pooled whether the residues are allocated in an arena.
      */
-    ResidueFactoryMethod ();
+    explicit ResidueFactoryMethod (bool pooled = false);
 
     /**
      * Initializes the object with the right content.
@@ -69,12 +82,34 @@ namespace mccore
     /**
      * Destroys the object.
      */
-    virtual ~ResidueFactoryMethod () { }
+    virtual ~ResidueFactoryMethod ();
 
     // OPERATORS ------------------------------------------------------------
 
+    /**
+     * Assigns the object with the right content.  The residues created so
+     * far keep the old arena alive; a fresh one is taken if right is
+     * pooled.
+     * @param right the object to copy.
+     * @return itself.
+     */
+    ResidueFactoryMethod& operator= (const ResidueFactoryMethod &right);
+
     // ACCESS ---------------------------------------------------------------
 
+    /**
+     * Gets the arena receiving the residues.
+     * @return the arena, null when residues are allocated on the heap.
+     */
+    Arena* getArena () const { return arena; }
+
+    /**
+     * Sets whether the residues are allocated in an arena.  A fresh arena
+     * is taken when pooling is turned on.
+     * @param pooled whether the residues are allocated in an arena.
+     */
+    void setPooled (bool pooled);
+
     // METHODS --------------------------------------------------------------
 
     /**
@@ -129,14 +164,21 @@ namespace mccore
 
     /**
      * Initializes the object.
+     * @param pooled whether the residues are allocated in an arena.
+     */
+    explicit ResidueFM (bool pooled = false) : ResidueFactoryMethod (pooled) { }
+
+    /**
+     * Initializes the object with the right content.
+     * @param right the object to copy.
      */
-    ResidueFM () : ResidueFactoryMethod() { }
+    ResidueFM (const ResidueFM &right) : ResidueFactoryMethod (right) { }
 
     /**
      * Clones the object.
      * @return the copy of the object.
      */
-    virtual ResidueFactoryMethod* clone () const { return new ResidueFM (); }
+    virtual ResidueFactoryMethod* clone () const { return new ResidueFM (*this); }
   
     /**
      * Destroys the object.
@@ -192,14 +234,21 @@ namespace mccore
 
     /**
      * Initializes the object.
+     * @param pooled whether the residues are allocated in an arena.
+     */
+    explicit ExtendedResidueFM (bool pooled = false) : ResidueFactoryMethod (pooled) { }
+
+    /**
+     * Initializes the object with the right content.
+     * @param right the object to copy.
      */
-    ExtendedResidueFM () : ResidueFactoryMethod() { }
+    ExtendedResidueFM (const ExtendedResidueFM &right) : ResidueFactoryMethod (right) { }
 
     /**
      * Clones the object.
      * @return the copy of the object.
      */
-    virtual ResidueFactoryMethod* clone () const { return new ExtendedResidueFM (); }
+    virtual ResidueFactoryMethod* clone () const { return new ExtendedResidueFM (*this); }
   
     /**
      * Destroys the object.
@@ -0,0 +1,170 @@
+//                              -*- Mode: C++ -*-
+// ShortestPathTree.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:59:45 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_ShortestPathTree_h_
+#define _mccore_ShortestPathTree_h_
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "Path.h"
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  /**
+   * Dijkstra's algorithm for the shortest path tree used in Horton's and
+   * Vismara's cycle bases, shared by UndirectedGraph and CsrGraph.  The
+   * paths only go through the vertices w where comparator (source, w)
+   * holds.  The candidate vertices are kept in a binary heap ordered over
+   * their value then their label, which breaks ties on the lowest label
+   * like the linear scan of the original algorithm.  Stale heap entries
+   * are skipped when popped.
+   *
+   * The graph is read through an adjacency object providing:
+   * <pre>
+   *   neighbor_iterator                an iterator type on labels
+   *   size ()                          the number of vertices
+   *   neighbor_begin (w)               the first neighbor label of w
+   *   neighbor_end (w)                 past the last neighbor label of w
+   *   weight (w, it)                   the weight of the edge from w to *it
+   * </pre>
+   * @param adjacency the adjacency of the graph.
+   * @param source the source label.
+   * @param predecessors the predecessor labels to fill, the source and the
+   * unreachable vertices are their own predecessors.
+   * @param values the path values to fill, set to the max value of
+   * size_type for the source and the unreachable vertices.
+   * @param comparator the vertex filter.
+   */
+  template< class Adjacency, class label, class size_type, class Compare >
+  void sptDijkstraTiernan (const Adjacency &adjacency, label source, vector< label > &predecessors, vector< size_type > &values, Compare comparator)
+  {
+    typedef pair< size_type, label > Candidate;
+
+    const size_type MAXUIVALUE = numeric_limits< size_type >::max ();
+    priority_queue< Candidate, vector< Candidate >, greater< Candidate > > heap;
+    vector< bool > done;
+    typename Adjacency::neighbor_iterator it;
+    typename Adjacency::neighbor_iterator end;
+    label w;
+
+    predecessors.resize (adjacency.size ());
+    values.assign (adjacency.size (), MAXUIVALUE);
+    done.assign (adjacency.size (), false);
+    for (w = 0; w < predecessors.size (); ++w)
+      {
+	predecessors[w] = w;
+      }
+    done[source] = true;
+
+    // Initialize ---
+    for (it = adjacency.neighbor_begin (source), end = adjacency.neighbor_end (source); end != it; ++it)
+      {
+	if (source != *it)
+	  {
+	    values[*it] = adjacency.weight (source, it);
+	    predecessors[*it] = source;
+	    heap.push (make_pair (values[*it], *it));
+	  }
+      }
+
+    while (! heap.empty ())
+      {
+	size_type min_value;
+
+	min_value = heap.top ().first;
+	w = heap.top ().second;
+	heap.pop ();
+	if (done[w] || values[w] != min_value)
+	  {
+	    continue;
+	  }
+	done[w] = true;
+
+	// The remaining candidates are not connected to the source.
+	if (min_value == MAXUIVALUE)
+	  {
+	    break;
+	  }
+
+	if (comparator (source, w))
+	  {
+	    for (it = adjacency.neighbor_begin (w), end = adjacency.neighbor_end (w); end != it; ++it)
+	      {
+		size_type new_val;
+		label v;
+
+		v = *it;
+		if (! done[v]
+		    && (values[v] > (new_val = min_value + adjacency.weight (w, it))))
+		  {
+		    values[v] = new_val;
+		    predecessors[v] = w;
+		    heap.push (make_pair (new_val, v));
+		  }
+	      }
+	  }
+      }
+  }
+
+
+  /**
+   * Builds the path from the source to a vertex from the output of
+   * sptDijkstraTiernan.  The path of the source or of an unreachable vertex
+   * only holds the source and has the max value of size_type.
+   * @param source the source label.
+   * @param predecessors the predecessor labels.
+   * @param values the path values.
+   * @param target the last vertex of the path.
+   * @param path the path to fill.
+   */
+  template< class label, class size_type >
+  void sptPath (label source, const vector< label > &predecessors, const vector< size_type > &values, label target, Path< label, size_type > &path)
+  {
+    label w;
+
+    path.clear ();
+    if (target != source && predecessors[target] != target)
+      {
+	for (w = target; w != source; w = predecessors[w])
+	  {
+	    path.push_back (w);
+	  }
+      }
+    path.push_back (source);
+    std::reverse (path.begin (), path.end ());
+    path.setValue (values[target]);
+  }
+
+}
+
+#endif
@@ -0,0 +1,264 @@
+//                              -*- Mode: C++ -*-
+// ThreadPool.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:33:31 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+#include <unistd.h>
+
+#include "Exception.h"
+#include "ThreadPool.h"
+
+
+
+namespace mccore
+{
+
+  /**
+   * The worker threads of a pool and the batch they share.  The batch
+   * fields are protected by the mutex.
+   */
+  struct ThreadPoolState
+  {
+    const vector< ThreadPool::Task* > *tasks;
+    vector< ThreadPool::Task* >::size_type next;
+    vector< ThreadPool::Task* >::size_type remaining;
+    unsigned long generation;
+    bool failed;
+    bool stop;
+#ifdef HAVE_PTHREAD
+    vector< pthread_t > workers;
+    pthread_mutex_t mutex;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    pthread_mutex_t busy;
+#endif
+  };
+
+
+  /**
+   * Runs a task.
+   * @param task the task.
+   * @return whether the task succeeded.
+   */
+  static bool
+  runTask (ThreadPool::Task *task)
+  {
+    try
+      {
+	task->run ();
+      }
+    catch (...)
+      {
+	return false;
+      }
+    return true;
+  }
+
+
+#ifdef HAVE_PTHREAD
+
+  /**
+   * Runs the tasks of the current batch until none is left.  The mutex
+   * must be locked, it is locked on return.
+   * @param state the pool state.
+   */
+  static void
+  drainBatch (ThreadPoolState *state)
+  {
+    while (0 != state->tasks && state->tasks->size () > state->next)
+      {
+	ThreadPool::Task *task = (*state->tasks)[state->next++];
+	bool succeeded;
+
+	pthread_mutex_unlock (&state->mutex);
+	succeeded = runTask (task);
+	pthread_mutex_lock (&state->mutex);
+	if (! succeeded)
+	  {
+	    state->failed = true;
+	  }
+	if (0 == --state->remaining)
+	  {
+	    pthread_cond_signal (&state->done);
+	  }
+      }
+  }
+
+
+  /**
+   * The worker thread loop, it runs the batches until the pool stops.
+   * @param arg the pool state.
+   * @return null.
+   */
+  static void*
+  runWorker (void *arg)
+  {
+    ThreadPoolState *state = (ThreadPoolState*) arg;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock (&state->mutex);
+    while (true)
+      {
+	while (! state->stop && seen == state->generation)
+	  {
+	    pthread_cond_wait (&state->work, &state->mutex);
+	  }
+	if (state->stop)
+	  {
+	    pthread_mutex_unlock (&state->mutex);
+	    return 0;
+	  }
+	seen = state->generation;
+	drainBatch (state);
+      }
+  }
+
+#endif
+
+
+  ThreadPool::ThreadPool (unsigned int threads)
+    : threads (0 == threads ? getProcessorCount () : threads),
+      state (0)
+  {
+#ifdef HAVE_PTHREAD
+    unsigned int count;
+
+    if (1 < this->threads)
+      {
+	state = new ThreadPoolState ();
+	state->tasks = 0;
+	state->next = 0;
+	state->remaining = 0;
+	state->generation = 0;
+	state->failed = false;
+	state->stop = false;
+	pthread_mutex_init (&state->mutex, 0);
+	pthread_cond_init (&state->work, 0);
+	pthread_cond_init (&state->done, 0);
+	pthread_mutex_init (&state->busy, 0);
+	for (count = this->threads; 1 < count; --count)
+	  {
+	    pthread_t worker;
+
+	    if (0 != pthread_create (&worker, 0, runWorker, state))
+	      {
+		break;
+	      }
+	    state->workers.push_back (worker);
+	  }
+	this->threads = state->workers.size () + 1;
+      }
+#else
+    this->threads = 1;
+#endif
+  }
+
+
+  ThreadPool::~ThreadPool ()
+  {
+#ifdef HAVE_PTHREAD
+    if (0 != state)
+      {
+	vector< pthread_t >::iterator it;
+
+	pthread_mutex_lock (&state->mutex);
+	state->stop = true;
+	pthread_cond_broadcast (&state->work);
+	pthread_mutex_unlock (&state->mutex);
+	for (it = state->workers.begin (); state->workers.end () != it; ++it)
+	  {
+	    pthread_join (*it, 0);
+	  }
+	pthread_mutex_destroy (&state->busy);
+	pthread_cond_destroy (&state->done);
+	pthread_cond_destroy (&state->work);
+	pthread_mutex_destroy (&state->mutex);
+	delete state;
+      }
+#endif
+  }
+
+
+  unsigned int
+  ThreadPool::getProcessorCount ()
+  {
+#ifdef HAVE_PTHREAD
+    long count = sysconf (_SC_NPROCESSORS_ONLN);
+
+    return 0 < count ? (unsigned int) count : 1;
+#else
+    return 1;
+#endif
+  }
+
+
+  void
+  ThreadPool::run (const vector< Task* > &tasks) const
+  {
+    vector< Task* >::const_iterator it;
+    bool failed = false;
+
+#ifdef HAVE_PTHREAD
+    if (0 != state
+	&& 1 < tasks.size ()
+	&& 0 == pthread_mutex_trylock (&state->busy))
+      {
+	pthread_mutex_lock (&state->mutex);
+	state->tasks = &tasks;
+	state->next = 0;
+	state->remaining = tasks.size ();
+	state->failed = false;
+	++state->generation;
+	pthread_cond_broadcast (&state->work);
+	drainBatch (state);
+	while (0 != state->remaining)
+	  {
+	    pthread_cond_wait (&state->done, &state->mutex);
+	  }
+	state->tasks = 0;
+	failed = state->failed;
+	pthread_mutex_unlock (&state->mutex);
+	pthread_mutex_unlock (&state->busy);
+      }
+    else
+#endif
+      {
+	for (it = tasks.begin (); tasks.end () != it; ++it)
+	  {
+	    if (! runTask (*it))
+	      {
+		failed = true;
+	      }
+	  }
+      }
+    if (failed)
+      {
+	throw FatalIntLibException ("a task failed in the thread pool", __FILE__, __LINE__);
+      }
+  }
+
+}
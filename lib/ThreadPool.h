@@ -0,0 +1,137 @@
+//                              -*- Mode: C++ -*-
+// ThreadPool.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 01:33:31 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_ThreadPool_h_
+#define _mccore_ThreadPool_h_
+
+#include <vector>
+
+using namespace std;
+
+
+
+namespace mccore
+{
+  struct ThreadPoolState;
+
+  /**
+   * @short Runs batches of independent tasks on a set of worker threads.
+   *
+   * The worker threads are started with the pool and reused by every
+   * batch.  The tasks of a batch are handed out in order to the workers
+   * and to the calling thread, which returns once every task is done.
+   * Tasks must write their results in storage of their own so that the
+   * caller merges them in a deterministic order.  A pool runs one batch at
+   * a time: a batch submitted while another one is running is run by its
+   * calling thread alone.  When the library is built without thread
+   * support the tasks are run in order by the calling thread.
+   */
+  class ThreadPool
+  {
+  public:
+
+    /**
+     * @short A unit of work.
+     */
+    class Task
+    {
+    public:
+
+      /**
+       * Destroys the object.
+       */
+      virtual ~Task () { }
+
+      /**
+       * Does the work.  It must not throw: exceptions are caught and the
+       * pool throws a FatalIntLibException once every task is done.
+       */
+      virtual void run () = 0;
+
+    };
+
+  private:
+
+    /**
+     * The number of threads running the tasks, the caller included.
+     */
+    unsigned int threads;
+
+    /**
+     * The worker threads and the batch they share, null without workers.
+     */
+    ThreadPoolState *state;
+
+  public:
+
+    // LIFECYCLE ------------------------------------------------------------
+
+    /**
+     * Initializes the object and starts its worker threads.
+     * @param threads the number of threads running the tasks, the caller
+     *        included, 0 for the number of processors (default 1, no
+     *        worker).
+     */
+    explicit ThreadPool (unsigned int threads = 1);
+
+    /**
+     * Stops the worker threads and destroys the object.
+     */
+    ~ThreadPool ();
+
+  private:
+
+    ThreadPool (const ThreadPool &right);
+    ThreadPool& operator= (const ThreadPool &right);
+
+  public:
+
+    // ACCESS ---------------------------------------------------------------
+
+    /**
+     * Gets the number of threads running the tasks.
+     * @return the number of threads.
+     */
+    unsigned int getThreadCount () const { return threads; }
+
+    /**
+     * Gets the number of online processors.
+     * @return the number of processors, 1 without thread support.
+     */
+    static unsigned int getProcessorCount ();
+
+    // METHODS --------------------------------------------------------------
+
+    /**
+     * Runs the tasks and waits for their completion.
+     * @param tasks the tasks, still owned by the caller.
+     * @exception FatalIntLibException if a task threw.
+     */
+    void run (const vector< Task* > &tasks) const;
+
+  };
+
+}
+
+#endif
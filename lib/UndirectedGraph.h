@@ -31,15 +31,20 @@
 #include <iterator>
 #include <limits>
 #include <list>
+#include <queue>
 #include <set>
 #include <utility>
 #include <vector>
 
+#include "CsrGraph.h"
 #include "Cycle.h"
+#include "GF2Matrix.h"
 #include "Graph.h"
 #include "Messagestream.h"
 #include "OrientedGraph.h"
 #include "Path.h"
+#include "ShortestPathTree.h"
+#include "ThreadPool.h"
 #include "stlio.h"
 
 using namespace std;
@@ -70,10 +75,18 @@ namespace mccore
 
     typedef typename super::size_type size_type;
     typedef typename super::edge_size_type edge_size_type;
+    typedef typename super::edge_label edge_label;
     typedef typename super::label label;
     typedef typename super::iterator iterator;
     typedef typename super::const_iterator const_iterator;
 
+    /**
+     * The number of vertices from which the cycle searches use the thread
+     * pool they are given, smaller graphs are searched on the calling
+     * thread.
+     */
+    enum { parallelThreshold = 256 };
+
   protected:
 
     typedef typename super::V2VLabel V2VLabel;
@@ -159,20 +172,16 @@ namespace mccore
     virtual list< V > neighborhood (const V &v)
     {
       list< V > res;
-      typename V2VLabel::const_iterator it;
+      label l;
 
-      if (this->v2vlabel.end () != (it = this->v2vlabel.find (&v)))
+      if (this->lookupVertex (v, l))
 	{
-	  typename EV2ELabel::const_iterator evit;
-	  label l;
+	  const vector< label > &adj = this->outAdjacency[l];
+	  typename vector< label >::const_iterator lit;
 
-	  l = it->second;
-	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit && evit->first.getHeadLabel () <= l; ++evit)
+	  for (lit = adj.begin (); adj.end () != lit; ++lit)
 	    {
-	      if (evit->first.getHeadLabel () == l)
-		{
-		  res.push_back (this->vertices[evit->first.getTailLabel ()]);
-		}
+	      res.push_back (this->vertices[*lit]);
 	    }
 	}
       return res;
@@ -187,21 +196,137 @@ namespace mccore
      */
     virtual list< label > internalNeighborhood (label l) const
     {
-      list< label > res;
+      const vector< label > &adj = this->internalOutAdjacency (l);
+
+      return list< label > (adj.begin (), adj.end ());
+    }
 
-      if (this->vertices.size () > l)
+    /**
+     * Labels the connected components of the graph.  Components are
+     * numbered from 0 in the order of their lowest vertex label.
+     * @param components the component number of each vertex label to fill.
+     * @return the number of connected components.
+     */
+    size_type internalConnectedComponents (vector< label > &components) const
+    {
+      const label unset = numeric_limits< label >::max ();
+      vector< label > stack;
+      size_type count;
+      label l;
+
+      components.assign (this->size (), unset);
+      for (count = 0, l = 0; this->size () > l; ++l)
 	{
-	  typename EV2ELabel::const_iterator evit;
+	  if (unset == components[l])
+	    {
+	      components[l] = count;
+	      stack.push_back (l);
+	      while (! stack.empty ())
+		{
+		  const vector< label > &adj = this->outAdjacency[stack.back ()];
+		  typename vector< label >::const_iterator it;
+
+		  stack.pop_back ();
+		  for (it = adj.begin (); adj.end () != it; ++it)
+		    {
+		      if (unset == components[*it])
+			{
+			  components[*it] = count;
+			  stack.push_back (*it);
+			}
+		    }
+		}
+	      ++count;
+	    }
+	}
+      return count;
+    }
 
-	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit && evit->first.getHeadLabel () <= l; ++evit)
+    /**
+     * Labels the biconnected components of the graph over its edges.
+     * Components are numbered in the order they are closed by a depth first
+     * search started from the lowest vertex labels.  A loop is a component
+     * of its own.
+     * @param blocks the component number of each edge label to fill.
+     * @return the number of biconnected components.
+     */
+    size_type internalBiconnectedComponents (vector< size_type > &blocks) const
+    {
+      const size_type unset = numeric_limits< size_type >::max ();
+      vector< size_type > discovery (this->size (), 0);
+      vector< size_type > low (this->size (), 0);
+      vector< pair< label, size_type > > stack;
+      vector< label > parents;
+      vector< edge_label > edgeStack;
+      size_type time;
+      size_type count;
+      label root;
+
+      blocks.assign (this->edgeSize (), unset);
+      for (count = 0, time = 0, root = 0; this->size () > root; ++root)
+	{
+	  if (0 != discovery[root])
+	    {
+	      continue;
+	    }
+	  discovery[root] = low[root] = ++time;
+	  stack.push_back (make_pair (root, 0));
+	  parents.push_back (root);
+	  while (! stack.empty ())
 	    {
-	      if (evit->first.getHeadLabel () == l)
+	      label v = stack.back ().first;
+	      const vector< label > &adjacency = this->outAdjacency[v];
+
+	      if (adjacency.size () > stack.back ().second)
 		{
-		  res.push_back (evit->first.getTailLabel ());
+		  label w = adjacency[stack.back ().second++];
+		  edge_label e = this->internalGetEdgeLabel (v, w);
+
+		  if (v == w)
+		    {
+		      blocks[e] = count++;
+		    }
+		  else if (0 == discovery[w])
+		    {
+		      edgeStack.push_back (e);
+		      discovery[w] = low[w] = ++time;
+		      stack.push_back (make_pair (w, 0));
+		      parents.push_back (v);
+		    }
+		  else if (w != parents.back () && discovery[w] < discovery[v])
+		    {
+		      edgeStack.push_back (e);
+		      low[v] = std::min (low[v], discovery[w]);
+		    }
+		}
+	      else
+		{
+		  label p = parents.back ();
+
+		  stack.pop_back ();
+		  parents.pop_back ();
+		  if (! stack.empty ())
+		    {
+		      low[p] = std::min (low[p], low[v]);
+		      if (low[v] >= discovery[p])
+			{
+			  edge_label e = this->internalGetEdgeLabel (p, v);
+			  edge_label f;
+
+			  do
+			    {
+			      f = edgeStack.back ();
+			      edgeStack.pop_back ();
+			      blocks[f] = count;
+			    }
+			  while (e != f);
+			  ++count;
+			}
+		    }
 		}
 	    }
 	}
-      return res;
+      return count;
     }
 
     // METHODS --------------------------------------------------------------
@@ -216,40 +341,11 @@ namespace mccore
      */
     virtual iterator uncheckedInternalErase (label l)
     {
-      list< label > neighbors = internalNeighborhood (l);
-      typename list< label >::iterator lit;
-      typename EV2ELabel::iterator evit;
-      EV2ELabel newEV2;
-      typename vector< V >::iterator res;
-
-      for (lit = neighbors.begin (); neighbors.end () != lit; ++lit)
-	{
-	  uncheckedInternalDisconnect (l, *lit);
-	}
-      res = this->vertices.erase (this->vertices.begin () + l);
-      this->vertexWeights.erase (this->vertexWeights.begin () + l);
-      this->rebuildV2VLabel ();
-      for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
-	{
-	  label h;
-	  label t;
-
-	  h = evit->first.getHeadLabel ();
-	  t = evit->first.getTailLabel ();
-	  if (h > l)
-	    {
-	      --h;
-	    }
-	  if (t > l)
-	    {
-	      --t;
-	    }
+      vector< bool > marks (this->vertices.size (), false);
 
-	  EndVertices ev (h, t);
-	  newEV2.insert (make_pair (ev, evit->second));
-	}
-      this->ev2elabel = newEV2;
-      return res;
+      marks[l] = true;
+      this->uncheckedInternalEraseMarked (marks);
+      return this->vertices.begin () + l;
     }
 
     /**
@@ -269,11 +365,13 @@ namespace mccore
       if (this->ev2elabel.end () == (evit = this->ev2elabel.find (ev)))
 	{
 	  this->ev2elabel.insert (make_pair (ev, this->edges.size ()));
+	  this->adjacencyInsert (h, t, this->edges.size ());
 	  if (h != t)
 	    {
 	      EndVertices ev2 (t, h);
 
 	      this->ev2elabel.insert (make_pair (ev2, this->edges.size ()));
+	      this->adjacencyInsert (t, h, this->edges.size ());
 	    }
 	  this->edges.push_back (e);
 	  this->edgeWeights.resize (this->edgeWeights.size () + 1);
@@ -300,11 +398,13 @@ namespace mccore
       if (this->ev2elabel.end () == (evit = this->ev2elabel.find (ev)))
 	{
 	  this->ev2elabel.insert (make_pair (ev, this->edges.size ()));
+	  this->adjacencyInsert (h, t, this->edges.size ());
 	  if (h != t)
 	    {
 	      EndVertices ev2 (t, h);
 
 	      this->ev2elabel.insert (make_pair (ev2, this->edges.size ()));
+	      this->adjacencyInsert (t, h, this->edges.size ());
 	    }
 	  this->edges.push_back (e);
 	  this->edgeWeights.push_back (w);
@@ -334,9 +434,11 @@ namespace mccore
 	  this->edges.erase (this->edges.begin () + l);
 	  this->edgeWeights.erase (this->edgeWeights.begin () + l);
 	  this->ev2elabel.erase (evit);
+	  this->adjacencyErase (h, t);
 	  if (this->ev2elabel.end () != (evit = this->ev2elabel.find (ev2)))
 	    {
 	      this->ev2elabel.erase (evit);
+	      this->adjacencyErase (t, h);
 	    }
 	  for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
 	    {
@@ -345,6 +447,7 @@ namespace mccore
 		  --evit->second;
 		}
 	    }
+	  this->rebuildEdgeHash ();
 	  return true;
 	}
       return false;
@@ -450,335 +553,525 @@ namespace mccore
     template< class Compare >
     void sptDijkstraTiernan (label source, vector< Path< label, size_type > > &paths, Compare comparator = less< label > ()) const
     {
-      const size_type MAXUIVALUE = numeric_limits< size_type >::max ();
+      vector< label > predecessors;
+      vector< size_type > values;
       label w;
-      size_type graphsize;
-      vector< label > C;
 
-      graphsize = this->size ();
+      sptDijkstraTiernan (source, predecessors, values, comparator);
       paths.clear ();
-      paths.resize (graphsize);
+      paths.resize (this->size ());
+      for (w = 0; w < paths.size (); ++w)
+	{
+	  sptPath (source, predecessors, values, w, paths[w]);
+	}
+    }
+
+    /**
+     * Dijkstra's algorithm for the shortest path tree as described above,
+     * without building the paths, see mccore::sptDijkstraTiernan.  The
+     * paths are stored as predecessor labels, use sptPath to build them.
+     * @param source the source node id of the paths.
+     * @param predecessors the predecessor labels to fill, the source and
+     * the unreachable vertices are their own predecessors.
+     * @param values the path values to fill, set to the max value of
+     * size_type for the source and the unreachable vertices.
+     */
+    template< class Compare >
+    void sptDijkstraTiernan (label source, vector< label > &predecessors, vector< size_type > &values, Compare comparator = less< label > ()) const
+    {
+      mccore::sptDijkstraTiernan (SptAdjacency (*this), source, predecessors, values, comparator);
+    }
 
-      // Initialize ---
-      for  (w = 0; w < graphsize; ++w)
+    /**
+     * Builds the path from the source to a vertex from the output of
+     * sptDijkstraTiernan, see mccore::sptPath.
+     * @param source the source node id of the paths.
+     * @param predecessors the predecessor labels.
+     * @param values the path values.
+     * @param target the last vertex of the path.
+     * @param path the path to fill.
+     */
+    void sptPath (label source, const vector< label > &predecessors, const vector< size_type > &values, label target, Path< label, size_type > &path) const
+    {
+      mccore::sptPath (source, predecessors, values, target, path);
+    }
+
+    /**
+     * Fills the edge incidence vector of a cycle, the last vertex of the
+     * path being connected to the first one.
+     * @param cycle the cycle.
+     * @param edgeIndex the position of each edge label in the vector.
+     * @param edgeCount the number of positions.
+     * @param row the incidence vector to fill.
+     */
+    template< class P >
+    void cycleIncidence (const P &cycle, const vector< edge_label > &edgeIndex, edge_size_type edgeCount, GF2Vector &row) const
+    {
+      typename P::const_iterator r;
+      typename P::const_iterator s;
+
+      row = GF2Vector (edgeCount);
+      s = cycle.begin ();
+      row.set (edgeIndex[this->internalGetEdgeLabel (cycle.back (), *s)]);
+      for (r = s++; cycle.end () != s; ++r, ++s)
 	{
-	  size_type value;
+	  row.set (edgeIndex[this->internalGetEdgeLabel (*r, *s)]);
+	}
+    }
 
-	  paths[w].push_back (source);
-	  if  (w == source)
-	    {
-	      value = MAXUIVALUE;
-	    }
-	  else
+    /**
+     * Gets the identity edge index, used when the incidence vectors span
+     * the whole graph.
+     * @param edgeIndex the index to fill.
+     */
+    void identityEdgeIndex (vector< edge_label > &edgeIndex) const
+    {
+      edge_label e;
+
+      edgeIndex.resize (this->edgeSize ());
+      for (e = 0; edgeIndex.size () > e; ++e)
+	{
+	  edgeIndex[e] = e;
+	}
+    }
+
+    /**
+     * Gathers the edges of the graph in its biconnected components.  Since
+     * a cycle never spans two components, the cycle bases of the graph are
+     * the union of the bases of its components.
+     * @param blocks the component of each edge label to fill.
+     * @param edgeIndex the position of each edge label in its component to
+     * fill.
+     * @param edgeCounts the number of edges of each component to fill.
+     * @param dimensions the cycle space dimension of each component to
+     * fill.
+     * @return the number of components.
+     */
+    size_type blockPartition (vector< size_type > &blocks, vector< edge_label > &edgeIndex, vector< edge_size_type > &edgeCounts, vector< size_type > &dimensions) const
+    {
+      typename EV2ELabel::const_iterator evit;
+      vector< vector< label > > blockVertices;
+      size_type count;
+      size_type b;
+      edge_label e;
+
+      count = internalBiconnectedComponents (blocks);
+      edgeIndex.resize (this->edgeSize ());
+      edgeCounts.assign (count, 0);
+      for (e = 0; blocks.size () > e; ++e)
+	{
+	  edgeIndex[e] = edgeCounts[blocks[e]]++;
+	}
+      blockVertices.resize (count);
+      for (evit = this->ev2elabel.begin (); this->ev2elabel.end () != evit; ++evit)
+	{
+	  if (evit->first.getHeadLabel () <= evit->first.getTailLabel ())
 	    {
-	      if (this->internalAreConnected (source, w))
-		{
-		  value = this->internalGetEdgeWeight (source, w);
-		  paths[w].push_back (w);
-		}
-	      else
-		{
-		  value = MAXUIVALUE;
-		}
-	      C.push_back (w);
+	      vector< label > &vertices = blockVertices[blocks[evit->second]];
+
+	      vertices.push_back (evit->first.getHeadLabel ());
+	      vertices.push_back (evit->first.getTailLabel ());
 	    }
-	  paths[w].setValue (value);
 	}
+      dimensions.resize (count);
+      for (b = 0; count > b; ++b)
+	{
+	  vector< label > &vertices = blockVertices[b];
+
+	  std::sort (vertices.begin (), vertices.end ());
+	  dimensions[b] = (edgeCounts[b] + 1
+			   - (std::unique (vertices.begin (), vertices.end ()) - vertices.begin ()));
+	}
+      return count;
+    }
+
+    /**
+     * Tells if the cycle searches use the thread pool.  Graphs smaller
+     * than parallelThreshold vertices are searched on the calling thread.
+     * @param pool the thread pool, null for none.
+     * @return whether the tasks are run on the pool.
+     */
+    bool isParallel (const ThreadPool *pool) const
+    {
+      return (0 != pool
+	      && 1 < pool->getThreadCount ()
+	      && (size_type) parallelThreshold <= this->size ());
+    }
 
-      while (! C.empty ())
+    /**
+     * Splits the vertex labels in ranges of sources for the tasks, a few
+     * per thread when the graph is searched in parallel and a single one
+     * otherwise.
+     * @param pool the thread pool, null for none.
+     * @param bounds the range bounds to fill, range r being
+     *        [bounds[r], bounds[r + 1]).
+     */
+    void sourceRanges (const ThreadPool *pool, vector< label > &bounds) const
+    {
+      size_type count;
+      size_type r;
+
+      count = (isParallel (pool)
+	       ? std::min (this->size (), (size_type) pool->getThreadCount () * 4)
+	       : 1);
+      bounds.clear ();
+      for (r = 0; count >= r; ++r)
 	{
-	  typename vector< label >::iterator min_iter;
-	  typename vector< label >::iterator k;
-	  size_type min_value;
+	  bounds.push_back (this->size () * r / count);
+	}
+    }
 
-	  min_iter = C.begin ();
-	  min_value = paths[*min_iter].getValue ();
+    /**
+     * Runs the tasks on the thread pool, or in order on the calling thread
+     * when the graph is not searched in parallel, and deletes them.
+     * @param tasks the tasks.
+     * @param pool the thread pool, null for none.
+     * @exception FatalIntLibException if a task failed.
+     */
+    void runTasks (vector< ThreadPool::Task* > &tasks, const ThreadPool *pool) const
+    {
+      typename vector< ThreadPool::Task* >::iterator it;
 
-	  for  (k = C.begin (); k != C.end (); ++k)
+      try
+	{
+	  if (isParallel (pool))
 	    {
-	      if  (paths[*k].getValue () < min_value)
-		{
-		  min_value = paths[*k].getValue ();
-		  min_iter = k;
-		}
+	      pool->run (tasks);
 	    }
-	  w = *min_iter;
-	  C.erase (min_iter);
-
-	  // Break if the elements remaining in C are not connected to the
-	  // source.
-	  if  (min_value == MAXUIVALUE)
+	  else
 	    {
-	      break;
+	      ThreadPool ().run (tasks);
 	    }
-
-	  for (k = C.begin (); C.end () != k; ++k)
+	}
+      catch (FatalIntLibException &e)
+	{
+	  for (it = tasks.begin (); tasks.end () != it; ++it)
 	    {
-	      size_type new_val;
-	      label v;
-
-	      v = *k;
-	      if (comparator (source, w)
-		  && this->internalAreConnected (w, v)
-		  && (paths[v].getValue () > (new_val = min_value + this->internalGetEdgeWeight (w, v))))
-	        {
-		  paths[v] = paths[w];
-		  paths[v].push_back (v);
-		  paths[v].setValue (new_val);
-		}
+	      delete *it;
 	    }
+	  throw;
+	}
+      for (it = tasks.begin (); tasks.end () != it; ++it)
+	{
+	  delete *it;
 	}
     }
 
+  public:
+
     /**
      * Uses the Gaussian Elimination algorithm to find non linearly
-     * dependant cycles from the set of enumerated cycles.
-     * @param graph an UndirectedAbstractGraph.
-     * @param bag a vector of cycles.
+     * dependant cycles from the set of enumerated cycles.  The cycles of a
+     * same size are tested against the matrix of the shorter ones before
+     * being inserted.  The elimination stops once the rank reaches the
+     * dimension of the cycle space, E - V + the number of connected
+     * components, since every remaining cycle is then dependent.
+     * @param bag a vector of cycles sorted over their size.
      * @return a linearly independant vector of cycles.
      */
     vector< Path< label, size_type > > gaussianElimination (vector< Path< label, size_type > >& bag) const
     {
-      typedef typename vector< Path< label, size_type > >::iterator vpiterator;
+      vector< edge_label > edgeIndex;
+      vector< label > components;
+      vector< Path< label, size_type > > newbag;
+      vector< GF2Vector::size_type > pivots;
+
+      identityEdgeIndex (edgeIndex);
+      gaussianElimination (bag, edgeIndex, this->edgeSize (),
+			   (this->edgeSize () + internalConnectedComponents (components)
+			    - this->size ()),
+			   newbag, pivots);
+      return newbag;
+    }
 
-      if (bag.empty ())
-	{
-	  return bag;
-	}
+    /**
+     * Gaussian Elimination of the cycles of a part of the graph.  It does
+     * not log since it may run in a thread pool.
+     * @param bag a vector of cycles sorted over their size.
+     * @param edgeIndex the position of each edge label in the incidence
+     * vectors.
+     * @param edgeCount the size of the incidence vectors.
+     * @param dimension the dimension of the cycle space of the part.
+     * @param newbag the linearly independant cycles to fill, ordered over
+     * the leading bit of their reduced incidence vector.
+     * @param pivots the leading bit of each cycle of newbag to fill.
+     */
+    void gaussianElimination (const vector< Path< label, size_type > > &bag, const vector< edge_label > &edgeIndex, edge_size_type edgeCount, GF2Matrix::size_type dimension, vector< Path< label, size_type > > &newbag, vector< GF2Vector::size_type > &pivots) const
+    {
+      typedef typename vector< Path< label, size_type > >::const_iterator vpiterator;
 
-      vector< bool* > matrix;
-      vector< bool* >::iterator n;
-      label i;
-      label j;
-      vector< mccore::Path< label, size_type > > newbag;
-      vpiterator p, q;
-      edge_size_type eSize;
+      GF2Matrix matrix;
+      vpiterator p;
       vector< vpiterator > marked;
-      bool *row;
+      typename vector< vpiterator >::iterator m;
+      GF2Vector row;
+      GF2Matrix::size_type pos;
 
-      eSize = this->edgeSize ();
-      row = new bool[eSize];
-      for (p = bag.begin (); p != bag.end (); ++p)
+      newbag.clear ();
+      for (p = bag.begin (); p != bag.end () && matrix.size () < dimension; ++p)
 	{
-	  typename mccore::Path< label, size_type >::iterator r;
-	  typename mccore::Path< label, size_type >::iterator s;
-	  bool inserted;
-
-	  for (i = 0; i < eSize; ++i)
-	    {
-	      row[i] = false;
-	    }
-
 	  // Let's see if *p is linearly independent to the content of newbag
-	  //       cout << "Treating " << *p << endl;
-
-	  s = p->begin ();
-	  row[this->internalGetEdgeLabel (p->back (), *s)] = true;
-	  for (r = s++; p->end () != s; ++r, ++s)
+	  cycleIncidence (*p, edgeIndex, edgeCount, row);
+	  if (! matrix.reduce (row).first)
 	    {
-	      row[this->internalGetEdgeLabel (*r, *s)] = true;
+	      marked.push_back (p);
 	    }
 
-	  inserted = false;
-	  for (n = matrix.begin (), q = newbag.begin (); q != newbag.end (); ++n, ++q)
+	  // Let's see if we should try to insert the marked...
+	  if (p + 1 == bag.end () || (p + 1)->size () > p->size ())
 	    {
-	      j = 0;
-	      while (j < eSize && row[j] == false && (*n)[j] == false)
+	      for (m = marked.begin (); marked.end () != m; ++m)
 		{
-		  ++j;
-		}
-	      if (j == eSize)
-		{
-		  continue;
-		}
-
-	      if (row[j] == true && (*n)[j] == false)
-		{
-		  gOut (4) << "Marking " << *p << endl;
-		  marked.push_back (p);
-		  inserted = true;
-		  break;
-		}
+		  pair< bool, GF2Matrix::size_type > res;
 
-	      if (row[j] == true && (*n)[j] == true)
-		{
-		  //Reduce the current
-		  for (i = 0; i < eSize; ++i)
+		  cycleIncidence (**m, edgeIndex, edgeCount, row);
+		  res = matrix.reduce (row);
+		  if (! res.first)
 		    {
-		      row[i] ^= (*n)[i];
+		      matrix.insert (res.second, row);
+		      newbag.insert (newbag.begin () + res.second, **m);
 		    }
-		  continue;
 		}
+	      marked.clear ();
 	    }
+	}
+      pivots.clear ();
+      for (pos = 0; matrix.size () > pos; ++pos)
+	{
+	  pivots.push_back (matrix.leading (pos));
+	}
+    }
 
-	  if (! inserted)
-	    {
-	      for (j = 0; j < eSize; ++j)
-		{
-		  if (true == row[j])
-		    {
-		      gOut (4) << "Rejecting " << *p << endl;
-		      break;
-		    }
-		}
-	      if (j != eSize)
-		{
-		  gOut (4) << "Marking " << *p << endl;
-		  marked.push_back (p);
-		}
-	    }
+  private:
 
-	  // Let's see if we should try to insert the marked...
-	  if (p + 1 == bag.end () || (p + 1)->size () > p->size ())
+    /**
+     * Neighbor and weight access of the graph for the shortest path tree.
+     */
+    class SptAdjacency
+    {
+      const UndirectedGraph &graph;
+
+    public:
+
+      typedef typename vector< label >::const_iterator neighbor_iterator;
+
+      SptAdjacency (const UndirectedGraph &g) : graph (g) { }
+
+      size_type size () const { return graph.size (); }
+
+      neighbor_iterator neighbor_begin (label w) const { return graph.internalOutAdjacency (w).begin (); }
+
+      neighbor_iterator neighbor_end (label w) const { return graph.internalOutAdjacency (w).end (); }
+
+      size_type weight (label w, neighbor_iterator it) const
+      {
+	return graph.internalGetEdgeWeight (w, *it);
+      }
+    };
+
+    /**
+     * @short Computes the Horton candidate cycles of a range of sources.
+     */
+    class HortonTask : public ThreadPool::Task
+    {
+      const UndirectedGraph *graph;
+      const CsrGraph< V, E, VW, EW > *csr;
+      label first;
+      label last;
+      vector< vector< Path< label, size_type > > > *cycles;
+
+    public:
+
+      HortonTask (const UndirectedGraph &g, const CsrGraph< V, E, VW, EW > &f, label fs, label ls, vector< vector< Path< label, size_type > > > &c)
+	: graph (&g), csr (&f), first (fs), last (ls), cycles (&c)
+      { }
+
+      virtual void run ()
+      {
+	label i;
+
+	for (i = first; last > i; ++i)
+	  {
+	    graph->hortonCandidates (*csr, i, (*cycles)[i]);
+	  }
+      }
+
+    };
+
+    /**
+     * @short Eliminates the Horton candidates of a biconnected component.
+     */
+    class GaussianEliminationTask : public ThreadPool::Task
+    {
+      const UndirectedGraph *graph;
+      const vector< Path< label, size_type > > *bag;
+      const vector< edge_label > *edgeIndex;
+      edge_size_type edgeCount;
+      size_type dimension;
+      vector< Path< label, size_type > > *newbag;
+      vector< GF2Vector::size_type > *pivots;
+
+    public:
+
+      GaussianEliminationTask (const UndirectedGraph &g, const vector< Path< label, size_type > > &b, const vector< edge_label > &ei, edge_size_type ec, size_type d, vector< Path< label, size_type > > &nb, vector< GF2Vector::size_type > &pv)
+	: graph (&g), bag (&b), edgeIndex (&ei), edgeCount (ec), dimension (d), newbag (&nb), pivots (&pv)
+      { }
+
+      virtual void run ()
+      {
+	graph->gaussianElimination (*bag, *edgeIndex, edgeCount, dimension, *newbag, *pivots);
+      }
+
+    };
+
+    /**
+     * Computes the Horton candidate cycles whose vertex of lowest label is
+     * the source.
+     * @param csr the snapshot of the graph for the shortest paths.
+     * @param i the source.
+     * @param cycles the collection to append the candidates to.
+     */
+    void hortonCandidates (const CsrGraph< V, E, VW, EW > &csr, label i, vector< Path< label, size_type > > &cycles) const
+    {
+      const size_type MAXUIVALUE = numeric_limits< size_type >::max ();
+      vector< label > predecessors;
+      vector< size_type > values;
+      typename EV2ELabel::const_iterator ecIt;
+
+      csr.sptDijkstraTiernan (i, predecessors, values, less< label > ());
+      for (ecIt = this->ev2elabel.begin (); this->ev2elabel.end () != ecIt; ++ecIt)
+	{
+	  label j;
+	  label k;
+
+	  j = ecIt->first.getHeadLabel ();
+	  k = ecIt->first.getTailLabel ();
+	  if (j < k
+	      && MAXUIVALUE != values[j]
+	      && MAXUIVALUE != values[k])
 	    {
-	      gOut (4) << endl << "Inserting marked cycles (" << marked.size ()
-		       << ")" << endl << endl;
+	      Path< label, size_type > Pvx;
+	      Path< label, size_type > Pvy;
 
-	      for (i = 0; i < marked.size (); ++i)
+	      sptPath (i, predecessors, values, j, Pvx);
+	      sptPath (i, predecessors, values, k, Pvy);
+	      if (Pvx[1] == Pvy[1])
 		{
-		  typename Path< label, size_type >::iterator r;
-		  typename Path< label, size_type >::iterator s;
-		  bool *row2;
-		  edge_size_type k;
+		  continue;
+		}
 
-		  row2 = new bool[eSize];
-		  for (k = 0; k < eSize; ++k)
-		    {
-		      row2[k] = false;
-		    }
-		  s = marked[i]->begin ();
-		  row2[this->internalGetEdgeLabel (marked[i]->back (), *s)] = true;
-		  for (r = s++; marked[i]->end () != s; ++r, ++s)
-		    {
-		      row2[this->internalGetEdgeLabel (*r, *s)] = true;
-// 		      row2[internalGetEdge (*r, *s)] = true;
-		    }
-		  inserted = false;
-		  for (n = matrix.begin (), q = newbag.begin (); q != newbag.end (); ++n, ++q)
-		    {
-		      j = 0;
-		      while (j < eSize && row2[j] == false && (*n)[j] == false)
-			{
-			  ++j;
-			}
-		      if (j == eSize)
-			{
-			  continue;
-			}
+	      Path< label, size_type > Pvxp = Pvx;
+	      Path< label, size_type > Pvyp = Pvy;
+	      Path< label, size_type > inter;
 
-		      if (row2[j] == true && (*n)[j] == false)
-			{
-			  gOut (4) << "Inserting " << *marked[i] << " " << *row2 << endl;
-			  matrix.insert (n, row2);
-			  newbag.insert (q, *marked[i]);
-			  inserted = true;
-			  break;
-			}
+	      std::sort (Pvxp.begin (), Pvxp.end ());
+	      std::sort (Pvyp.begin (), Pvyp.end ());
+	      set_intersection (Pvxp.begin (), Pvxp.end (),
+				Pvyp.begin (), Pvyp.end (),
+				inserter (inter, inter.begin ()));
 
-		      if (row2[j] == true && (*n)[j] == true)
-			{
-			  //Reduce the current
-  			  for (k = 0; k < eSize; ++k)
-			    {
-			      row2[k] ^= (*n)[k];
-			    }
-			  continue;
-			}
-		    }
+	      if (inter.size () == 1 && inter.front () == i)
+		{
+		  Path< label, size_type > C = Pvx;
 
-		  if (! inserted)
-		    {
-		      for (j = 0; j < eSize; ++j)
-			{
-			  if (row2[j] == true)
-			    {
-			      break;
-			    }
-			}
-		      if (j != eSize)
-			{
-			  gOut (4) << "Accepting " << *marked[i] << endl;
-			  matrix.push_back (row2);
-			  newbag.push_back (*marked[i]);
-			}
-		      else
-			{
-			  gOut (4) << "Rejecting " << *marked[i] << endl;
-			  delete[] row2;
-			}
-		    }
+		  C.insert (C.end (), Pvy.rbegin (), Pvy.rend ());
+		  C.pop_back ();
+		  C.setValue (Pvx.getValue () + Pvy.getValue () + this->internalGetEdgeWeight (ecIt->second));
+		  cycles.push_back (C);
 		}
-	      marked.clear ();
-	      gOut (4) << "done" << endl;
 	    }
 	}
-
-      for (n = matrix.begin (); n != matrix.end (); ++n)
-	{
-	  delete[] *n;
-	}
-      delete[] row;
-      return newbag;
     }
 
+  public:
+
     /**
      * Horton's algorithm for the minimum cycle basis.  It returns a vector
      * of Paths (cycles where the first and last vertices are connected) in
      * the graph internal numerotation. The graph edge values must be defined.
+     * The shortest path trees of the sources are computed over a CsrGraph
+     * snapshot, then the candidates of each biconnected component are
+     * eliminated.  Both steps run on the thread pool when one is given and
+     * the graph has at least parallelThreshold vertices.  The results are
+     * merged in source and component order so that they do not depend on
+     * the scheduling.
      * @param cycles the minimum cycle basis collection to fill.
+     * @param pool the thread pool, null to run on the calling thread
+     *        (default).
      */
-    void internalMinimumCycleBasis (vector< Path< label, size_type > > &cycles) const
+    void internalMinimumCycleBasis (vector< Path< label, size_type > > &cycles, const ThreadPool *pool = 0) const
     {
-      const size_type MAXUIVALUE = numeric_limits< size_type >::max ();
+      const CsrGraph< V, E, VW, EW > csr (*this);
+      vector< vector< Path< label, size_type > > > candidates (this->size ());
+      vector< ThreadPool::Task* > tasks;
+      vector< label > bounds;
       typename vector< Path< label, size_type > >::iterator p;
+      vector< size_type > blocks;
+      vector< edge_label > edgeIndex;
+      vector< edge_size_type > edgeCounts;
+      vector< size_type > dimensions;
+      size_type count;
+      size_type b;
       label i;
 
+      sourceRanges (pool, bounds);
+      for (i = 0; bounds.size () > i + 1; ++i)
+	{
+	  tasks.push_back (new HortonTask (*this, csr, bounds[i], bounds[i + 1], candidates));
+	}
+      runTasks (tasks, pool);
       for (i = 0; i < this->size (); ++i)
 	{
-	  vector< Path< label, size_type > > tmp;
-	  typename EV2ELabel::const_iterator ecIt;
+	  cycles.insert (cycles.end (), candidates[i].begin (), candidates[i].end ());
+	  vector< Path< label, size_type > > ().swap (candidates[i]);
+	}
 
-	  sptDijkstraTiernan (i, tmp, less< label > ());
-	  for (ecIt = this->ev2elabel.begin (); this->ev2elabel.end () != ecIt; ++ecIt)
-	    {
-	      label j;
-	      label k;
-
-	      j = ecIt->first.getHeadLabel ();
-	      k = ecIt->first.getTailLabel ();
-	      if (j < k
-		  && MAXUIVALUE != tmp[j].getValue ()
-		  && MAXUIVALUE != tmp[k].getValue ()
-		  && *++(tmp[j].begin ()) != *++(tmp[k].begin ()))
-		{
-		  Path< label, size_type > Pvx = tmp[j];
-		  Path< label, size_type > Pvy = tmp[k];
-		  Path< label, size_type > Pvxp = Pvx;
-		  Path< label, size_type > Pvyp = Pvy;
-		  Path< label, size_type > inter;
-
-		  std::sort (Pvxp.begin (), Pvxp.end ());
-		  std::sort (Pvyp.begin (), Pvyp.end ());
-		  set_intersection (Pvxp.begin (), Pvxp.end (),
-				    Pvyp.begin (), Pvyp.end (),
-				    inserter (inter, inter.begin ()));
-
-		  if (inter.size () == 1 && inter.front () == i)
-		    {
-		      Path< label, size_type > C = Pvx;
+      std::sort (cycles.begin (), cycles.end ());
+      gOut (3) << "Found " << cycles.size () << " potential cycles before elimination" << endl << cycles << endl;
 
-		      C.insert (C.end (), Pvy.rbegin (), Pvy.rend ());
-		      C.pop_back ();
-		      C.setValue (Pvx.getValue () + Pvy.getValue () + this->internalGetEdgeWeight (ecIt->second));
-		      cycles.push_back (C);
-		    }
-		}
+      count = blockPartition (blocks, edgeIndex, edgeCounts, dimensions);
+      vector< vector< Path< label, size_type > > > bags (count);
+      vector< vector< Path< label, size_type > > > newbags (count);
+      vector< vector< GF2Vector::size_type > > pivots (count);
+      vector< vector< edge_label > > blockEdges (count);
+      vector< pair< edge_label, pair< size_type, size_type > > > order;
+      typename vector< pair< edge_label, pair< size_type, size_type > > >::iterator oIt;
+      edge_label e;
+      size_type k;
+
+      for (p = cycles.begin (); cycles.end () != p; ++p)
+	{
+	  bags[blocks[this->internalGetEdgeLabel (p->back (), p->front ())]].push_back (*p);
+	}
+      tasks.clear ();
+      for (b = 0; count > b; ++b)
+	{
+	  if (! bags[b].empty ())
+	    {
+	      tasks.push_back (new GaussianEliminationTask (*this, bags[b], edgeIndex, edgeCounts[b], dimensions[b], newbags[b], pivots[b]));
 	    }
 	}
+      runTasks (tasks, pool);
 
-      std::sort (cycles.begin (), cycles.end ());
-      gOut (3) << "Found " << cycles.size () << " potential cycles before elimination" << endl << cycles << endl;
-      cycles = gaussianElimination (cycles);
+      // The rows of the whole graph matrix would be ordered over their
+      // leading edge, merge the components in that order.
+      for (e = 0; blocks.size () > e; ++e)
+	{
+	  blockEdges[blocks[e]].push_back (e);
+	}
+      for (b = 0; count > b; ++b)
+	{
+	  for (k = 0; pivots[b].size () > k; ++k)
+	    {
+	      order.push_back (make_pair (blockEdges[b][pivots[b][k]], make_pair (b, k)));
+	    }
+	}
+      std::sort (order.begin (), order.end ());
+      cycles.clear ();
+      for (oIt = order.begin (); order.end () != oIt; ++oIt)
+	{
+	  cycles.push_back (newbags[oIt->second.first][oIt->second.second]);
+	}
       std::sort (cycles.begin (), cycles.end ());
       gOut (3) << "Found " << cycles.size () << " cycles." << endl;
     }
@@ -807,253 +1100,447 @@ namespace mccore
 	}
     }
 
-    pair< bool, vector< vector< bool > >::iterator > gElimination (vector< bool > &candidate, vector< vector< bool > > &matrix) const
+    /**
+     * @short Computes the Vismara prototypes of a range of sources.
+     */
+    class VismaraTask : public ThreadPool::Task
     {
-      vector< vector< bool > >::iterator row;
-      vector< bool >::iterator cIt;
+      const UndirectedGraph *graph;
+      const CsrGraph< V, E, VW, EW > *csr;
+      label first;
+      label last;
+      vector< OrientedGraph< label, bool, bool, size_type > > *D;
+      vector< vector< Cycle< label, size_type > > > *prototypes;
 
-      for (row = matrix.begin (); matrix.end () != row; ++row)
-	{
-	  vector< bool >::const_iterator mIt;
+    public:
 
-	  for (cIt = candidate.begin (), mIt = row->begin ();
-	       candidate.end () != cIt && false == *cIt && false == *mIt;
-	       ++cIt, ++mIt);
-	  if (candidate.end () == cIt)
-	    {
-	      continue;
-	    }
-	  if (true == *cIt && false == *mIt)
+      VismaraTask (const UndirectedGraph &g, const CsrGraph< V, E, VW, EW > &f, label fs, label ls, vector< OrientedGraph< label, bool, bool, size_type > > &d, vector< vector< Cycle< label, size_type > > > &p)
+	: graph (&g), csr (&f), first (fs), last (ls), D (&d), prototypes (&p)
+      { }
+
+      virtual void run ()
+      {
+	label r;
+
+	for (r = first; last > r; ++r)
+	  {
+	    graph->vismaraPrototypes (*csr, r, (*D)[r], (*prototypes)[r]);
+	  }
+      }
+
+    };
+
+    /**
+     * @short Selects the relevant prototypes of a biconnected component.
+     */
+    class BEliminationTask : public ThreadPool::Task
+    {
+      const UndirectedGraph *graph;
+      const vector< Cycle< label, size_type > > *bag;
+      const vector< edge_label > *edgeIndex;
+      edge_size_type edgeCount;
+      vector< char > *keep;
+
+    public:
+
+      BEliminationTask (const UndirectedGraph &g, const vector< Cycle< label, size_type > > &b, const vector< edge_label > &ei, edge_size_type ec, vector< char > &k)
+	: graph (&g), bag (&b), edgeIndex (&ei), edgeCount (ec), keep (&k)
+      { }
+
+      virtual void run () { graph->BElimination (*bag, *edgeIndex, edgeCount, *keep); }
+
+    };
+
+    /**
+     * Computes the prototypes of Vismara's algorithm whose vertex of
+     * highest label is r and fills the digraph of the shortest paths to r.
+     * @param csr the snapshot of the graph for the shortest paths.
+     * @param r the source.
+     * @param Dr the digraph of the shortest paths to fill.
+     * @param prototypes the collection to append the prototypes to.
+     */
+    void vismaraPrototypes (const CsrGraph< V, E, VW, EW > &csr, label r, OrientedGraph< label, bool, bool, size_type > &Dr, vector< Cycle< label, size_type > > &prototypes) const
+    {
+      const size_type MAXUIVALUE = std::numeric_limits< size_type >::max ();
+      vector< Path< label, size_type > > spt;
+      label y;
+
+      csr.sptDijkstraTiernan (r, spt, greater< label > ());
+      for (y = 0; this->size () > y && y < r; ++y)
+	{
+	  Path< label, size_type > &py = spt[y];
+	  vector< label > S;
+	  const vector< label > &neighbors = this->outAdjacency[y];
+	  typename vector< label >::const_iterator z;
+	  typename vector< label >::iterator p;
+	  typename vector< label >::iterator q;
+
+	  for (z = neighbors.begin (); neighbors.end () != z; ++z)
 	    {
-	      return make_pair (false, row);
+	      if (*z < r)
+		{
+		  Path< label, size_type > &pz = spt[*z];
+
+		  if (MAXUIVALUE != py.getValue ()
+		      && MAXUIVALUE != pz.getValue ())
+		    {
+		      if (pz.getValue () + 1 == py.getValue ())
+			{
+			  Dr.addReversePath (py, 1);
+			  Dr.addReversePath (pz, 1);
+			  Dr.connect (y, *z, true, 1);
+			  S.push_back (*z);
+			}
+		      else if (pz.getValue () != py.getValue () + 1 && *z < y)
+			{
+			  set< label > sy;
+			  set< label > sz;
+			  vector< label > inter;
+
+			  sy.insert (py.begin (), py.end ());
+			  sz.insert (pz.begin (), pz.end ());
+			  set_intersection (sy.begin (), sy.end (),
+					    sz.begin (), sz.end (),
+					    inserter (inter, inter.begin ()));
+
+			  if (1 == inter.size () && inter.front () == r)
+			    {
+			      prototypes.push_back (py);
+			      Cycle< label, size_type > &cycle = prototypes.back ();
+
+			      Dr.addReversePath (py, 1);
+			      Dr.addReversePath (pz, 1);
+			      cycle.setP (cycle.size () - 1);
+			      cycle.setQ (cycle.size ());
+			      cycle.insert (cycle.end (), pz.rbegin (), pz.rend () - 1);
+			      cycle.setValue (cycle.getValue () + pz.getValue () + 1);
+			    }
+			}
+		    }
+		}
 	    }
-	  if (true == *cIt && true == *mIt)
+	  for (p = S.begin (); S.end () != p; ++p)
 	    {
-	      // Reduce candidate
-	      for (cIt = candidate.begin (), mIt = row->begin (); candidate.end () != cIt; ++cIt, ++mIt)
+	      for (q = S.begin (); S.end () != q; ++q)
 		{
-			*cIt = *cIt ^ *mIt;
+		  if (p != q)
+		    {
+		      Path< label, size_type > &pp = spt[*p];
+		      Path< label, size_type > &pq = spt[*q];
+		      set< label > sp;
+		      set< label > sq;
+		      vector< label > inter;
+
+		      sp.insert (pp.begin (), pp.end ());
+		      sq.insert (pq.begin (), pq.end ());
+		      set_intersection (sp.begin (), sp.end (),
+					sq.begin (), sq.end (),
+					inserter (inter, inter.begin ()));
+
+		      if (1 == inter.size () && inter.front () == r)
+			{
+			  if (*p < *q)
+			    {
+			      prototypes.push_back (pp);
+			      Cycle< label, size_type > &cycle = prototypes.back ();
+
+			      cycle.setP (cycle.size () - 1);
+			      cycle.setQ (cycle.size () + 1);
+			      cycle.push_back (y);
+			      cycle.insert (cycle.end (), pq.rbegin (), pq.rend () - 1);
+			      cycle.setValue (cycle.getValue () + pq.getValue () + 2);
+			    }
+			}
+		    }
 		}
-	      continue;
 	    }
 	}
-      return make_pair (candidate.end () == std::find (candidate.begin (), candidate.end (), true), matrix.end ());
     }
 
   protected:
 
     /**
+     * Selects the relevant cycles of a bag sorted over their size: a cycle
+     * is kept if it is independent of the shorter cycles.
+     * @param bag a vector of cycles sorted over their size.
+     * @return the relevant cycles.
      */
     vector< Cycle< label, size_type > > BElimination (vector< Cycle< label, size_type > >& bag) const
     {
-      if (bag.empty ())
-	return bag;
-
-      vector< vector< bool > > BLess;
-      vector< vector< bool > > B;
+      vector< edge_label > edgeIndex;
+      vector< char > keep;
       vector< Cycle< label, size_type > > newbag;
-      typename vector< Cycle< label, size_type > >::iterator p;
-      edge_size_type eSize;
-      label pathSize = 0;
-      vector< bool > candidate2;
+      typename vector< Cycle< label, size_type > >::size_type i;
 
-      eSize = this->edgeSize ();
+      identityEdgeIndex (edgeIndex);
+      BElimination (bag, edgeIndex, this->edgeSize (), keep);
+      for (i = 0; bag.size () > i; ++i)
+	{
+	  if (keep[i])
+	    {
+	      newbag.push_back (bag[i]);
+	    }
+	}
+      return newbag;
+    }
 
-      for (p = bag.begin (); p != bag.end (); ++p)
+    /**
+     * Selects the relevant cycles of a part of the graph.
+     * @param bag a vector of cycles sorted over their size.
+     * @param edgeIndex the position of each edge label in the incidence
+     * vectors.
+     * @param edgeCount the size of the incidence vectors.
+     * @param keep whether each cycle of the bag is relevant, to fill.
+     */
+    void BElimination (const vector< Cycle< label, size_type > > &bag, const vector< edge_label > &edgeIndex, edge_size_type edgeCount, vector< char > &keep) const
+    {
+      GF2Matrix BLess;
+      GF2Matrix B;
+      typename vector< Cycle< label, size_type > >::size_type i;
+      label pathSize = 0;
+      GF2Vector candidate;
+      GF2Vector candidate2;
+
+      keep.assign (bag.size (), false);
+      for (i = 0; bag.size () > i; ++i)
 	{
-	  typename Cycle< label, size_type >::iterator r;
-	  typename Cycle< label, size_type >::iterator s;
-	  vector< bool > candidate (eSize, false);
+	  const Cycle< label, size_type > &p = bag[i];
 
-	  if (p->size () != pathSize)
+	  if (p.size () != pathSize)
 	    {
 	      BLess = B;
-	      pathSize = p->size ();
+	      pathSize = p.size ();
 	    }
 
-	  s = p->begin ();
-	  candidate[this->internalGetEdgeLabel (p->back (), *s)] = true;
-	  for (r = s++; p->end () != s; ++r, ++s)
-	    {
-	      candidate[this->internalGetEdgeLabel (*r, *s)] = true;
-	    }
+	  cycleIncidence (p, edgeIndex, edgeCount, candidate);
 	  candidate2 = candidate;
 
-	  if (! gElimination (candidate, BLess).first)
+	  if (! BLess.reduce (candidate).first)
 	    {
-	      pair< bool, vector< vector< bool > >::iterator > res = gElimination (candidate2, B);
+	      pair< bool, GF2Matrix::size_type > res = B.reduce (candidate2);
 
-	      newbag.push_back (*p);
+	      keep[i] = true;
 	      if (! res.first)
 		{
 		  B.insert (res.second, candidate2);
 		}
 	    }
 	}
-      return newbag;
     }
 
-  public:
-
     /**
-     * Vismara's union of minimum cycle bases algorithm.  It returns a
-     * vector of Path (cycles where the first and last vertices are
-     * connected) in graph numerotation.  We should be able to cast the edge
-     * weights to unsigned int.
-     * @param CR the minimum cycle basis collection to fill.
+     * Computes the prototypes of Vismara's algorithm.  The prototypes of
+     * the sources are computed over a CsrGraph snapshot, then the
+     * prototypes of each biconnected component are selected, both on the
+     * thread pool when the graph is searched in parallel.  The results
+     * are merged in source order and in the order of the sorted prototypes
+     * so that they do not depend on the scheduling.
+     * @param prototypes the sorted prototypes to fill.
+     * @param D the digraphs of the shortest paths to each source to fill.
+     * @param pool the thread pool, null for none.
      */
-    void internalUnionMinimumCycleBases (vector< Path< label, size_type > > &CR) const
+    void unionPrototypes (vector< Cycle< label, size_type > > &prototypes, vector< OrientedGraph< label, bool, bool, size_type > > &D, const ThreadPool *pool) const
     {
-      const size_type MAXUIVALUE = std::numeric_limits< size_type >::max ();
+      const CsrGraph< V, E, VW, EW > csr (*this);
       label r;
-      vector< Cycle< label, size_type > > prototypes;
       typename vector< Cycle< label, size_type > >::iterator protIt;
-      typename vector< Path< label, size_type > >::iterator it;
-      vector< OrientedGraph< label, bool, bool, size_type > > D (this->size ());
-
+      vector< vector< Cycle< label, size_type > > > sourcePrototypes (this->size ());
+      vector< ThreadPool::Task* > tasks;
+      vector< label > bounds;
+      vector< size_type > blocks;
+      vector< edge_label > edgeIndex;
+      vector< edge_size_type > edgeCounts;
+      vector< size_type > dimensions;
+      size_type count;
+      size_type b;
+      typename vector< Cycle< label, size_type > >::size_type i;
+
+      D.resize (this->size ());
+      sourceRanges (pool, bounds);
+      for (r = 0; bounds.size () > r + 1; ++r)
+	{
+	  tasks.push_back (new VismaraTask (*this, csr, bounds[r], bounds[r + 1], D, sourcePrototypes));
+	}
+      runTasks (tasks, pool);
       for (r = 0; this->size () > r; ++r)
 	{
-	  vector< Path< label, size_type > > spt;
-	  label y;
-	  OrientedGraph< label, bool, bool, size_type > &Dr = D[r];
+	  prototypes.insert (prototypes.end (), sourcePrototypes[r].begin (), sourcePrototypes[r].end ());
+	  vector< Cycle< label, size_type > > ().swap (sourcePrototypes[r]);
+	}
+
+      std::sort (prototypes.begin (), prototypes.end ());
+      gOut (3) << "Found " << prototypes.size ()
+	       << " potential prototypes before elimination" << endl;
+      gOut (4) << prototypes << endl;
 
-	  sptDijkstraTiernan (r, spt, greater< label > ());
-	  for (y = 0; this->size () > y && y < r; ++y)
+      count = blockPartition (blocks, edgeIndex, edgeCounts, dimensions);
+      vector< vector< Cycle< label, size_type > > > bags (count);
+      vector< vector< typename vector< Cycle< label, size_type > >::size_type > > origins (count);
+      vector< vector< char > > keeps (count);
+      vector< char > keep (prototypes.size (), false);
+
+      for (i = 0; prototypes.size () > i; ++i)
+	{
+	  b = blocks[this->internalGetEdgeLabel (prototypes[i].back (), prototypes[i].front ())];
+	  bags[b].push_back (prototypes[i]);
+	  origins[b].push_back (i);
+	}
+      tasks.clear ();
+      for (b = 0; count > b; ++b)
+	{
+	  if (! bags[b].empty ())
 	    {
-	      Path< label, size_type > &py = spt[y];
-	      vector< label > S;
-	      list< label > neighbors;
-	      typename list< label >::iterator z;
-	      typename vector< label >::iterator p;
-	      typename vector< label >::iterator q;
-
-	      neighbors = internalNeighborhood (y);
-	      for (z = neighbors.begin (); neighbors.end () != z; ++z)
-		{
-		  if (*z < r)
-		    {
-		      Path< label, size_type > &pz = spt[*z];
+	      tasks.push_back (new BEliminationTask (*this, bags[b], edgeIndex, edgeCounts[b], keeps[b]));
+	    }
+	}
+      runTasks (tasks, pool);
+      for (b = 0; count > b; ++b)
+	{
+	  for (i = 0; bags[b].size () > i; ++i)
+	    {
+	      keep[origins[b][i]] = keeps[b][i];
+	    }
+	}
+      for (protIt = prototypes.begin (), i = 0; prototypes.size () > i; ++i)
+	{
+	  if (keep[i])
+	    {
+	      *protIt++ = prototypes[i];
+	    }
+	}
+      prototypes.erase (protIt, prototypes.end ());
+      gOut (3) << "Found " << prototypes.size () << " prototypes" << endl;
+      gOut (4) << prototypes << endl;
+    }
 
-		      if (MAXUIVALUE != py.getValue ()
-			  && MAXUIVALUE != pz.getValue ())
-			{
-			  if (pz.getValue () + 1 == py.getValue ())
-			    {
-			      Dr.addReversePath (py, 1);
-			      Dr.addReversePath (pz, 1);
-			      Dr.connect (y, *z, true, 1);
-			      S.push_back (*z);
-			    }
-			  else if (pz.getValue () != py.getValue () + 1 && *z < y)
-			    {
-			      set< label > sy;
-			      set< label > sz;
-			      vector< label > inter;
-
-			      sy.insert (py.begin (), py.end ());
-			      sz.insert (pz.begin (), pz.end ());
-			      set_intersection (sy.begin (), sy.end (),
-						sz.begin (), sz.end (),
-						inserter (inter, inter.begin ()));
-
-			      if (1 == inter.size () && inter.front () == r)
-				{
-				  prototypes.push_back (py);
-				  Cycle< label, size_type > &cycle = prototypes.back ();
-
-				  Dr.addReversePath (py, 1);
-				  Dr.addReversePath (pz, 1);
-				  cycle.setP (cycle.size () - 1);
-				  cycle.setQ (cycle.size ());
-				  cycle.insert (cycle.end (), pz.rbegin (), pz.rend () - 1);
-				  cycle.setValue (cycle.getValue () + pz.getValue () + 1);
-				  gOut (4) << cycle << " r = " << cycle.getR ()
-					   << " p = " << cycle.getP ()
-					   << " q = " << cycle.getQ () << endl;
-				}
-			    }
-			}
-		    }
-		}
-	      for (p = S.begin (); S.end () != p; ++p)
-		{
-		  for (q = S.begin (); S.end () != q; ++q)
-		    {
-		      if (p != q)
-			{
-			  Path< label, size_type > &pp = spt[*p];
-			  Path< label, size_type > &pq = spt[*q];
-			  set< label > sp;
-			  set< label > sq;
-			  vector< label > inter;
+    /**
+     * Finds the paths from q to the root of a digraph of shortest paths.
+     * The paths are written from the root to q, in the order of the
+     * breadth first search of OrientedGraph::breadthFirstPaths since every
+     * path to the root has the same number of edges.
+     * @param Dr the digraph of the shortest paths to the root.
+     * @param q the starting vertex.
+     * @param paths the collection to fill.
+     */
+    static void rootPaths (const OrientedGraph< label, bool, bool, size_type > &Dr, label q, vector< Path< label, size_type > > &paths)
+    {
+      typedef typename OrientedGraph< label, bool, bool, size_type >::neighbor_const_iterator neighbor_const_iterator;
+      vector< label > stack;
+      vector< neighbor_const_iterator > next;
 
-			  sp.insert (pp.begin (), pp.end ());
-			  sq.insert (pq.begin (), pq.end ());
-			  set_intersection (sp.begin (), sp.end (),
-					    sq.begin (), sq.end (),
-					    inserter (inter, inter.begin ()));
+      paths.clear ();
+      stack.push_back (Dr.getVertexLabel (q));
+      next.push_back (Dr.internalOutAdjacency (stack.back ()).begin ());
+      while (! stack.empty ())
+	{
+	  const vector< label > &neighbors = Dr.internalOutAdjacency (stack.back ());
 
-			  if (1 == inter.size () && inter.front () == r)
-			    {
-			      if (*p < *q)
-				{
-				  prototypes.push_back (pp);
-				  Cycle< label, size_type > &cycle = prototypes.back ();
-
-				  cycle.setP (cycle.size () - 1);
-				  cycle.setQ (cycle.size () + 1);
-				  cycle.push_back (y);
-				  cycle.insert (cycle.end (), pq.rbegin (), pq.rend () - 1);
-				  cycle.setValue (cycle.getValue () + pq.getValue () + 2);
-				  gOut (4) << cycle << " r = " << cycle.getR ()
-					   << " p = " << cycle.getP ()
-					   << " y = " << cycle.getY ()
-					   << " q = " << cycle.getQ () << endl;
-				}
-			    }
-			}
-		    }
+	  if (neighbors.empty ())
+	    {
+	      typename vector< label >::reverse_iterator rIt;
+
+	      paths.push_back (Path< label, size_type > ());
+	      Path< label, size_type > &path = paths.back ();
+
+	      for (rIt = stack.rbegin (); stack.rend () != rIt; ++rIt)
+		{
+		  path.push_back (Dr.internalGetVertex (*rIt));
 		}
+	      path.setValue (stack.size () - 1);
+	      stack.pop_back ();
+	      next.pop_back ();
+	    }
+	  else if (neighbors.end () == next.back ())
+	    {
+	      stack.pop_back ();
+	      next.pop_back ();
+	    }
+	  else
+	    {
+	      label n = *next.back ()++;
+
+	      stack.push_back (n);
+	      next.push_back (Dr.internalOutAdjacency (n).begin ());
 	    }
 	}
-      std::sort (prototypes.begin (), prototypes.end ());
-      gOut (3) << "Found " << prototypes.size ()
-	       << " potential prototypes before elimination" << endl;
-      gOut (4) << prototypes << endl;
-      prototypes = BElimination (prototypes);
-      gOut (3) << "Found " << prototypes.size () << " prototypes" << endl;
-      gOut (4) << prototypes << endl;
+    }
+
+    /**
+     * Visitor collecting the cycles in a vector.
+     */
+    class CycleCollector
+    {
+      vector< Path< label, size_type > > *cycles;
+
+    public:
+
+      CycleCollector (vector< Path< label, size_type > > &cycles)
+	: cycles (&cycles)
+      { }
+
+      bool operator() (const Path< label, size_type > &cycle)
+      {
+	cycles->push_back (cycle);
+	return true;
+      }
+    };
 
-      // Enumeration of CR.
+  public:
+
+    /**
+     * Vismara's union of minimum cycle bases algorithm, streaming version.
+     * The cycles are given to the visitor as they are built instead of
+     * being stored: the visitor is called as visitor (cycle) with a Path
+     * in graph numerotation that is only valid during the call, and
+     * returns false to stop the enumeration.  Cycles come grouped by
+     * prototype in order of non decreasing length.  We should be able to
+     * cast the edge weights to unsigned int.
+     * @param visitor the function object receiving the cycles.
+     * @param maxLength the maximum number of edges of the visited cycles,
+     *        0 for no bound.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @param pool the thread pool for the prototypes, null to run on the
+     *        calling thread (default).
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type internalUnionMinimumCycleBases (Visitor &visitor, size_type maxLength = 0, size_type maxCount = 0, const ThreadPool *pool = 0) const
+    {
+      vector< Cycle< label, size_type > > prototypes;
+      typename vector< Cycle< label, size_type > >::const_iterator protIt;
+      vector< OrientedGraph< label, bool, bool, size_type > > D;
+      vector< Path< label, size_type > > pPaths;
+      vector< Path< label, size_type > > qPaths;
+      Path< label, size_type > cycle;
+      size_type count;
+
+      unionPrototypes (prototypes, D, pool);
+      count = 0;
       for (protIt = prototypes.begin (); prototypes.end () != protIt; ++protIt)
 	{
-	  Cycle< label, size_type > &prototype = *protIt;
-	  label p;
-	  label q;
-	  vector< Path< label, size_type > > pPaths;
-	  vector< Path< label, size_type > > qPaths;
-	  typename vector< Path< label, size_type > >::iterator pPathIterator;
-	  typename vector< Path< label, size_type > >::iterator qPathIterator;
-
-	  r = prototype.getR ();
-	  p = prototype.getP ();
-	  q = prototype.getQ ();
-	  pPaths = D[r].breadthFirstPaths (p);
-	  qPaths = D[r].breadthFirstPaths (q);
+	  const Cycle< label, size_type > &prototype = *protIt;
+	  typename vector< Path< label, size_type > >::const_iterator pPathIterator;
+	  typename vector< Path< label, size_type > >::const_iterator qPathIterator;
 
+	  if (0 != maxLength && prototype.size () > maxLength)
+	    {
+	      continue;
+	    }
+	  rootPaths (D[prototype.getR ()], prototype.getP (), pPaths);
+	  rootPaths (D[prototype.getR ()], prototype.getQ (), qPaths);
 	  for (pPathIterator = pPaths.begin (); pPaths.end () != pPathIterator; ++pPathIterator)
 	    {
 	      for (qPathIterator = qPaths.begin (); qPaths.end () != qPathIterator; ++qPathIterator)
 		{
-		  CR.push_back (*pPathIterator);
-		  Path< label, size_type > &cycle = CR.back ();
-
+		  if (0 != maxCount && maxCount == count)
+		    {
+		      return count;
+		    }
+		  cycle = *pPathIterator;
 		  if (0 == prototype.size () % 2)
 		    {
-		      size_type y;
-
-		      y = prototype.getY ();
-		      cycle.push_back (y);
+		      cycle.push_back (prototype.getY ());
 		      cycle.setValue (cycle.getValue () + 1 + 1);
 		    }
 		  else
@@ -1062,14 +1549,96 @@ namespace mccore
 		    }
 		  cycle.insert (cycle.end (), qPathIterator->rbegin (), qPathIterator->rend () - 1);
 		  cycle.setValue (cycle.getValue () + qPathIterator->getValue ());
+		  ++count;
+		  if (! visitor (cycle))
+		    {
+		      return count;
+		    }
 		}
 	    }
 	}
+      return count;
+    }
+
+    /**
+     * Vismara's union of minimum cycle bases algorithm.  It returns a
+     * vector of Path (cycles where the first and last vertices are
+     * connected) in graph numerotation.  We should be able to cast the edge
+     * weights to unsigned int.
+     * @param CR the minimum cycle basis collection to fill.
+     * @param pool the thread pool for the prototypes, null to run on the
+     *        calling thread (default).
+     */
+    void internalUnionMinimumCycleBases (vector< Path< label, size_type > > &CR, const ThreadPool *pool = 0) const
+    {
+      CycleCollector collector (CR);
+
+      internalUnionMinimumCycleBases (collector, 0, 0, pool);
       std::sort (CR.begin (), CR.end ());
       gOut (3) << "Found " << CR.size () << " cycles" << endl;
       gOut (4) << CR << endl;
     }
 
+    /**
+     * Enumerates the simple cycles of at most maxLength edges, without
+     * computing a cycle basis.  The search runs on a CsrGraph snapshot by
+     * a depth first search from each vertex, bounded by the distances
+     * back to it, so its cost depends on the neighborhoods within
+     * maxLength / 2 edges instead of the whole graph.  Each cycle is given
+     * once to the visitor as a Path in graph numerotation, as in
+     * CsrGraph::shortCycles.
+     * @param visitor the function object receiving the cycles.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type internalShortCycles (Visitor &visitor, size_type maxLength, size_type maxCount = 0) const
+    {
+      const CsrGraph< V, E, VW, EW > csr (*this);
+
+      return csr.shortCycles (maxLength, visitor, maxCount);
+    }
+
+    /**
+     * Enumerates the simple cycles of at most maxLength edges going
+     * through at least one of the root vertices.  Only the neighborhoods
+     * of the roots are searched.
+     * @param roots the root vertex labels.
+     * @param visitor the function object receiving the cycles.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type internalShortCycles (const vector< label > &roots, Visitor &visitor, size_type maxLength, size_type maxCount = 0) const
+    {
+      const CsrGraph< V, E, VW, EW > csr (*this);
+
+      return csr.shortCycles (roots, maxLength, visitor, maxCount);
+    }
+
+    /**
+     * Enumerates the simple cycles of at most maxLength edges going
+     * through at least one of the root edges.  Only the neighborhoods of
+     * the roots are searched.
+     * @param roots the root edge labels.
+     * @param visitor the function object receiving the cycles.
+     * @param maxLength the maximum number of edges of the cycles.
+     * @param maxCount the maximum number of cycles to visit, 0 for no
+     *        bound.
+     * @return the number of visited cycles.
+     */
+    template< class Visitor >
+    size_type internalShortCyclesThrough (const vector< edge_label > &roots, Visitor &visitor, size_type maxLength, size_type maxCount = 0) const
+    {
+      const CsrGraph< V, E, VW, EW > csr (*this);
+
+      return csr.shortCyclesThrough (roots, maxLength, visitor, maxCount);
+    }
+
     /**
      * Prim's algorithm for the minimum spanning tree.
      * @return a vector of edges representing a spanning tree of the graph.
@@ -0,0 +1,259 @@
+//                              -*- Mode: C++ -*-
+// AnnotationBenchmark.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:17:56 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "GraphModel.h"
+#include "Messagestream.h"
+#include "Model.h"
+#include "Pdbstream.h"
+#include "PropertyType.h"
+#include "Relation.h"
+#include "ResId.h"
+#include "Exception.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Counts of the fast pairing screening calls compared to the full
+ * annotation.
+ */
+struct Accuracy
+{
+  unsigned int full;
+  unsigned int fast;
+  unsigned int both;
+  unsigned int faces;
+  unsigned int cisTrans;
+
+  Accuracy () : full (0), fast (0), both (0), faces (0), cisTrans (0) { }
+};
+
+
+
+/**
+ * Annotates a fresh GraphModel copy of the model a number of times and
+ * returns the mean time of an annotation pass.
+ */
+static double
+benchmark (const Model &model, unsigned char aspb, int passes, GraphModel::size_type &relations)
+{
+  clock_t total;
+  int pass;
+
+  total = 0;
+  for (pass = 0; passes > pass; ++pass)
+    {
+      GraphModel graph (model);
+      clock_t start;
+
+      start = clock ();
+      graph.annotate (aspb);
+      total += clock () - start;
+      relations = graph.edgeSize ();
+    }
+  return (double) total / CLOCKS_PER_SEC / passes;
+}
+
+
+
+/**
+ * Collects the pairing relations of an annotated model, once per residue
+ * pair.
+ */
+static void
+getPairs (const GraphModel &graph, map< pair< ResId, ResId >, const Relation* > &pairs)
+{
+  GraphModel::edge_const_iterator it;
+
+  for (it = graph.edge_begin (); graph.edge_end () != it; ++it)
+    {
+      const Relation *rel = *it;
+
+      if (rel->isPairing ()
+	  && rel->getRef ()->getResId () < rel->getRes ()->getResId ())
+	{
+	  pairs[make_pair (rel->getRef ()->getResId (), rel->getRes ()->getResId ())] = rel;
+	}
+    }
+}
+
+
+
+/**
+ * Compares the base pairs of the fast screening to the ones of the full
+ * annotation.
+ */
+static void
+compare (const Model &model, Accuracy &accuracy)
+{
+  GraphModel full (model);
+  GraphModel fast (model);
+  map< pair< ResId, ResId >, const Relation* > fullPairs;
+  map< pair< ResId, ResId >, const Relation* > fastPairs;
+  map< pair< ResId, ResId >, const Relation* >::const_iterator it;
+  map< pair< ResId, ResId >, const Relation* >::const_iterator found;
+
+  full.annotate (Relation::pairing_mask);
+  fast.annotate (Relation::pairing_mask | Relation::fast_mask);
+  getPairs (full, fullPairs);
+  getPairs (fast, fastPairs);
+  accuracy.full += fullPairs.size ();
+  accuracy.fast += fastPairs.size ();
+  for (it = fullPairs.begin (); fullPairs.end () != it; ++it)
+    {
+      if (fastPairs.end () != (found = fastPairs.find (it->first)))
+	{
+	  const Relation *f = found->second;
+
+	  ++accuracy.both;
+	  if (it->second->getRefFace () == f->getRefFace ()
+	      && it->second->getResFace () == f->getResFace ())
+	    {
+	      ++accuracy.faces;
+	    }
+	  if (it->second->has (PropertyType::pCis) == f->has (PropertyType::pCis))
+	    {
+	      ++accuracy.cisTrans;
+	    }
+	}
+    }
+}
+
+
+
+static double
+percent (unsigned int n, unsigned int total)
+{
+  return 0 == total ? 100.0 : 100.0 * n / total;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  const unsigned char all = Relation::adjacent_mask | Relation::pairing_mask | Relation::stacking_mask | Relation::bhbond_mask;
+  vector< const char* > filenames;
+  vector< const char* >::iterator name;
+  int passes = 5;
+  int arg;
+  GraphModel::size_type relations;
+  double seconds;
+  double fullSeconds;
+  double fastSeconds;
+  double fullTotal;
+  double fastTotal;
+  unsigned int residues;
+  Accuracy accuracy;
+
+  for (arg = 1; argc > arg; ++arg)
+    {
+      if (0 == strcmp (argv[arg], "-p") && argc > arg + 1)
+	{
+	  passes = atoi (argv[++arg]);
+	}
+      else
+	{
+	  filenames.push_back (argv[arg]);
+	}
+    }
+  if (filenames.empty ())
+    {
+      filenames.push_back ("1L8V.pdb.gz");
+    }
+
+  fullTotal = 0;
+  fastTotal = 0;
+  residues = 0;
+  for (name = filenames.begin (); filenames.end () != name; ++name)
+    {
+      Model model;
+
+      try
+	{
+	  izfPdbstream ifs;
+    
+	  ifs.open (*name);
+	  if (! ifs)
+	    {
+	      IntLibException ex ("failed to open \"", __FILE__, __LINE__);
+	      ex << *name << "\"";
+	      throw ex;
+	    }
+	  ifs >> model;
+	  ifs.close ();
+	}
+      catch (Exception& ex)
+	{
+	  gErr (0) << argv[0] << ": " << ex << endl;
+	  return EXIT_FAILURE;
+	}
+
+      gOut (0) << *name << ": " << model.size () << " residues, "
+	       << passes << " passes" << endl;
+      fullSeconds = benchmark (model, all, passes, relations);
+      gOut (0) << "full annotation: " << fullSeconds << " s, "
+	       << relations << " relations" << endl;
+      seconds = benchmark (model, Relation::pairing_mask, passes, relations);
+      gOut (0) << "pairing only: " << seconds << " s, "
+	       << relations << " relations" << endl;
+      fastSeconds = benchmark (model, all | Relation::fast_mask, passes, relations);
+      gOut (0) << "fast annotation: " << fastSeconds << " s, "
+	       << relations << " relations" << endl;
+      compare (model, accuracy);
+      fullTotal += fullSeconds;
+      fastTotal += fastSeconds;
+      residues += model.size ();
+    }
+
+  // Accuracy of the fast screening against the full annotation over the
+  // whole corpus.
+  gOut (0) << "corpus: " << filenames.size () << " models, "
+	   << residues << " residues" << endl;
+  gOut (0) << "throughput: full " << residues / fullTotal
+	   << " residues/s, fast " << residues / fastTotal
+	   << " residues/s (x" << fullTotal / fastTotal << ")" << endl;
+  gOut (0) << "base pairs: full " << accuracy.full
+	   << ", fast " << accuracy.fast
+	   << ", common " << accuracy.both << endl;
+  gOut (0) << "precision " << percent (accuracy.both, accuracy.fast)
+	   << "%, recall " << percent (accuracy.both, accuracy.full)
+	   << "%, same faces " << percent (accuracy.faces, accuracy.both)
+	   << "%, same cis/trans " << percent (accuracy.cisTrans, accuracy.both)
+	   << "%" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+//                              -*- Mode: C++ -*-
+// AnnotationCache.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 04:46:51 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AnnotationCache.h"
+#include "Exception.h"
+#include "GraphModel.h"
+#include "Messagestream.h"
+#include "Model.h"
+#include "Pdbstream.h"
+#include "Relation.h"
+#include "Residue.h"
+#include "RelationDescription.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Makes a key holding a single distinguishing value.
+ */
+static AnnotationCache::Key
+makeKey (int n)
+{
+  AnnotationCache::Key key;
+
+  key.refConformer = n;
+  key.resConformer = n;
+  key.aspb = 0;
+  fill (key.tfo, key.tfo + 12, n);
+  return key;
+}
+
+
+
+/**
+ * Makes an annotation holding a single distinguishing value.
+ */
+static AnnotationCache::Annotation
+makeAnnotation (float n)
+{
+  AnnotationCache::Annotation annotation;
+
+  annotation.type_aspb = 0;
+  annotation.refFace = 0;
+  annotation.resFace = 0;
+  annotation.sum_flow = n;
+  return annotation;
+}
+
+
+
+static void
+show (AnnotationCache &cache, int n)
+{
+  const AnnotationCache::Annotation *annotation;
+
+  annotation = cache.find (makeKey (n));
+  gOut (0) << " " << n << ":";
+  if (0 == annotation)
+    {
+      gOut (0) << "miss";
+    }
+  else
+    {
+      gOut (0) << annotation->sum_flow;
+    }
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  AnnotationCache cache (3);
+  AnnotationCache::Key key;
+  AnnotationCache::Key inverse;
+  Model model;
+  Model::iterator mit;
+  vector< string > reference;
+  bool inverted;
+  bool inverseInverted;
+  unsigned int conformer;
+  int i;
+
+  // Least recently used eviction.
+  for (i = 1; 3 >= i; ++i)
+    {
+      cache.insert (makeKey (i), makeAnnotation (i));
+    }
+  gOut (0) << "size " << cache.size () << ", capacity " << cache.getCapacity () << ":";
+  show (cache, 1);
+  show (cache, 2);
+  show (cache, 3);
+  gOut (0) << endl;
+  cache.insert (makeKey (4), makeAnnotation (4));
+  cache.insert (makeKey (3), makeAnnotation (30));
+  gOut (0) << "insert 4, 3 again:";
+  show (cache, 1);
+  show (cache, 2);
+  show (cache, 3);
+  show (cache, 4);
+  gOut (0) << endl;
+  cache.setCapacity (1);
+  gOut (0) << "capacity 1:";
+  show (cache, 2);
+  show (cache, 3);
+  show (cache, 4);
+  gOut (0) << endl << "hits " << cache.getHits () << ", misses " << cache.getMisses () << endl;
+  cache.setCapacity (0);
+  cache.insert (makeKey (5), makeAnnotation (5));
+  gOut (0) << "capacity 0: size " << cache.size () << endl;
+  cache.setCapacity (10);
+  cache.insert (makeKey (6), makeAnnotation (6));
+  cache.setTolerance (0.02, 0.002);
+  gOut (0) << "new tolerance: size " << cache.size () << ", hits " << cache.getHits ()
+	   << ", misses " << cache.getMisses () << endl;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+
+  // Keys of residues without a conformer, and of both orders of a pair.
+  gOut (0) << "key without conformers: "
+	   << cache.makeKey (&model[0], &model[1], Relation::pairing_mask, key, inverted) << endl;
+  for (mit = model.begin (), conformer = 1; model.end () != mit; ++mit, ++conformer)
+    {
+      mit->setConformer (conformer);
+    }
+  cache.makeKey (&model[0], &model[1], Relation::pairing_mask, key, inverted);
+  cache.makeKey (&model[1], &model[0], Relation::pairing_mask, inverse, inverseInverted);
+  gOut (0) << "keys of both orders: same " << ! (key < inverse || inverse < key)
+	   << ", inverted " << inverted << " " << inverseInverted << endl;
+
+  // Annotations through the cache give the same relations, and annotating
+  // a copy of the model finds every pair in the cache.
+  {
+    GraphModel graph (model);
+
+    graph.annotate ();
+    reference = describe (graph);
+  }
+  cache.clear ();
+  cache.setCapacity (100000);
+  for (i = 0; 2 > i; ++i)
+    {
+      GraphModel graph (model);
+
+      graph.setAnnotationCache (&cache);
+      graph.annotate ();
+      gOut (0) << "annotation " << i + 1 << " through the cache: "
+	       << graph.edgeSize () << " relations, "
+	       << (describe (graph) == reference ? "same" : "different")
+	       << ", hits " << cache.getHits () << ", misses " << cache.getMisses () << endl;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+//                              -*- Mode: C++ -*-
+// Arena.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:12:40 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <iostream>
+
+#include "Arena.h"
+#include "Atom.h"
+#include "Exception.h"
+#include "GraphModel.h"
+#include "Messagestream.h"
+#include "ModelFactoryMethod.h"
+#include "Molecule.h"
+#include "Pdbstream.h"
+#include "Relation.h"
+#include "ResidueFactoryMethod.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Tells if the residues and the relations of a model are all allocated in
+ * an arena.
+ */
+static bool
+isOwned (const GraphModel &model, const Arena *arena)
+{
+  GraphModel::const_iterator it;
+  GraphModel::edge_const_iterator eit;
+
+  for (it = model.begin (); model.end () != it; ++it)
+    {
+      if (arena != Arena::owner (&*it))
+	{
+	  return false;
+	}
+    }
+  for (eit = model.edge_begin (); model.edge_end () != eit; ++eit)
+    {
+      if (arena != Arena::owner (*eit))
+	{
+	  return false;
+	}
+    }
+  return true;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  ExtendedResidueFM pooledFM (true);
+  GraphModelFM modelFM (0, true);
+  GraphModel heap;
+  GraphModel *pooled;
+  Molecule molecule (&modelFM);
+  Arena *arena;
+  Atom *atom;
+
+  try
+    {
+      izfPdbstream ifs;
+      izfPdbstream mfs;
+
+      ifs.open ("1L8V.pdb.gz");
+      mfs.open ("1L8V.pdb.gz");
+      if (! ifs || ! mfs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> heap;
+      ifs.close ();
+      mfs >> molecule;
+      mfs.close ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+
+  // Objects created with no current arena come from the heap.
+  atom = new Atom ();
+  gOut (0) << "heap atom: " << (0 == Arena::owner (atom) ? "no arena" : "arena") << endl;
+  delete atom;
+  heap.annotate ();
+  gOut (0) << "heap model: " << heap.size () << " residues, "
+	   << heap.edgeSize () << " relations, "
+	   << (isOwned (heap, 0) ? "no arena" : "arena") << endl;
+
+  // A pooled model, built and destroyed.
+  pooled = new GraphModel (heap, &pooledFM);
+  arena = pooled->getResidueFM ()->getArena ();
+  arena->ref ();
+  pooled->annotate ();
+  gOut (0) << "pooled model: " << pooled->size () << " residues, "
+	   << pooled->edgeSize () << " relations, "
+	   << (0 != arena && pooledFM.getArena () != arena ? "own arena" : "shared arena") << ", "
+	   << (isOwned (*pooled, arena) ? "owned" : "not owned") << ", "
+	   << (0 < arena->getLiveCount () ? "blocks in use" : "no block in use") << endl;
+  delete pooled;
+  gOut (0) << "pooled model destroyed: " << arena->getLiveCount () << " blocks in use" << endl;
+  arena->unref ();
+
+  // Models read through a pooled model factory method.
+  {
+    const GraphModel &model = dynamic_cast< const GraphModel& > (*molecule.begin ());
+
+    arena = model.getResidueFM ()->getArena ();
+    gOut (0) << "molecule: " << molecule.size () << " models, "
+	     << model.size () << " residues, "
+	     << (0 != arena && isOwned (model, arena) ? "pooled" : "not pooled") << endl;
+  }
+
+  // Assigned factory methods take their own arena.
+  {
+    ExtendedResidueFM fm;
+
+    fm = pooledFM;
+    gOut (0) << "assigned pooled: "
+	     << (0 != fm.getArena () && pooledFM.getArena () != fm.getArena () ? "own arena" : "no own arena")
+	     << endl;
+    fm = ExtendedResidueFM ();
+    gOut (0) << "assigned heap: " << (0 == fm.getArena () ? "no arena" : "arena") << endl;
+    fm.setPooled (true);
+    gOut (0) << "set pooled: " << (0 != fm.getArena () ? "arena" : "no arena") << endl;
+  }
+
+  return EXIT_SUCCESS;
+}
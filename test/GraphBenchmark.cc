@@ -0,0 +1,164 @@
+//                              -*- Mode: C++ -*-
+// GraphBenchmark.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:51:13 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "Messagestream.h"
+#include "OrientedGraph.h"
+#include "UndirectedGraph.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+typedef UndirectedGraph< int, int, float, float > UGraph;
+typedef OrientedGraph< int, int, float, float > OGraph;
+
+
+
+/**
+ * Number of chords added from each vertex.
+ */
+static const int chords = 4;
+
+
+
+static double
+seconds (clock_t start)
+{
+  return (double) (clock () - start) / CLOCKS_PER_SEC;
+}
+
+
+
+/**
+ * Times the graph operations on a ring of n vertices, each one connected
+ * to the vertices 7, 14, 21 and 28 labels ahead, as the OrientedGraph and
+ * UndirectedGraph tests do on a few vertices.  The neighborhoods of every
+ * vertex are queried for a number of passes, then a tenth of the vertices
+ * are erased.
+ */
+static void
+benchmark (int n, int passes)
+{
+  UGraph ugraph;
+  OGraph ograph;
+  clock_t start;
+  double connectSeconds;
+  double neighborhoodSeconds;
+  double eraseSeconds;
+  unsigned long neighbors;
+  int pass;
+  int i;
+  int k;
+
+  for (i = 0; n > i; ++i)
+    {
+      ugraph.insert (i);
+      ograph.insert (i);
+    }
+
+  start = clock ();
+  for (i = 0; n > i; ++i)
+    {
+      for (k = 1; chords >= k; ++k)
+	{
+	  ugraph.connect (i, (i + k * 7) % n, i);
+	  ograph.connect (i, (i + k * 7) % n, i);
+	}
+    }
+  connectSeconds = seconds (start);
+
+  neighbors = 0;
+  start = clock ();
+  for (pass = 0; passes > pass; ++pass)
+    {
+      for (i = 0; n > i; ++i)
+	{
+	  neighbors += ugraph.internalNeighborhood (i).size ();
+	  neighbors += ugraph.neighborhood (i).size ();
+	  neighbors += ograph.internalOutNeighborhood (i).size ();
+	  neighbors += ograph.internalInNeighborhood (i).size ();
+	}
+    }
+  neighborhoodSeconds = seconds (start);
+
+  start = clock ();
+  for (i = 0; n / 10 > i; ++i)
+    {
+      ugraph.internalErase (0);
+      ograph.internalErase (0);
+    }
+  eraseSeconds = seconds (start);
+
+  gOut (0) << n << " vertices, " << ugraph.edgeSize () + ograph.edgeSize ()
+	   << " edges left" << endl;
+  gOut (0) << "connect: " << connectSeconds << " s" << endl;
+  gOut (0) << "neighborhoods: " << neighborhoodSeconds << " s, "
+	   << passes << " passes, " << neighbors << " neighbors" << endl;
+  gOut (0) << "erase: " << eraseSeconds << " s" << endl;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  vector< int > sizes;
+  vector< int >::iterator size;
+  int passes = 5;
+  int arg;
+
+  for (arg = 1; argc > arg; ++arg)
+    {
+      if (0 == strcmp (argv[arg], "-p") && argc > arg + 1)
+	{
+	  passes = atoi (argv[++arg]);
+	}
+      else
+	{
+	  sizes.push_back (atoi (argv[arg]));
+	}
+    }
+  if (sizes.empty ())
+    {
+      sizes.push_back (1000);
+      sizes.push_back (4000);
+    }
+
+  for (size = sizes.begin (); sizes.end () != size; ++size)
+    {
+      benchmark (*size, passes);
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+//                              -*- Mode: C++ -*-
+// GraphModelView.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 04:47:12 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Binstream.h"
+#include "Exception.h"
+#include "GraphModel.h"
+#include "GraphModelView.h"
+#include "Messagestream.h"
+#include "Pdbstream.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+static string
+slurp (const char *filename)
+{
+  ifstream ifs (filename);
+  ostringstream oss;
+
+  oss << ifs.rdbuf ();
+  return oss.str ();
+}
+
+
+
+/**
+ * Writes the view to a binary stream, reads it back as a GraphModel and
+ * compares it with what copy produces.
+ * @param view the view.
+ * @return whether both models have the same residues, relations and binary
+ * image.
+ */
+static bool
+roundTrip (const GraphModelView &view)
+{
+  GraphModel back;
+  GraphModel copied;
+
+  {
+    ofBinstream obs ("GraphModelView.bin");
+
+    obs << view;
+  }
+  {
+    ifBinstream ibs ("GraphModelView.bin");
+
+    ibs >> back;
+  }
+  view.copy (copied);
+  {
+    ofBinstream obs ("GraphModelView.back.bin");
+
+    obs << back;
+  }
+  {
+    ofBinstream obs ("GraphModelView.copy.bin");
+
+    obs << copied;
+  }
+  return (back.size () == view.size ()
+	  && copied.size () == view.size ()
+	  && back.edgeSize () == copied.edgeSize ()
+	  && slurp ("GraphModelView.back.bin") == slurp ("GraphModelView.copy.bin"));
+}
+
+
+
+/**
+ * Round-trips a list of views and reports how many differ from their copy.
+ */
+static void
+check (const char *title, const vector< GraphModelView > &views)
+{
+  vector< GraphModelView >::size_type i;
+  unsigned int different;
+
+  for (i = 0, different = 0; views.size () > i; ++i)
+    {
+      different += roundTrip (views[i]) ? 0 : 1;
+    }
+  gOut (0) << title << ": " << views.size () << " views, "
+	   << (0 == different ? "all same" : "some different") << endl;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  GraphModel model;
+  vector< GraphModelView > basis;
+  vector< GraphModelView > unionBases;
+  vector< GraphModelView > degenerate;
+  vector< GraphModelView >::size_type i;
+  GraphModel::label pair[2];
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+      model.annotate ();
+      model.minimumCycleBasis (basis);
+      model.unionMinimumCycleBases (unionBases);
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+  check ("minimum cycle basis", basis);
+  check ("union of minimum cycle bases", unionBases);
+
+  // A single residue has no relation and a cycle of two residues has a
+  // single pair of relations.
+  pair[0] = 0;
+  pair[1] = 0;
+  for (i = 1; model.size () > i; ++i)
+    {
+      if (model.internalAreConnected (0, i))
+	{
+	  pair[1] = i;
+	  break;
+	}
+    }
+  degenerate.push_back (GraphModelView (model, pair, pair + 1));
+  degenerate.push_back (GraphModelView (model, pair, pair + 2));
+  degenerate.push_back (GraphModelView (model, pair, pair + 2, false));
+  for (i = 0; degenerate.size () > i; ++i)
+    {
+      gOut (0) << "degenerate " << degenerate[i].size ()
+	       << (1 < degenerate[i].size () ? " residues, " : " residue, ")
+	       << (degenerate[i].isCyclic () ? "cyclic, " : "open, ")
+	       << degenerate[i].edgeSize () << " edges: "
+	       << (roundTrip (degenerate[i]) ? "same" : "different") << endl;
+    }
+
+  return EXIT_SUCCESS;
+}
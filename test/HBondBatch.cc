@@ -0,0 +1,269 @@
+//                              -*- Mode: C++ -*-
+// HBondBatch.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:58:06 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "Atom.h"
+#include "AtomType.h"
+#include "Exception.h"
+#include "ExtendedResidue.h"
+#include "GraphModel.h"
+#include "HBond.h"
+#include "HBondBatch.h"
+#include "HBondSites.h"
+#include "Messagestream.h"
+#include "Pdbstream.h"
+#include "Residue.h"
+#include "ResidueType.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * A candidate hydrogen bond: a donor site and an acceptor site of two
+ * residues.
+ */
+struct Candidate
+{
+  const HBondSites::Site *donor;
+  const HBondSites::Site *acceptor;
+  const Residue *rd;
+  const Residue *ra;
+
+  Candidate (const HBondSites::Site *d, const HBondSites::Site *a, const Residue *r1, const Residue *r2)
+    : donor (d), acceptor (a), rd (r1), ra (r2)
+  { }
+};
+
+
+
+/**
+ * Tells if two sites of a residue pair are close enough for the pair to be
+ * scored.
+ */
+static bool
+isNear (const HBondSites &left, const HBondSites &right)
+{
+  HBondSites::const_iterator x;
+  HBondSites::const_iterator y;
+
+  for (x = left.begin (); left.end () != x; ++x)
+    {
+      for (y = right.begin (); right.end () != y; ++y)
+	{
+	  if (64 > x->heavy->squareDistance (*y->heavy))
+	    {
+	      return true;
+	    }
+	}
+    }
+  return false;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  const float tolerance = 1e-4;
+  GraphModel model;
+  vector< ExtendedResidue > thymines;
+  vector< const Residue* > residues;
+  vector< HBondSites > sites;
+  vector< Candidate > candidates;
+  vector< Candidate >::size_type c;
+  vector< const Residue* >::size_type i;
+  vector< const Residue* >::size_type j;
+  HBondSites::const_iterator x;
+  HBondSites::const_iterator y;
+  HBondBatch batch;
+  unsigned int methyls;
+  unsigned int methylsScored;
+  unsigned int methylBonds;
+  unsigned int far;
+  unsigned int farScored;
+  unsigned int nans;
+  unsigned int bonds;
+  unsigned int mismatches;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+      model.annotate ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+
+  // 1L8V is RNA: thymines laid over its uracils give C5M donors, paired
+  // with the residues near the uracil they replace.
+  for (i = 0; model.size () > i; ++i)
+    {
+      if (ResidueType::rRU == model[i].getType ())
+	{
+	  ExtendedResidue t (ResidueType::rDT, model[i].getResId ());
+
+	  t.setFullTheoretical ();
+	  t.addHydrogens ();
+	  t.addLonePairs ();
+	  t.setReferential (model[i].getReferential ());
+	  thymines.push_back (t);
+	}
+    }
+  for (i = 0; model.size () > i; ++i)
+    {
+      residues.push_back (&model[i]);
+    }
+  for (i = 0; thymines.size () > i; ++i)
+    {
+      residues.push_back (&thymines[i]);
+    }
+
+  // The candidates of the residue pairs with sites closer than 8
+  // angstroms, as the pairing annotation lists them.
+  for (i = 0; residues.size () > i; ++i)
+    {
+      sites.push_back (HBondSites (residues[i]));
+    }
+  for (i = 0; residues.size () > i; ++i)
+    {
+      for (j = i + 1; residues.size () > j; ++j)
+	{
+	  if (residues[i]->getResId () == residues[j]->getResId ())
+	    {
+	      continue;
+	    }
+	  if (isNear (sites[i], sites[j]))
+	    {
+	      for (x = sites[i].begin (); sites[i].end () != x; ++x)
+		{
+		  for (y = sites[j].begin (); sites[j].end () != y; ++y)
+		    {
+		      if (x->light->getType ()->isHydrogen () && y->light->getType ()->isLonePair ())
+			{
+			  candidates.push_back (Candidate (&*x, &*y, residues[i], residues[j]));
+			}
+		      else if (y->light->getType ()->isHydrogen () && x->light->getType ()->isLonePair ())
+			{
+			  candidates.push_back (Candidate (&*y, &*x, residues[j], residues[i]));
+			}
+		    }
+		}
+	    }
+	}
+    }
+
+  // The batch takes the C5M donors with the hydrogen of methylHydrogen
+  // when the acceptor is within 5 angstroms, as Relation::arePaired.
+  for (c = 0; candidates.size () > c; ++c)
+    {
+      const Candidate &cand = candidates[c];
+
+      if (AtomType::aC5M == cand.donor->heavy->getType ()
+	  && 25 >= cand.donor->heavy->squareDistance (*cand.acceptor->heavy))
+	{
+	  batch.push_back (*cand.donor->heavy,
+			   HBond::methylHydrogen (*cand.donor->heavy, *cand.acceptor->light,
+						  *cand.rd->safeFind (AtomType::aC5),
+						  *cand.ra->safeFind (AtomType::aC5)),
+			   *cand.acceptor->heavy, *cand.acceptor->light);
+	}
+      else
+	{
+	  batch.push_back (*cand.donor->heavy, *cand.donor->light, *cand.acceptor->heavy, *cand.acceptor->light);
+	}
+    }
+  batch.evalStatistically ();
+
+  methyls = methylsScored = methylBonds = far = farScored = nans = bonds = mismatches = 0;
+  for (c = 0; candidates.size () > c; ++c)
+    {
+      const Candidate &cand = candidates[c];
+      HBond h (cand.donor->heavy->getType (), cand.donor->light->getType (),
+	       cand.acceptor->heavy->getType (), cand.acceptor->light->getType ());
+      float scalar;
+      float batched;
+      bool isFar;
+
+      scalar = h.evalStatistically (cand.rd, cand.ra);
+      batched = batch.getValue (c);
+      isFar = 5 < cand.donor->heavy->distance (*cand.acceptor->heavy);
+      if (AtomType::aC5M == cand.donor->heavy->getType ())
+	{
+	  ++methyls;
+	  methylsScored += isFar ? 0 : 1;
+	}
+      if (isFar)
+	{
+	  ++far;
+	  farScored += 0 != batched ? 1 : 0;
+	}
+      if (isnan (scalar) || isnan (batched))
+	{
+	  nans += isnan (scalar) && isnan (batched) ? 1 : 0;
+	  mismatches += isnan (scalar) && isnan (batched) ? 0 : 1;
+	  continue;
+	}
+      bonds += 0.01 < scalar ? 1 : 0;
+      methylBonds += AtomType::aC5M == cand.donor->heavy->getType () && 0.01 < scalar ? 1 : 0;
+      if (tolerance < fabs (scalar - batched))
+	{
+	  ++mismatches;
+	}
+    }
+
+  gOut (0) << candidates.size () << " candidates, "
+	   << bonds << " scored above 0.01, "
+	   << nans << " unexplained by both" << endl;
+  gOut (0) << "C5M donors: " << methyls << ", "
+	   << methylsScored << " within 5 angstroms, "
+	   << methylBonds << " scored above 0.01" << endl;
+  gOut (0) << "beyond 5 angstroms: " << far << ", "
+	   << farScored << " scored by the batch" << endl;
+  gOut (0) << "batch and scalar scores "
+	   << (0 == mismatches ? "within" : "beyond")
+	   << " the tolerance" << endl;
+
+  return EXIT_SUCCESS;
+}
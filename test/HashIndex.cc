@@ -0,0 +1,192 @@
+//                              -*- Mode: C++ -*-
+// HashIndex.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 04:46:51 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <utility>
+
+#include "HashIndex.h"
+#include "Messagestream.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+typedef pair< int, int > Key;
+
+
+
+/**
+ * Hash function sending every key to one of four slots, so that the
+ * probe sequences are long and the erasures have entries to shift back.
+ */
+struct CollidingHash
+{
+  size_t operator() (const Key &k) const
+  {
+    return k.first & 3;
+  }
+};
+
+
+
+/**
+ * Tells if the index holds the same entries as the reference.
+ */
+template< class H >
+static bool
+same (const HashIndex< Key, int, H > &index, const map< Key, int > &reference, int range)
+{
+  map< Key, int >::const_iterator it;
+  const int *value;
+  int i;
+  int j;
+
+  if (index.size () != reference.size ())
+    {
+      return false;
+    }
+  for (i = 0; range > i; ++i)
+    {
+      for (j = 0; 4 > j; ++j)
+	{
+	  value = index.find (make_pair (i, j));
+	  it = reference.find (make_pair (i, j));
+	  if ((0 == value) != (reference.end () == it)
+	      || (0 != value && *value != it->second))
+	    {
+	      return false;
+	    }
+	}
+    }
+  return true;
+}
+
+
+
+/**
+ * Applies random insertions and erasures to the index and a map and
+ * checks after every operation that they agree.
+ */
+template< class H >
+static void
+randomOperations (const char *title, int range)
+{
+  HashIndex< Key, int, H > index;
+  map< Key, int > reference;
+  unsigned int seed;
+  unsigned int errors;
+  int i;
+
+  seed = 1;
+  errors = 0;
+  for (i = 0; 5000 > i; ++i)
+    {
+      Key k;
+
+      seed = seed * 1103515245 + 12345;
+      k = make_pair ((int) ((seed >> 8) % range), (int) ((seed >> 4) % 4));
+      if (0 == (seed >> 20) % 3)
+	{
+	  if (index.erase (k) != (0 != reference.erase (k)))
+	    {
+	      ++errors;
+	    }
+	}
+      else
+	{
+	  index.insert (k, i);
+	  reference[k] = i;
+	}
+      if (! same (index, reference, range))
+	{
+	  ++errors;
+	}
+    }
+  gOut (0) << title << ": " << index.size () << " entries, "
+	   << errors << " errors" << endl;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  HashIndex< Key, int, PairHash > index;
+  HashIndex< const void*, int, PointerHash > pointers;
+  int values[100];
+  const int *found;
+  int i;
+
+  gOut (0) << "empty: size " << index.size () << ", empty " << index.empty ()
+	   << ", find " << (0 == index.find (make_pair (1, 2)) ? "none" : "found")
+	   << ", erase " << index.erase (make_pair (1, 2)) << endl;
+
+  index.insert (make_pair (1, 2), 12);
+  index.insert (make_pair (2, 1), 21);
+  index.insert (make_pair (1, 2), 120);
+  found = index.find (make_pair (1, 2));
+  gOut (0) << "insert (1, 2) twice: size " << index.size ()
+	   << ", value " << (0 == found ? -1 : *found) << endl;
+  found = index.find (make_pair (2, 1));
+  gOut (0) << "find (2, 1): " << (0 == found ? -1 : *found) << endl;
+  gOut (0) << "erase (1, 2): " << index.erase (make_pair (1, 2))
+	   << ", again " << index.erase (make_pair (1, 2))
+	   << ", size " << index.size () << endl;
+
+  index.reserve (1000);
+  for (i = 0; 1000 > i; ++i)
+    {
+      index.insert (make_pair (i, -i), i);
+    }
+  for (i = 0; 1000 > i; i += 2)
+    {
+      index.erase (make_pair (i, -i));
+    }
+  found = index.find (make_pair (999, -999));
+  gOut (0) << "1000 inserted, 500 erased: size " << index.size ()
+	   << ", (998, -998) " << (0 == index.find (make_pair (998, -998)) ? "none" : "found")
+	   << ", (999, -999) " << (0 == found ? -1 : *found) << endl;
+  index.clear ();
+  gOut (0) << "clear: size " << index.size () << ", empty " << index.empty ()
+	   << ", find " << (0 == index.find (make_pair (2, 1)) ? "none" : "found") << endl;
+
+  for (i = 0; 100 > i; ++i)
+    {
+      pointers.insert (values + i, i);
+    }
+  for (i = 0; 100 > i && 0 != (found = pointers.find (values + i)) && i == *found; ++i);
+  gOut (0) << "pointers: size " << pointers.size () << ", " << i << " found" << endl;
+
+  randomOperations< PairHash > ("random operations", 50);
+  randomOperations< CollidingHash > ("colliding random operations", 50);
+
+  return EXIT_SUCCESS;
+}
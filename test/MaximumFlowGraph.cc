@@ -0,0 +1,207 @@
+//                              -*- Mode: C++ -*-
+// MaximumFlowGraph.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 04:21:33 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "FixedMaximumFlowGraph.h"
+#include "HBond.h"
+#include "MaximumFlowGraph.h"
+#include "Messagestream.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+typedef MaximumFlowGraph< int, HBond > FlowGraph;
+
+typedef FixedMaximumFlowGraph< HBond > FixedFlowGraph;
+
+
+
+/**
+ * The state of the pseudo random generator.
+ */
+static unsigned int seed = 1;
+
+
+
+/**
+ * Draws a pseudo random number.
+ * @param n the number of values.
+ * @return a number between 0 and n - 1.
+ */
+static unsigned int
+draw (unsigned int n)
+{
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 8) % n;
+}
+
+
+
+/**
+ * Draws an edge capacity, often from a few values so that the pushes
+ * meet ties.
+ */
+static float
+capacity ()
+{
+  const float values[] = { 0.25, 0.5, 1 };
+
+  return (0 == draw (2)
+	  ? values[draw (3)]
+	  : (1 + draw (1000)) / 1000.0f);
+}
+
+
+
+/**
+ * Solves the network given as (head, tail, capacity) edges with both
+ * implementations.  Vertex 0 is the source and vertex 1 the sink.
+ * @param vertices the number of vertices.
+ * @param edges the edges.
+ * @param total the sum of the flows into the sink, increased.
+ * @return whether every edge has exactly the same flow.
+ */
+static bool
+solve (unsigned int vertices, const vector< pair< pair< int, int >, float > > &edges, float &total)
+{
+  FlowGraph graph;
+  FixedFlowGraph fixed (vertices);
+  vector< pair< pair< int, int >, float > >::size_type e;
+  int v;
+  bool same;
+
+  for (v = 0; (int) vertices > v; ++v)
+    {
+      graph.insert (v);
+      fixed.insert ();
+    }
+  for (e = 0; edges.size () > e; ++e)
+    {
+      graph.internalConnect (edges[e].first.first, edges[e].first.second, HBond (edges[e].second), 0);
+      fixed.internalConnect (edges[e].first.first, edges[e].first.second, HBond (edges[e].second), 0);
+    }
+  graph.preFlowPush (0, 1);
+  fixed.preFlowPush (0, 1);
+  for (same = true, e = 0; edges.size () > e; ++e)
+    {
+      float flow = graph.internalGetEdgeWeight (edges[e].first.first, edges[e].first.second);
+
+      same = same && flow == fixed.internalGetEdgeWeight (e);
+      if (1 == edges[e].first.second)
+	{
+	  total += flow;
+	}
+    }
+  return same;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int networks;
+  unsigned int edgeCount;
+  unsigned int different;
+  unsigned int n;
+  float total;
+
+  // Hydrogen bond networks: donors fed by the source, acceptors draining
+  // to the sink and bonds in between, as in Relation::arePaired.
+  edgeCount = different = 0;
+  total = 0;
+  for (networks = 0; 500 > networks; ++networks)
+    {
+      vector< pair< pair< int, int >, float > > edges;
+      unsigned int donors = 1 + draw (4);
+      unsigned int acceptors = 1 + draw (4);
+      unsigned int d;
+      unsigned int a;
+
+      for (d = 0; donors > d; ++d)
+	{
+	  edges.push_back (make_pair (make_pair (0, 2 + d), 1.0f));
+	}
+      for (a = 0; acceptors > a; ++a)
+	{
+	  edges.push_back (make_pair (make_pair (2 + donors + a, 1), 1.0f));
+	}
+      for (d = 0; donors > d; ++d)
+	{
+	  for (a = 0; acceptors > a; ++a)
+	    {
+	      if (0 != draw (3))
+		{
+		  edges.push_back (make_pair (make_pair (2 + d, 2 + donors + a), capacity ()));
+		}
+	    }
+	}
+      edgeCount += edges.size ();
+      different += solve (2 + donors + acceptors, edges, total) ? 0 : 1;
+    }
+  gOut (0) << "hydrogen bond networks: " << networks << " networks, "
+	   << edgeCount << " edges, " << different << " with different flows, "
+	   << (0 < total ? "some flow" : "no flow") << endl;
+
+  // Random networks, with edges in both directions between some vertices.
+  edgeCount = different = 0;
+  total = 0;
+  for (networks = 0; 500 > networks; ++networks)
+    {
+      vector< pair< pair< int, int >, float > > edges;
+      vector< bool > used;
+      unsigned int vertices = 3 + draw (8);
+      unsigned int h;
+      unsigned int t;
+
+      used.assign (vertices * vertices, false);
+      for (n = 3 * vertices; 0 < n; --n)
+	{
+	  h = draw (vertices);
+	  t = draw (vertices);
+	  if (h != t && 1 != h && 0 != t && ! used[h * vertices + t])
+	    {
+	      used[h * vertices + t] = true;
+	      edges.push_back (make_pair (make_pair ((int) h, (int) t), capacity ()));
+	    }
+	}
+      edgeCount += edges.size ();
+      different += solve (vertices, edges, total) ? 0 : 1;
+    }
+  gOut (0) << "random networks: " << networks << " networks, "
+	   << edgeCount << " edges, " << different << " with different flows, "
+	   << (0 < total ? "some flow" : "no flow") << endl;
+
+  return EXIT_SUCCESS;
+}
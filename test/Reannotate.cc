@@ -0,0 +1,144 @@
+//                              -*- Mode: C++ -*-
+// Reannotate.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:55:07 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "AnnotationCache.h"
+#include "Exception.h"
+#include "GraphModel.h"
+#include "HomogeneousTransfo.h"
+#include "Messagestream.h"
+#include "Model.h"
+#include "Pdbstream.h"
+#include "Relation.h"
+#include "Residue.h"
+#include "Vector3D.h"
+#include "RelationDescription.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Moves a few residues of the model: small rotations and translations that
+ * keep most contacts, a residue stacked over another one and a residue
+ * moved away from the others.
+ */
+static void
+move (GraphModel &model, vector< GraphModel::label > &changed)
+{
+  model[10].transform (HomogeneousTransfo::rotation (Vector3D (0, 0, 1), 0.2));
+  model[11].transform (HomogeneousTransfo::translation (0.5, -0.3, 0.2));
+  model[150].transform (model[200].getReferential ()
+			* model[150].getReferential ().invert ()
+			* HomogeneousTransfo::translation (0, 0, 3.4));
+  model[400].transform (HomogeneousTransfo::translation (20, 0, 0));
+  model[555].transform (HomogeneousTransfo::translation (1, 1, 1));
+  changed.push_back (10);
+  changed.push_back (11);
+  changed.push_back (150);
+  changed.push_back (400);
+  changed.push_back (555);
+  // Invalid labels are ignored.
+  changed.push_back (100000);
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  const unsigned char all = Relation::adjacent_mask | Relation::pairing_mask | Relation::stacking_mask | Relation::bhbond_mask;
+  const unsigned char masks[] = { all, Relation::pairing_mask | Relation::fast_mask, Relation::adjacent_mask | Relation::stacking_mask };
+  const char *names[] = { "all", "fast pairing", "adjacent and stacking" };
+  Model model;
+  Model::iterator it;
+  unsigned int conformer;
+  unsigned int mask;
+  int cached;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+  // The cache needs conformers, moving a residue rigidly keeps its one.
+  for (it = model.begin (), conformer = 1; model.end () != it; ++it, ++conformer)
+    {
+      it->setConformer (conformer);
+    }
+
+  for (mask = 0; 3 > mask; ++mask)
+    {
+      for (cached = 0; 2 > cached; ++cached)
+	{
+	  AnnotationCache cache;
+	  GraphModel graph (model);
+	  GraphModel::size_type before;
+	  vector< GraphModel::label > changed;
+
+	  if (cached)
+	    {
+	      graph.setAnnotationCache (&cache);
+	    }
+	  graph.annotate (masks[mask]);
+	  before = graph.edgeSize ();
+	  move (graph, changed);
+
+	  GraphModel full (graph);
+
+	  full.setAnnotationCache (0);
+	  full.reannotate (masks[mask]);
+	  graph.reannotate (changed, masks[mask]);
+	  gOut (0) << names[mask] << (cached ? ", cached" : "")
+		   << ": " << before << " relations, "
+		   << graph.edgeSize () << " after the incremental reannotation, "
+		   << full.edgeSize () << " after the full one, "
+		   << (describe (graph) == describe (full) ? "same" : "different")
+		   << endl;
+	}
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+//                              -*- Mode: C++ -*-
+// RelationDescription.h
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 07:40:12 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef _mccore_test_RelationDescription_h_
+#define _mccore_test_RelationDescription_h_
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "GraphModel.h"
+#include "PropertyType.h"
+#include "Relation.h"
+#include "Residue.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Describes the relations of a model, one sorted string per relation
+ * holding the residue ids, the faces, the flow sum, the labels and the
+ * H-bond flows.
+ */
+inline vector< string >
+describe (const GraphModel &model)
+{
+  vector< string > relations;
+  GraphModel::edge_const_iterator it;
+
+  for (it = model.edge_begin (); model.edge_end () != it; ++it)
+    {
+      const Relation *rel = *it;
+      set< string > labels;
+      set< const PropertyType* >::const_iterator lit;
+      set< string >::iterator sit;
+      ostringstream oss;
+      unsigned int i;
+
+      for (lit = rel->getLabels ().begin (); rel->getLabels ().end () != lit; ++lit)
+	{
+	  labels.insert ((*lit)->toString ());
+	}
+      oss << rel->getRef ()->getResId () << "-" << rel->getRes ()->getResId ()
+	  << " " << rel->getRefFace () << " " << rel->getResFace ()
+	  << " " << rel->getFlowSum ();
+      for (sit = labels.begin (); labels.end () != sit; ++sit)
+	{
+	  oss << " " << *sit;
+	}
+      for (i = 0; rel->getHBondFlows ().size () > i; ++i)
+	{
+	  oss << " " << rel->getHBondFlows ()[i].hbond << ":" << rel->getHBondFlows ()[i].flow;
+	}
+      relations.push_back (oss.str ());
+    }
+  sort (relations.begin (), relations.end ());
+  return relations;
+}
+
+#endif
@@ -0,0 +1,176 @@
+//                              -*- Mode: C++ -*-
+// RelationTransfo.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 07:41:26 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Binstream.h"
+#include "Exception.h"
+#include "GraphModel.h"
+#include "Messagestream.h"
+#include "Pdbstream.h"
+#include "Relation.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+static string
+slurp (const char *filename)
+{
+  ifstream ifs (filename);
+  ostringstream oss;
+
+  oss << ifs.rdbuf ();
+  return oss.str ();
+}
+
+
+
+/**
+ * Writes the model to a binary file, with or without the relation
+ * transformations.
+ */
+static void
+save (const char *filename, const GraphModel &model, bool transfos)
+{
+  ofBinstream obs (filename);
+
+  model.output (obs, transfos);
+}
+
+
+
+/**
+ * Tells if two transformations have the same coefficients.
+ */
+static bool
+same (const HomogeneousTransfo &left, const HomogeneousTransfo &right)
+{
+  unsigned int i;
+  unsigned int j;
+
+  for (i = 0; 3 > i; ++i)
+    {
+      for (j = 0; 4 > j; ++j)
+	{
+	  if (left.elementAt (i, j) != right.elementAt (i, j))
+	    {
+	      return false;
+	    }
+	}
+    }
+  return true;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  GraphModel model;
+  GraphModel back;
+  GraphModel::edge_const_iterator eit;
+  unsigned int computed;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+  model.annotate ();
+
+  // Without the transformations, a relation loses 31 of its 32 floats.
+  save ("RelationTransfo.full.bin", model, true);
+  save ("RelationTransfo.bare.bin", model, false);
+  gOut (0) << model.edgeSize () << " relations, "
+	   << slurp ("RelationTransfo.full.bin").size ()
+	   - slurp ("RelationTransfo.bare.bin").size ()
+	   << " bytes saved without the transformations" << endl;
+
+  // Read back, the transformations are computed again from the residues.
+  {
+    ifBinstream ibs ("RelationTransfo.bare.bin");
+
+    ibs >> back;
+  }
+  save ("RelationTransfo.back.bin", back, true);
+  gOut (0) << "read without transformations: " << back.edgeSize () << " relations, "
+	   << (slurp ("RelationTransfo.full.bin") == slurp ("RelationTransfo.back.bin")
+	       ? "same" : "different")
+	   << " binary image" << endl;
+  {
+    ifBinstream ibs ("RelationTransfo.full.bin");
+
+    ibs >> back;
+  }
+  save ("RelationTransfo.back.bin", back, true);
+  gOut (0) << "read with transformations: " << back.edgeSize () << " relations, "
+	   << (slurp ("RelationTransfo.full.bin") == slurp ("RelationTransfo.back.bin")
+	       ? "same" : "different")
+	   << " binary image" << endl;
+
+  // Copies and dropped transformations give the computed ones back.
+  computed = 0;
+  for (eit = model.edge_begin (); model.edge_end () != eit; ++eit)
+    {
+      Relation copy (**eit);
+      HomogeneousTransfo tfo = (*eit)->getTransfo ();
+      HomogeneousTransfo po4 = (*eit)->getPhosphateTransfo ();
+
+      if (same (tfo, copy.getTransfo ()) && same (po4, copy.getPhosphateTransfo ()))
+	{
+	  copy.dropTransfos ();
+	  if (same (tfo, copy.getTransfo ()) && same (po4, copy.getPhosphateTransfo ()))
+	    {
+	      ++computed;
+	    }
+	}
+    }
+  gOut (0) << "copied and dropped: " << computed << " of " << model.edgeSize ()
+	   << " relations with the same transformations" << endl;
+
+  return EXIT_SUCCESS;
+}
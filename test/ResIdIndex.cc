@@ -0,0 +1,147 @@
+//                              -*- Mode: C++ -*-
+// ResIdIndex.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 07:05:12 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "Exception.h"
+#include "GraphModel.h"
+#include "Messagestream.h"
+#include "Model.h"
+#include "Pdbstream.h"
+#include "ResId.h"
+#include "Residue.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Looks up an id with find, safeFind and findRange and writes what was
+ * found.
+ */
+static void
+check (const char *title, const AbstractModel &model, const ResId &id)
+{
+  AbstractModel::const_iterator it;
+  vector< AbstractModel::const_iterator > range;
+  bool safe;
+
+  it = model.find (id);
+  try
+    {
+      model.safeFind (id);
+      safe = true;
+    }
+  catch (NoSuchElementException &ex)
+    {
+      safe = false;
+    }
+  model.findRange (id.getChainId (), id.getResNo (), id.getResNo (), range);
+  gOut (0) << title << " " << id << ": find ";
+  if (model.end () == it)
+    {
+      gOut (0) << "missing";
+    }
+  else
+    {
+      gOut (0) << "at " << it - model.begin ();
+    }
+  gOut (0) << ", safeFind " << (safe ? "found" : "missing")
+	   << ", findRange " << range.size () << endl;
+}
+
+
+
+/**
+ * Renames the first and the last residues of a model in place.  The
+ * renamed ids are found once the model is reindexed.
+ */
+static void
+rename (const char *title, AbstractModel &model)
+{
+  ResId first = model.begin ()->getResId ();
+  ResId last = model[model.size () - 1].getResId ();
+  ResId renamed ('Z', 999);
+
+  gOut (0) << title << ": " << model.size () << " residues" << endl;
+  check ("  indexed", model, first);
+  check ("  absent", model, renamed);
+
+  model.begin ()->setResId (renamed);
+  check ("  renamed", model, renamed);
+  check ("  old", model, first);
+  model.reindex ();
+  check ("  reindexed renamed", model, renamed);
+
+  // Swapping two ids leaves every index entry pointing to a residue.
+  model[model.size () - 1].setResId (first);
+  model.begin ()->setResId (last);
+  check ("  swapped first", model, first);
+  check ("  swapped last", model, last);
+
+  model.reindex ();
+  check ("  reindexed first", model, first);
+  check ("  reindexed last", model, last);
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  Model model;
+  GraphModel graph;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+  graph = GraphModel (model);
+
+  rename ("Model", model);
+  rename ("GraphModel", graph);
+
+  return EXIT_SUCCESS;
+}
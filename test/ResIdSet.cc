@@ -0,0 +1,291 @@
+//                              -*- Mode: C++ -*-
+// ResIdSet.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 04:46:51 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Binstream.h"
+#include "Exception.h"
+#include "Messagestream.h"
+#include "ResId.h"
+#include "ResIdSet.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Writes the ids of the set one by one.
+ */
+static void
+dump (const char *title, const ResIdSet &set)
+{
+  ResIdSet::const_iterator it;
+
+  gOut (0) << title << " (" << set.size () << "): " << set << endl << "   ";
+  for (it = set.begin (); set.end () != it; ++it)
+    {
+      gOut (0) << " " << *it;
+    }
+  gOut (0) << endl;
+}
+
+
+
+/**
+ * Tells if the set holds the same ids as the reference, in the same order.
+ */
+static bool
+same (const ResIdSet &set, const std::set< ResId > &reference)
+{
+  ResIdSet::const_iterator it;
+  std::set< ResId >::const_iterator rit;
+
+  if (set.size () != reference.size ())
+    {
+      return false;
+    }
+  for (it = set.begin (), rit = reference.begin (); set.end () != it; ++it, ++rit)
+    {
+      if (*it != *rit)
+	{
+	  return false;
+	}
+    }
+  return true;
+}
+
+
+
+static string
+slurp (const char *filename)
+{
+  ifstream ifs (filename);
+  ostringstream oss;
+
+  oss << ifs.rdbuf ();
+  return oss.str ();
+}
+
+
+
+/**
+ * Tells if the sets are equal, the ResIdSet being passed where a
+ * set< ResId > is expected.
+ */
+static bool
+sameAsSet (const std::set< ResId > &set, const std::set< ResId > &reference)
+{
+  return set == reference;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  const char *ranges[] = { "A1-A5,A7,B3-B4", "A10", "B2,A1-A3,A2-A6,A3", 0 };
+  const char **range;
+  ResIdSet set;
+  ResIdSet other;
+  std::set< ResId > reference;
+  std::set< ResId >::const_iterator rit;
+  unsigned int seed;
+  int i;
+  bool inserted;
+
+  // Parsing and formatting round-trips.
+  for (range = ranges; 0 != *range; ++range)
+    {
+      ostringstream oss;
+
+      set = ResIdSet (*range);
+      oss << set;
+      other = ResIdSet (oss.str ().c_str ());
+      dump (*range, set);
+      gOut (0) << "round-trip " << (set == other ? "ok" : "failed") << endl;
+    }
+  try
+    {
+      set = ResIdSet ("A5-A3");
+      gOut (0) << "A5-A3 parsed" << endl;
+    }
+  catch (IntLibException &ex)
+    {
+      gOut (0) << "A5-A3 rejected" << endl;
+    }
+
+  // Insertion codes sort after the plain id and stay out of the ranges.
+  set = ResIdSet ("A4-A6");
+  set.insert (ResId ('A', 5, 'b'));
+  set.insert (ResId ('A', 5, 'a'));
+  set.insert (ResId ('A', 7, 'a'));
+  dump ("insertion codes", set);
+  gOut (0) << "contains A5.a " << (set.end () != set.find (ResId ('A', 5, 'a')))
+	   << ", A5.c " << (set.end () != set.find (ResId ('A', 5, 'c')))
+	   << ", A7 " << (set.end () != set.find (ResId ('A', 7))) << endl;
+  set.erase (ResId ('A', 5, 'a'));
+  set.erase (ResId ('A', 5));
+  dump ("erase A5.a and A5", set);
+
+  // Residue numbers spreading beyond maxSpan in a single chain.
+  set = ResIdSet ("A1-A3");
+  set.insert (ResId ('A', 2 * ResIdSet::maxSpan));
+  set.insert (ResId ('A', -(int) ResIdSet::maxSpan));
+  set.insert (ResId ('A', ResIdSet::maxSpan - 1));
+  dump ("outside maxSpan", set);
+  gOut (0) << "contains far " << (set.end () != set.find (ResId ('A', 2 * ResIdSet::maxSpan)))
+	   << ", far + 1 " << (set.end () != set.find (ResId ('A', 2 * ResIdSet::maxSpan + 1)))
+	   << endl;
+  other = ResIdSet ("A2-A4");
+  other.insert (ResId ('A', 2 * ResIdSet::maxSpan));
+  dump ("union", set | other);
+  dump ("intersection", set & other);
+  dump ("difference", set - other);
+
+  // Random insertions and erasures against a set of ResId.
+  set.clear ();
+  seed = 1;
+  inserted = true;
+  for (i = 0; 20000 > i; ++i)
+    {
+      ResId id;
+      int no;
+
+      seed = seed * 1103515245 + 12345;
+      no = (int) (seed >> 8) % 200 - 50;
+      if (0 == (seed >> 4) % 7)
+	{
+	  no *= ResIdSet::maxSpan;
+	}
+      id = ResId ("ABC"[(seed >> 16) % 3], no, 0 == (seed >> 12) % 5 ? 'a' : ' ');
+      if (0 == (seed >> 20) % 3)
+	{
+	  set.erase (id);
+	  reference.erase (id);
+	}
+      else
+	{
+	  pair< ResIdSet::const_iterator, bool > done = set.insert (id);
+
+	  if (done.second != reference.insert (id).second
+	      || set.end () == done.first
+	      || id != *done.first)
+	    {
+	      inserted = false;
+	    }
+	}
+    }
+  gOut (0) << "random operations " << (same (set, reference) ? "ok" : "failed") << endl;
+  gOut (0) << "insert results " << (inserted ? "ok" : "failed") << endl;
+
+  // The set< ResId > interface.
+  {
+    ResIdSet::const_iterator it;
+    std::set< ResId >::const_reverse_iterator rrit;
+    ResIdSet saved;
+    bool ok;
+
+    for (ok = true, i = 0; 2000 > i && ok; ++i)
+      {
+	ResId id;
+
+	seed = seed * 1103515245 + 12345;
+	id = ResId ("@ABCD"[(seed >> 16) % 5],
+		    (int) (seed >> 8) % 220 - 60,
+		    0 == (seed >> 12) % 4 ? 'a' : ' ');
+	it = set.lower_bound (id);
+	rit = reference.lower_bound (id);
+	ok = (set.end () == it) == (reference.end () == rit) && (set.end () == it || *it == *rit);
+	it = set.upper_bound (id);
+	rit = reference.upper_bound (id);
+	ok = ok && (set.end () == it) == (reference.end () == rit) && (set.end () == it || *it == *rit);
+	ok = ok && set.equal_range (id).first == set.lower_bound (id);
+      }
+    gOut (0) << "bounds " << (ok ? "ok" : "failed") << endl;
+
+    for (ok = true, it = set.end (), rrit = reference.rbegin (); set.begin () != it && ok; ++rrit)
+      {
+	--it;
+	ok = reference.rend () != rrit && *it == *rrit;
+      }
+    gOut (0) << "backward iteration " << (ok && reference.rend () == rrit ? "ok" : "failed") << endl;
+
+    other = set;
+    other.erase (other.lower_bound (ResId ('B', 0)), other.lower_bound (ResId ('C', 0)));
+    reference.erase (reference.lower_bound (ResId ('B', 0)), reference.lower_bound (ResId ('C', 0)));
+    other.erase (other.begin ());
+    reference.erase (reference.begin ());
+    other.insert (other.begin (), ResId ('B', 7));
+    reference.insert (reference.begin (), ResId ('B', 7));
+    gOut (0) << "erase and insert " << (same (other, reference) ? "ok" : "failed") << endl;
+
+    gOut (0) << "conversion " << (same (other, reference) && sameAsSet (other, reference) ? "ok" : "failed") << endl;
+
+    saved = set;
+    other.swap (set);
+    gOut (0) << "swap " << (same (set, reference) && saved == other ? "ok" : "failed") << endl;
+    other.swap (set);
+    reference.clear ();
+    reference.insert (set.begin (), set.end ());
+  }
+
+  // The binary format is the size followed by the ids in order, as
+  // written from a set of ResId.
+  {
+    ofBinstream obs ("ResIdSet.bin");
+
+    obs << set;
+  }
+  {
+    ofBinstream obs ("ResIdSet.ref.bin");
+
+    obs << (bin_ui64) reference.size ();
+    for (rit = reference.begin (); reference.end () != rit; ++rit)
+      {
+	obs << *rit;
+      }
+  }
+  gOut (0) << "binary output "
+	   << (slurp ("ResIdSet.bin") == slurp ("ResIdSet.ref.bin") ? "ok" : "failed")
+	   << endl;
+  {
+    ifBinstream ibs ("ResIdSet.ref.bin");
+
+    ibs >> other;
+  }
+  gOut (0) << "binary input " << (other == set ? "ok" : "failed") << endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+//                              -*- Mode: C++ -*-
+// SharedRelations.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 08:24:10 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Binstream.h"
+#include "Exception.h"
+#include "GraphModel.h"
+#include "InvertedRelation.h"
+#include "Messagestream.h"
+#include "Pdbstream.h"
+#include "Relation.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+static string
+slurp (const char *filename)
+{
+  ifstream ifs (filename);
+  ostringstream oss;
+
+  oss << ifs.rdbuf ();
+  return oss.str ();
+}
+
+
+
+/**
+ * Counts the relations of a model served by an InvertedRelation.
+ */
+static unsigned int
+countViews (const GraphModel &model)
+{
+  GraphModel::edge_const_iterator eit;
+  unsigned int count = 0;
+
+  for (eit = model.edge_begin (); model.edge_end () != eit; ++eit)
+    {
+      if (0 != dynamic_cast< const InvertedRelation* > (*eit))
+	{
+	  ++count;
+	}
+    }
+  return count;
+}
+
+
+
+/**
+ * Tells if the relations of both models hold the same annotation, in the
+ * same order.
+ */
+static bool
+sameRelations (const GraphModel &left, const GraphModel &right)
+{
+  GraphModel::edge_const_iterator lit;
+  GraphModel::edge_const_iterator rit;
+
+  if (left.edgeSize () != right.edgeSize ())
+    {
+      return false;
+    }
+  for (lit = left.edge_begin (), rit = right.edge_begin (); left.edge_end () != lit; ++lit, ++rit)
+    {
+      const Relation &l = **lit;
+      const Relation &r = **rit;
+
+      if (l.getRef ()->getResId () != r.getRef ()->getResId ()
+	  || l.getRes ()->getResId () != r.getRes ()->getResId ()
+	  || l.getRefFace () != r.getRefFace ()
+	  || l.getResFace () != r.getResFace ()
+	  || l.getLabelBits () != r.getLabelBits ()
+	  || &l.getLabels () != &r.getLabels ()
+	  || l.getAnnotationType () != r.getAnnotationType ()
+	  || l.getFlowSum () != r.getFlowSum ()
+	  || l.getHBondFlows ().size () != r.getHBondFlows ().size ()
+	  || l.getPairedFaces () != r.getPairedFaces ())
+	{
+	  return false;
+	}
+    }
+  return true;
+}
+
+
+
+/**
+ * Writes the model to a binary file.
+ */
+static void
+save (const char *filename, const GraphModel &model)
+{
+  ofBinstream obs (filename);
+
+  obs << model;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  GraphModel model;
+  GraphModel shared;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+  shared = model;
+  shared.setSharedRelations (true);
+  model.annotate ();
+  shared.annotate ();
+
+  gOut (0) << "default: " << model.edgeSize () << " relations, "
+	   << countViews (model) << " views" << endl;
+  gOut (0) << "shared: " << shared.edgeSize () << " relations, "
+	   << countViews (shared) << " views, "
+	   << (sameRelations (model, shared) ? "same" : "different") << " annotation" << endl;
+
+  save ("SharedRelations.default.bin", model);
+  save ("SharedRelations.shared.bin", shared);
+  gOut (0) << "binary image: "
+	   << (slurp ("SharedRelations.default.bin") == slurp ("SharedRelations.shared.bin")
+	       ? "same" : "different") << endl;
+
+  // Copies keep the views over their own forward relations.
+  {
+    GraphModel copy (shared);
+
+    gOut (0) << "copy: " << copy.edgeSize () << " relations, "
+	     << countViews (copy) << " views, "
+	     << (sameRelations (model, copy) ? "same" : "different") << " annotation" << endl;
+  }
+
+  // Clones of a view are independent relations.
+  {
+    GraphModel::edge_const_iterator eit;
+    unsigned int same = 0;
+
+    for (eit = shared.edge_begin (); shared.edge_end () != eit; ++eit)
+      {
+	Relation *clone = (*eit)->clone ();
+
+	if (0 == dynamic_cast< InvertedRelation* > (clone)
+	    && clone->getLabelBits () == (*eit)->getLabelBits ()
+	    && clone->getPairedFaces () == (*eit)->getPairedFaces ()
+	    && clone->getHBondFlows ().size () == (*eit)->getHBondFlows ().size ())
+	  {
+	    ++same;
+	  }
+	delete clone;
+      }
+    gOut (0) << "clones: " << same << " of " << shared.edgeSize ()
+	     << " independent with the same annotation" << endl;
+  }
+
+  // Moving residues reannotates both directions.
+  {
+    vector< GraphModel::label > changed;
+
+    changed.push_back (10);
+    changed.push_back (200);
+    model.reannotate (changed);
+    shared.reannotate (changed);
+    gOut (0) << "reannotated: " << shared.edgeSize () << " relations, "
+	     << countViews (shared) << " views, "
+	     << (sameRelations (model, shared) ? "same" : "different") << " annotation" << endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,333 @@
+//                              -*- Mode: C++ -*-
+// ShortCycles.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 02:04:51 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "Exception.h"
+#include "GraphModel.h"
+#include "Messagestream.h"
+#include "Path.h"
+#include "Pdbstream.h"
+#include "PropertyType.h"
+#include "Relation.h"
+#include "Residue.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+typedef vector< GraphModel::label > Cycle;
+
+
+
+/**
+ * Puts a cycle in canonical form: it starts at its lowest label and goes
+ * towards the lowest of its two neighbors.
+ */
+static Cycle
+canonical (const Cycle &cycle)
+{
+  Cycle result (cycle);
+
+  rotate (result.begin (), min_element (result.begin (), result.end ()), result.end ());
+  if (result.back () < result[1])
+    {
+      reverse (result.begin () + 1, result.end ());
+    }
+  return result;
+}
+
+
+
+/**
+ * Collects the visited cycles in canonical form.
+ */
+class Collector : public GraphModel::CycleVisitor
+{
+public:
+
+  set< Cycle > cycles;
+
+  unsigned int visits;
+
+  Collector () : visits (0) { }
+
+  virtual bool visit (const Path< GraphModel::label, GraphModel::size_type > &cycle)
+  {
+    ++visits;
+    cycles.insert (canonical (cycle));
+    return true;
+  }
+};
+
+
+
+/**
+ * Tells if a relation has one of the types, every relation matching if
+ * there is none.
+ */
+static bool
+isFollowed (const Relation &rel, const set< const PropertyType* > &types)
+{
+  set< const PropertyType* >::const_iterator it;
+
+  for (it = types.begin (); types.end () != it; ++it)
+    {
+      if (rel.is (*it))
+	{
+	  return true;
+	}
+    }
+  return types.empty ();
+}
+
+
+
+/**
+ * Enumerates by brute force the cycles of at most maxLength residues whose
+ * consecutive residues have a relation of one of the types in either
+ * direction.
+ */
+static void
+bruteForce (const GraphModel &model, unsigned int maxLength, const set< const PropertyType* > &types, set< Cycle > &cycles)
+{
+  vector< vector< GraphModel::label > > neighbors (model.size ());
+  GraphModel::label h;
+  GraphModel::label t;
+  GraphModel::label start;
+  Cycle path;
+  vector< size_t > next;
+
+  for (h = 0; model.size () > h; ++h)
+    {
+      for (t = 0; model.size () > t; ++t)
+	{
+	  if (h != t
+	      && ((model.internalAreConnected (h, t) && isFollowed (*model.internalGetEdge (h, t), types))
+		  || (model.internalAreConnected (t, h) && isFollowed (*model.internalGetEdge (t, h), types))))
+	    {
+	      neighbors[h].push_back (t);
+	    }
+	}
+    }
+
+  // Depth first search of the simple paths from each start going through
+  // greater labels only.
+  for (start = 0; model.size () > start; ++start)
+    {
+      path.assign (1, start);
+      next.assign (1, 0);
+      while (! path.empty ())
+	{
+	  const vector< GraphModel::label > &adj = neighbors[path.back ()];
+
+	  if (adj.size () == next.back ())
+	    {
+	      path.pop_back ();
+	      next.pop_back ();
+	      continue;
+	    }
+	  t = adj[next.back ()++];
+	  if (start == t && 3 <= path.size ())
+	    {
+	      cycles.insert (canonical (path));
+	    }
+	  else if (start < t
+		   && maxLength > path.size ()
+		   && path.end () == find (path.begin (), path.end (), t))
+	    {
+	      path.push_back (t);
+	      next.push_back (0);
+	    }
+	}
+    }
+}
+
+
+
+/**
+ * Tells if the cycle goes through the residue pair.
+ */
+static bool
+hasEdge (const Cycle &cycle, GraphModel::label h, GraphModel::label t)
+{
+  size_t i;
+
+  for (i = 0; cycle.size () > i; ++i)
+    {
+      GraphModel::label a = cycle[i];
+      GraphModel::label b = cycle[(i + 1) % cycle.size ()];
+
+      if ((a == h && b == t) || (a == t && b == h))
+	{
+	  return true;
+	}
+    }
+  return false;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  const unsigned int maxLength = 6;
+  const PropertyType *filters[][2] = {
+    { 0, 0 },
+    { PropertyType::pAdjacent, PropertyType::pPairing },
+    { PropertyType::pAdjacent5p, PropertyType::pPairing },
+    { PropertyType::pAdjacent3p, PropertyType::pPairing },
+    { PropertyType::pStack, PropertyType::pAdjacent5p }
+  };
+  const char *names[] = { "all", "adjacent, pairing", "adjacent 5', pairing", "adjacent 3', pairing", "stack, adjacent 5'" };
+  GraphModel model;
+  GraphModel::edge_const_iterator eit;
+  unsigned int i;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+      model.annotate ();
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+
+  // Whole graph, filtered by relation types.
+  for (i = 0; 5 > i; ++i)
+    {
+      set< const PropertyType* > types;
+      set< Cycle > expected;
+      Collector collector;
+      GraphModel::size_type count;
+
+      if (0 != filters[i][0])
+	{
+	  types.insert (filters[i][0]);
+	}
+      if (0 != filters[i][1])
+	{
+	  types.insert (filters[i][1]);
+	}
+      count = (types.empty ()
+	       ? model.shortCycles (collector, maxLength)
+	       : model.shortCycles (collector, maxLength, types));
+      bruteForce (model, maxLength, types, expected);
+      gOut (0) << names[i] << ": " << count << " cycles, "
+	       << collector.visits << " visits, "
+	       << expected.size () << " by brute force, "
+	       << (collector.cycles == expected ? "same" : "different") << endl;
+    }
+
+  // Rooted at residues and at relations.
+  {
+    set< const PropertyType* > types;
+    set< Cycle > all;
+    set< Cycle > expected;
+    set< Cycle >::iterator cit;
+    vector< const Residue* > residues;
+    vector< const Relation* > relations;
+    vector< pair< GraphModel::label, GraphModel::label > > pairs;
+    Collector byResidue;
+    Collector byRelation;
+    Collector bounded;
+    GraphModel::size_type count;
+    size_t j;
+
+    types.insert (PropertyType::pAdjacent3p);
+    types.insert (PropertyType::pPairing);
+    bruteForce (model, maxLength, types, all);
+
+    residues.push_back (&model[10]);
+    residues.push_back (&model[150]);
+    residues.push_back (&model[300]);
+    count = model.shortCycles (residues, byResidue, maxLength, types);
+    for (cit = all.begin (); all.end () != cit; ++cit)
+      {
+	if (cit->end () != find (cit->begin (), cit->end (), 10)
+	    || cit->end () != find (cit->begin (), cit->end (), 150)
+	    || cit->end () != find (cit->begin (), cit->end (), 300))
+	  {
+	    expected.insert (*cit);
+	  }
+      }
+    gOut (0) << "rooted at residues: " << count << " cycles, "
+	     << expected.size () << " by brute force, "
+	     << (byResidue.cycles == expected ? "same" : "different") << endl;
+
+    // Pairings given in both directions and an adjacency given in its 5'
+    // direction, which is not one of the types.
+    for (eit = model.edge_begin (); model.edge_end () != eit && 8 > relations.size (); ++eit)
+      {
+	if ((*eit)->is (PropertyType::pPairing)
+	    || (2 == relations.size () && (*eit)->is (PropertyType::pAdjacent5p)))
+	  {
+	    relations.push_back (*eit);
+	    pairs.push_back (make_pair (model.getVertexLabel (const_cast< Residue* > ((*eit)->getRef ())),
+					model.getVertexLabel (const_cast< Residue* > ((*eit)->getRes ()))));
+	  }
+      }
+    count = model.shortCycles (relations, byRelation, maxLength, types);
+    expected.clear ();
+    for (cit = all.begin (); all.end () != cit; ++cit)
+      {
+	for (j = 0; pairs.size () > j; ++j)
+	  {
+	    if (hasEdge (*cit, pairs[j].first, pairs[j].second))
+	      {
+		expected.insert (*cit);
+	      }
+	  }
+      }
+    gOut (0) << "rooted at relations: " << count << " cycles, "
+	     << expected.size () << " by brute force, "
+	     << (byRelation.cycles == expected ? "same" : "different") << endl;
+
+    count = model.shortCycles (bounded, maxLength, types, 10);
+    gOut (0) << "bounded: " << count << " cycles, "
+	     << bounded.visits << " visits" << endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+//                              -*- Mode: C++ -*-
+// ThreadPool.cc
+// Author           : agent <agent@local>
+// Created On       : Mon Oct 19 03:41:17 2026
+// $Revision $
+//
+// This file is part of mccore.
+//
+// mccore is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// mccore is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with mccore; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+// cmake generated defines
+#include <config.h>
+
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "Exception.h"
+#include "GraphModel.h"
+#include "GraphModelView.h"
+#include "Messagestream.h"
+#include "Pdbstream.h"
+#include "ThreadPool.h"
+
+using namespace mccore;
+using namespace std;
+
+
+
+/**
+ * Tells if two lists of views go through the same residues in the same
+ * order.
+ */
+static bool
+same (const vector< GraphModelView > &left, const vector< GraphModelView > &right)
+{
+  vector< GraphModelView >::size_type i;
+
+  if (left.size () != right.size ())
+    {
+      return false;
+    }
+  for (i = 0; left.size () > i; ++i)
+    {
+      if (left[i].getLabels () != right[i].getLabels ())
+	{
+	  return false;
+	}
+    }
+  return true;
+}
+
+
+
+/**
+ * Counts its runs and throws when told to fail.
+ */
+class CountingTask : public ThreadPool::Task
+{
+public:
+
+  unsigned int runs;
+
+  bool fails;
+
+  CountingTask (bool f = false) : runs (0), fails (f) { }
+
+  virtual void run ()
+  {
+    ++runs;
+    if (fails)
+      {
+	IntLibException ex ("task failure", __FILE__, __LINE__);
+
+	throw ex;
+      }
+  }
+};
+
+
+
+/**
+ * Runs a batch of tasks where the task at index failing throws, if any, and
+ * reports the outcome.
+ */
+static void
+runBatch (const ThreadPool &pool, unsigned int count, unsigned int failing)
+{
+  vector< CountingTask > tasks (count);
+  vector< ThreadPool::Task* > batch;
+  unsigned int i;
+  unsigned int runs;
+  bool thrown;
+
+  for (i = 0; count > i; ++i)
+    {
+      tasks[i].fails = failing == i;
+      batch.push_back (&tasks[i]);
+    }
+  thrown = false;
+  try
+    {
+      pool.run (batch);
+    }
+  catch (FatalIntLibException &ex)
+    {
+      thrown = true;
+    }
+  for (i = 0, runs = 0; count > i; ++i)
+    {
+      runs += 1 == tasks[i].runs ? 1 : 0;
+    }
+  gOut (0) << count << " tasks on " << pool.getThreadCount ()
+	   << (1 < pool.getThreadCount () ? " threads" : " thread")
+	   << (failing < count ? ", one failing: " : ": ")
+	   << runs << " run once, "
+	   << (thrown ? "failure reported" : "no failure reported") << endl;
+}
+
+
+
+int
+main (int argc, char *argv[])
+{
+  ThreadPool serial;
+  ThreadPool pool (4);
+  GraphModel model;
+  vector< GraphModelView > serialBasis;
+  vector< GraphModelView > pooledBasis;
+  vector< GraphModelView > serialUnion;
+  vector< GraphModelView > pooledUnion;
+
+  try
+    {
+      izfPdbstream ifs;
+
+      ifs.open ("1L8V.pdb.gz");
+      if (! ifs)
+	{
+	  IntLibException ex ("failed to open \"1L8V.pdb.gz\"", __FILE__, __LINE__);
+	  throw ex;
+	}
+      ifs >> model;
+      ifs.close ();
+      model.annotate ();
+
+      // The cycle bases on the calling thread and on the pool.
+      model.minimumCycleBasis (serialBasis);
+      model.unionMinimumCycleBases (serialUnion);
+      model.setThreadPool (&pool);
+      model.minimumCycleBasis (pooledBasis);
+      model.unionMinimumCycleBases (pooledUnion);
+      model.setThreadPool (0);
+    }
+  catch (Exception& ex)
+    {
+      gErr (0) << argv[0] << ": " << ex << endl;
+      return EXIT_FAILURE;
+    }
+  gOut (0) << "minimum cycle basis: " << serialBasis.size () << " cycles, "
+	   << pooledBasis.size () << " on 4 threads, "
+	   << (same (serialBasis, pooledBasis) ? "same" : "different") << endl;
+  gOut (0) << "union of minimum cycle bases: " << serialUnion.size () << " cycles, "
+	   << pooledUnion.size () << " on 4 threads, "
+	   << (same (serialUnion, pooledUnion) ? "same" : "different") << endl;
+
+  // Every task runs once even when one of them throws, and the pool is
+  // usable afterwards.
+  runBatch (pool, 100, 100);
+  runBatch (pool, 100, 37);
+  runBatch (pool, 100, 0);
+  runBatch (pool, 100, 100);
+  runBatch (serial, 10, 5);
+
+  return EXIT_SUCCESS;
+}